@@ -12,6 +12,7 @@
 
 #include "Branch.h"
 #include "Core/Index/Index.h"
+#include "Engine/Loader/Loader.h"
 #include "Version.h"
 
 CContext* CContext::GetContext()
@@ -69,7 +70,12 @@ RenderContext_t* CContext::GetRendererCtx()
 
 CLogApi* CContext::GetLogger()
 {
-	static CLogApi s_Logger = CLogApi();
+	static CLogApi s_Logger = CLogApi(
+		4096,
+		8 * 1024 * 1024,
+		65536,
+		Loader::GetOwnerSignature
+	);
 	return &s_Logger;
 }
 
@@ -81,11 +87,20 @@ CUpdater* CContext::GetUpdater()
 	return &s_Updater;
 }
 
+CTaskPool* CContext::GetTaskPool()
+{
+	static CTaskPool s_TaskPool = CTaskPool(
+		this->GetLogger()
+	);
+	return &s_TaskPool;
+}
+
 CTextureLoader* CContext::GetTextureService()
 {
 	static CTextureLoader s_TextureApi = CTextureLoader(
 		this->GetLogger(),
 		this->GetRendererCtx(),
+		this->GetTaskPool(),
 		Index(EPath::DIR_TEXTURES)
 	);
 	return &s_TextureApi;
@@ -94,17 +109,36 @@ CTextureLoader* CContext::GetTextureService()
 CDataLinkApi* CContext::GetDataLink()
 {
 	static CDataLinkApi s_DataLinkApi = CDataLinkApi(
-		this->GetLogger()
+		this->GetLogger(),
+		Loader::GetOwnerSignature
 	);
 	return &s_DataLinkApi;
 }
 
+CFuncRegistry* CContext::GetFunctionRegistry()
+{
+	static CFuncRegistry s_FuncRegistry = CFuncRegistry(this->GetLogger());
+	return &s_FuncRegistry;
+}
+
 CEventApi* CContext::GetEventApi()
 {
-	static CEventApi s_EventApi = CEventApi();
+	static CEventApi s_EventApi = CEventApi(
+		EEventDeferMode::Frame,
+		Loader::GetOwnerSignature
+	);
 	return &s_EventApi;
 }
 
+CEventStream* CContext::GetEventStream()
+{
+	static CEventStream s_EventStream = CEventStream(
+		this->GetDataLink(),
+		this->GetLogger()
+	);
+	return &s_EventStream;
+}
+
 CRawInputApi* CContext::GetRawInputApi()
 {
 	static CRawInputApi s_RawInputApi = CRawInputApi(
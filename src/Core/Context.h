@@ -12,12 +12,15 @@
 #include "Core/Preferences/PrefContext.h"
 #include "Engine/DataLink/DlApi.h"
 #include "Engine/Events/EvtApi.h"
+#include "Engine/Events/EvtStream.h"
+#include "Engine/Functions/FnRegistry.h"
 #include "Engine/Inputs/InputBinds/IbApi.h"
 #include "Engine/Inputs/RawInput/RiApi.h"
 #include "Engine/Loader/AddonVersion.h"
 #include "Engine/Logging/LogApi.h"
 #include "Engine/Networking/WebRequests/WreClient.h"
 #include "Engine/Renderer/RdrContext.h"
+#include "Engine/Tasks/TskPool.h"
 #include "Engine/Textures/TxLoader.h"
 #include "Engine/Updater/Updater.h"
 #include "GW2/Inputs/GameBinds/GbApi.h"
@@ -48,12 +51,18 @@ class CContext
 
 	CUpdater* GetUpdater();
 
+	CTaskPool* GetTaskPool();
+
 	CTextureLoader* GetTextureService();
 
 	CDataLinkApi* GetDataLink();
 
+	CFuncRegistry* GetFunctionRegistry();
+
 	CEventApi* GetEventApi();
 
+	CEventStream* GetEventStream();
+
 	CRawInputApi* GetRawInputApi();
 
 	CInputBindApi* GetInputBindApi();
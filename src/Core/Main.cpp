@@ -16,9 +16,12 @@
 #include "Core/Context.h"
 #include "Core/Hooks/Hooks.h"
 #include "Core/Index/Index.h"
+#include "Core/Preferences/PrefConst.h"
 #include "Engine/Loader/Loader.h"
 #include "Engine/Logging/LogApi.h"
 #include "Engine/Logging/LogConsole.h"
+#include "Engine/Logging/LogJsonWriter.h"
+#include "Engine/Logging/LogTail.h"
 #include "Engine/Logging/LogWriter.h"
 #include "Engine/Updater/Updater.h"
 #include "Resources/ResConst.h"
@@ -58,6 +61,24 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
 namespace Main
 {
 	static std::thread s_UpdateThread;
+	static LPTOP_LEVEL_EXCEPTION_FILTER s_PrevExceptionFilter = nullptr;
+	static CLogTail* s_LogTail = nullptr;
+
+	///----------------------------------------------------------------------------------------------------
+	/// OnUnhandledException:
+	/// 	Stores the queued log messages before the process goes down, then chains to the previous filter.
+	///----------------------------------------------------------------------------------------------------
+	static LONG WINAPI OnUnhandledException(EXCEPTION_POINTERS* aExceptionInfo)
+	{
+		CContext::GetContext()->GetLogger()->Flush();
+
+		if (s_PrevExceptionFilter)
+		{
+			return s_PrevExceptionFilter(aExceptionInfo);
+		}
+
+		return EXCEPTION_CONTINUE_SEARCH;
+	}
 
 	void Initialize(EProxyFunction aEntryFunction)
 	{
@@ -108,10 +129,81 @@ namespace Main
 			logpath = Index(EPath::Log);
 		}
 
+		/* Mapped tail of the latest lines, recovered into Crash.log if the last session did not shut down. */
+		std::filesystem::path tailpath = logpath;
+		tailpath.replace_extension(".tail");
+
+		static CLogTail tail = CLogTail(ELogLevel::ALL, tailpath, Index(EPath::LastCrashLog));
+		s_LogTail = &tail;
+		logger->Register(&tail);
+
+		if (tail.HasRecovered())
+		{
+			logger->Warning(CH_CORE, "Previous session did not shut down cleanly. Last log lines recovered to %s.", Index(EPath::LastCrashLog).string().c_str());
+		}
+
+		CSettings* settingsctx = ctx->GetSettingsCtx();
+
+		/* JSON Lines next to the log file, structured messages keep their typed fields. */
+		if (settingsctx->Get<bool>(OPT_LOGJSON, false))
+		{
+			std::filesystem::path jsonpath = logpath;
+			jsonpath.replace_extension(".jsonl");
+
+			static CJsonLogger json = CJsonLogger(ELogLevel::ALL, jsonpath);
+			logger->Register(&json);
+		}
+
+		/* Rotate the log file, so long sessions don't grow a single unbounded file. */
+		LogRotation_t logrotation{};
+		logrotation.MaxFileSize  = settingsctx->Get<uint64_t>(OPT_LOGMAXFILESIZE, 32 * 1024 * 1024);
+		logrotation.MaxFileAge   = settingsctx->Get<uint32_t>(OPT_LOGMAXFILEAGE, 0);
+		logrotation.MaxFiles     = settingsctx->Get<uint32_t>(OPT_LOGMAXFILES, 4);
+		logrotation.MaxTotalSize = settingsctx->Get<uint64_t>(OPT_LOGMAXTOTALSIZE, 0);
+
 		/* Allocate log writer. */
-		static CFileLogger writer = CFileLogger(ELogLevel::ALL, logpath);
+		static CFileLogger writer = CFileLogger(ELogLevel::ALL, logpath, 1000, ELogFileFormat::Text, logrotation);
 		logger->Register(&writer);
 
+		/* Binary log next to the log file, arguments are captured unformatted. */
+		if (settingsctx->Get<bool>(OPT_LOGBINARY, false))
+		{
+			std::filesystem::path binarypath = logpath;
+			binarypath.replace_extension(".nlog");
+
+			logger->SetDeferredFormatting(true);
+
+			static CFileLogger binarywriter = CFileLogger(ELogLevel::ALL, binarypath, 1000, ELogFileFormat::Binary, logrotation);
+			logger->Register(&binarywriter);
+		}
+
+		/* Memory budget of the retained log messages. */
+		logger->SetRetention(
+			settingsctx->Get<size_t>(OPT_LOGRETENTIONBYTES, 8 * 1024 * 1024),
+			settingsctx->Get<size_t>(OPT_LOGRETENTIONCOUNT, 65536),
+			settingsctx->Get<ELogLevel>(OPT_LOGRETENTIONLEVEL, ELogLevel::ALL)
+		);
+
+		/* Token buckets, so a single channel or addon cannot flood the log. */
+		LogRateLimit_t channellimit{};
+		channellimit.Rate  = settingsctx->Get<uint32_t>(OPT_LOGCHANNELRATE, 200);
+		channellimit.Burst = settingsctx->Get<uint32_t>(OPT_LOGCHANNELBURST, 1000);
+
+		LogRateLimit_t addonlimit{};
+		addonlimit.Rate  = settingsctx->Get<uint32_t>(OPT_LOGADDONRATE, 100);
+		addonlimit.Burst = settingsctx->Get<uint32_t>(OPT_LOGADDONBURST, 500);
+
+		logger->SetRateLimits(channellimit, addonlimit);
+
+		/* Opt-in, external readers have to look up small public resources in the arena directory. */
+		if (settingsctx->Get<bool>(OPT_DATALINKARENA, false))
+		{
+			ctx->GetDataLink()->EnableArena(settingsctx->Get<size_t>(OPT_DATALINKARENASIZE, 1024 * 1024));
+		}
+
+		/* Logging is asynchronous, flush the queue if we crash. */
+		s_PrevExceptionFilter = SetUnhandledExceptionFilter(OnUnhandledException);
+
 		/* If running vanilla, do not initialize the hooks and leave the mutex unmodified. */
 		if (CmdLine::HasArgument("-ggvanilla"))
 		{
@@ -161,6 +253,12 @@ namespace Main
 		Loader::Shutdown();
 		uictx->Shutdown();
 		logger->Info(CH_CORE, "SHUTDOWN END");
+		logger->Flush();
+
+		if (s_LogTail)
+		{
+			s_LogTail->MarkClean();
+		}
 
 		/* Let the OS take care of freeing the handles. Ugly, but otherwise crashes due to the addon clownfiesta in GW2. */
 		//if (D3D11Handle) { FreeLibrary(D3D11Handle); }
@@ -32,5 +32,21 @@ constexpr const char* OPT_CAMCTRL_LOCKCURSOR       = "CameraControl_LockCursor";
 constexpr const char* OPT_CAMCTRL_RESETCURSOR      = "CameraControl_ResetCursor";
 constexpr const char* OPT_UI_CLICK_MODSONLY        = "UI_ClickingRequiresModifiers";
 constexpr const char* OPT_UI_MODS                  = "UI_Modifiers";
+constexpr const char* OPT_EVENTSTREAM              = "EventStream";
+constexpr const char* OPT_LOGRETENTIONBYTES        = "LogRetentionBytes";
+constexpr const char* OPT_LOGRETENTIONCOUNT        = "LogRetentionCount";
+constexpr const char* OPT_LOGRETENTIONLEVEL        = "LogRetentionLevel";
+constexpr const char* OPT_LOGBINARY                = "LogBinary";
+constexpr const char* OPT_LOGJSON                  = "LogJson";
+constexpr const char* OPT_LOGMAXFILESIZE           = "LogMaxFileSize";
+constexpr const char* OPT_LOGMAXFILEAGE            = "LogMaxFileAge";
+constexpr const char* OPT_LOGMAXFILES              = "LogMaxFiles";
+constexpr const char* OPT_LOGMAXTOTALSIZE          = "LogMaxTotalSize";
+constexpr const char* OPT_LOGCHANNELRATE           = "LogChannelRate";
+constexpr const char* OPT_LOGCHANNELBURST          = "LogChannelBurst";
+constexpr const char* OPT_LOGADDONRATE             = "LogAddonRate";
+constexpr const char* OPT_LOGADDONBURST            = "LogAddonBurst";
+constexpr const char* OPT_DATALINKARENA            = "DataLinkArena";
+constexpr const char* OPT_DATALINKARENASIZE        = "DataLinkArenaSize";
 
 #endif
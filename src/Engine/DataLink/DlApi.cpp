@@ -8,13 +8,20 @@
 
 #include "DlApi.h"
 
+#include <algorithm>
 #include <assert.h>
+#include <cstring>
+#include <new>
+#include <thread>
 
-CDataLinkApi::CDataLinkApi(CLogApi* aLogger)
+#include "Util/Platform.h"
+
+CDataLinkApi::CDataLinkApi(CLogApi* aLogger, DATALINK_RESOLVEOWNER aResolveOwner)
 {
 	assert(aLogger);
 
 	this->Logger = aLogger;
+	this->ResolveOwner = aResolveOwner;
 }
 
 CDataLinkApi::~CDataLinkApi()
@@ -25,54 +32,277 @@ CDataLinkApi::~CDataLinkApi()
 	{
 		const auto& it = this->Registry.begin();
 
-		switch (it->second.Type)
-		{
-			case ELinkedResourceType::Public:
-				if (it->second.Pointer)
-				{
-					UnmapViewOfFile((LPVOID)it->second.Pointer);
-					it->second.Pointer = nullptr;
-				}
-
-				if (it->second.Handle)
-				{
-					CloseHandle(it->second.Handle);
-					it->second.Handle = nullptr;
-				}
-				break;
-
-			case ELinkedResourceType::Internal:
-				if (it->second.Pointer)
-				{
-					delete it->second.Pointer;
-					it->second.Pointer = nullptr;
-				}
-				break;
-		}
+		this->Free(it->second);
 
 		this->Logger->Info(CH_DATALINK, "Freed shared resource: \"%s\"", it->first.c_str());
 
 		this->Registry.erase(it);
 	}
+
+	for (std::atomic<LinkedResourceSlot_t*>& page : this->Pages)
+	{
+		delete[] page.exchange(nullptr);
+	}
 }
 
-void* CDataLinkApi::GetResource(const char* aIdentifier)
+void* CDataLinkApi::GetResource(const char* aIdentifier, void* aCaller)
 {
 	if (aIdentifier == nullptr) { return nullptr; }
 
+	signed int signature = this->GetSignature(aCaller);
+
 	const std::lock_guard<std::mutex> lock(this->Mutex);
 
 	auto it = this->Registry.find(aIdentifier);
 
 	if (it != this->Registry.end())
 	{
+		CDataLinkApi::AddUser(it->second, signature);
 		return it->second.Pointer;
 	}
 
 	return nullptr;
 }
 
-void* CDataLinkApi::ShareResource(const char* aIdentifier, size_t aResourceSize, const char* aUnderlyingName, bool aIsPublic)
+DataLinkHandle CDataLinkApi::GetHandle(const char* aIdentifier, void* aCaller)
+{
+	if (aIdentifier == nullptr) { return 0; }
+
+	signed int signature = this->GetSignature(aCaller);
+
+	const std::lock_guard<std::mutex> lock(this->Mutex);
+
+	auto it = this->Registry.find(aIdentifier);
+
+	if (it == this->Registry.end() || it->second.Slot == UINT32_MAX)
+	{
+		return 0;
+	}
+
+	CDataLinkApi::AddUser(it->second, signature);
+
+	const LinkedResourceSlot_t& slot = this->Pages[it->second.Slot / DL_SLOTS_PER_PAGE].load(std::memory_order_relaxed)[it->second.Slot % DL_SLOTS_PER_PAGE];
+
+	return ((DataLinkHandle)slot.Generation.load(std::memory_order_relaxed) << 32) | (it->second.Slot + 1);
+}
+
+void* CDataLinkApi::ShareResource(const char* aIdentifier, size_t aResourceSize, const char* aUnderlyingName, bool aIsPublic, void* aCaller)
+{
+	return this->Share(aIdentifier, aResourceSize, aUnderlyingName, aIsPublic, ELinkedResourceLayout::Plain, this->GetSignature(aCaller));
+}
+
+void* CDataLinkApi::ShareVersionedResource(const char* aIdentifier, size_t aResourceSize, const char* aUnderlyingName, bool aIsPublic, void* aCaller)
+{
+	if (aResourceSize == 0) { return nullptr; }
+
+	return this->Share(aIdentifier, sizeof(VersionedHeader_t) + aResourceSize, aUnderlyingName, aIsPublic, ELinkedResourceLayout::Versioned, this->GetSignature(aCaller));
+}
+
+void* CDataLinkApi::ShareTripleBuffer(const char* aIdentifier, size_t aResourceSize, const char* aUnderlyingName, bool aIsPublic, void* aCaller)
+{
+	if (aResourceSize == 0) { return nullptr; }
+
+	return this->Share(aIdentifier, sizeof(TripleBufferHeader_t) + DL_TRIPLEBUFFER_BUFFERS * aResourceSize, aUnderlyingName, aIsPublic, ELinkedResourceLayout::TripleBuffered, this->GetSignature(aCaller));
+}
+
+void CDataLinkApi::ReleaseResource(const char* aIdentifier, void* aCaller)
+{
+	if (aIdentifier == nullptr) { return; }
+
+	signed int signature = this->GetSignature(aCaller);
+
+	/* Nexus references are shared by all of Nexus, they are never dropped. */
+	if (signature == 0) { return; }
+
+	const std::lock_guard<std::mutex> lock(this->Mutex);
+
+	auto it = this->Registry.find(aIdentifier);
+
+	if (it == this->Registry.end()) { return; }
+
+	std::vector<signed int>& users = it->second.Users;
+	users.erase(std::remove(users.begin(), users.end(), signature), users.end());
+
+	if (users.empty())
+	{
+		this->Free(it->second);
+
+		this->Logger->Info(CH_DATALINK, "Freed shared resource: \"%s\"", it->first.c_str());
+
+		this->Registry.erase(it);
+	}
+}
+
+void* CDataLinkApi::BeginWrite(void* aResource)
+{
+	VersionedHeader_t* header = static_cast<VersionedHeader_t*>(aResource);
+
+	if (!header || header->Magic != DL_VERSIONED_MAGIC) { return nullptr; }
+
+	/* Odd while written. Taking the sequence from even to odd also keeps a second writer out. */
+	uint32_t seq = header->Sequence.load(std::memory_order_relaxed);
+
+	for (;;)
+	{
+		if (!(seq & 1) && header->Sequence.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed))
+		{
+			break;
+		}
+
+		if (seq & 1)
+		{
+			std::this_thread::yield();
+			seq = header->Sequence.load(std::memory_order_relaxed);
+		}
+	}
+
+	/* A reader that sees any of the following writes also sees the odd sequence. */
+	std::atomic_thread_fence(std::memory_order_release);
+
+	return header + 1;
+}
+
+void CDataLinkApi::EndWrite(void* aResource)
+{
+	VersionedHeader_t* header = static_cast<VersionedHeader_t*>(aResource);
+
+	if (!header || header->Magic != DL_VERSIONED_MAGIC) { return; }
+
+	header->Sequence.fetch_add(1, std::memory_order_release);
+}
+
+bool CDataLinkApi::Write(void* aResource, const void* aData, size_t aSize)
+{
+	VersionedHeader_t* header = static_cast<VersionedHeader_t*>(aResource);
+
+	if (!header || !aData || header->Magic != DL_VERSIONED_MAGIC || header->Size < aSize) { return false; }
+
+	memcpy(CDataLinkApi::BeginWrite(aResource), aData, aSize);
+	CDataLinkApi::EndWrite(aResource);
+
+	return true;
+}
+
+bool CDataLinkApi::ReadSnapshot(const void* aResource, void* aBuffer, size_t aSize)
+{
+	const VersionedHeader_t* header = static_cast<const VersionedHeader_t*>(aResource);
+
+	if (!header || !aBuffer || header->Magic != DL_VERSIONED_MAGIC || header->Size < aSize) { return false; }
+
+	const char* data = reinterpret_cast<const char*>(header + 1);
+
+	for (uint32_t attempt = 0;; attempt++)
+	{
+		uint32_t begin = header->Sequence.load(std::memory_order_acquire);
+
+		if (!(begin & 1))
+		{
+			/* The copy may be torn, it is only kept if the sequence did not move meanwhile. */
+			memcpy(aBuffer, data, aSize);
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			if (header->Sequence.load(std::memory_order_relaxed) == begin)
+			{
+				return true;
+			}
+		}
+
+		/* Writes are short, only back off if they keep overlapping. */
+		if (attempt >= DL_SNAPSHOT_SPINS)
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void* CDataLinkApi::BeginPublish(void* aResource)
+{
+	TripleBufferHeader_t* header = static_cast<TripleBufferHeader_t*>(aResource);
+
+	if (!header || header->Magic != DL_TRIPLEBUFFER_MAGIC) { return nullptr; }
+
+	uint32_t expected = 0;
+
+	if (!header->IsPublishing.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed))
+	{
+		return nullptr;
+	}
+
+	/* Neither the newest buffer, nor the one before it, so readers of the last two frames are left alone. */
+	uint32_t index = ((header->Latest.load(std::memory_order_relaxed) & 3) + 1) % DL_TRIPLEBUFFER_BUFFERS;
+
+	header->Sequence[index].fetch_add(1, std::memory_order_relaxed);
+
+	/* A reader that sees any of the following writes also sees the odd sequence. */
+	std::atomic_thread_fence(std::memory_order_release);
+
+	return reinterpret_cast<char*>(header + 1) + index * header->Size;
+}
+
+void CDataLinkApi::EndPublish(void* aResource)
+{
+	TripleBufferHeader_t* header = static_cast<TripleBufferHeader_t*>(aResource);
+
+	if (!header || header->Magic != DL_TRIPLEBUFFER_MAGIC) { return; }
+
+	/* Only the producer changes Latest, while it holds IsPublishing. */
+	uint32_t latest = header->Latest.load(std::memory_order_relaxed);
+	uint32_t index = ((latest & 3) + 1) % DL_TRIPLEBUFFER_BUFFERS;
+
+	header->Sequence[index].fetch_add(1, std::memory_order_release);
+	header->Latest.store(((latest >> 2) + 1) << 2 | index, std::memory_order_release);
+	header->IsPublishing.store(0, std::memory_order_release);
+}
+
+bool CDataLinkApi::Publish(void* aResource, const void* aData, size_t aSize)
+{
+	TripleBufferHeader_t* header = static_cast<TripleBufferHeader_t*>(aResource);
+
+	if (!header || !aData || header->Magic != DL_TRIPLEBUFFER_MAGIC || header->Size < aSize) { return false; }
+
+	void* buffer = CDataLinkApi::BeginPublish(aResource);
+
+	if (!buffer) { return false; }
+
+	memcpy(buffer, aData, aSize);
+	CDataLinkApi::EndPublish(aResource);
+
+	return true;
+}
+
+bool CDataLinkApi::ReadLatest(const void* aResource, void* aBuffer, size_t aSize)
+{
+	const TripleBufferHeader_t* header = static_cast<const TripleBufferHeader_t*>(aResource);
+
+	if (!header || !aBuffer || header->Magic != DL_TRIPLEBUFFER_MAGIC || header->Size < aSize) { return false; }
+
+	const char* buffers = reinterpret_cast<const char*>(header + 1);
+
+	for (uint32_t attempt = 0;; attempt++)
+	{
+		uint32_t index = header->Latest.load(std::memory_order_acquire) & 3;
+		uint32_t begin = header->Sequence[index].load(std::memory_order_acquire);
+
+		if (!(begin & 1))
+		{
+			/* Only torn, if the producer came around to this buffer again, then the copy is discarded. */
+			memcpy(aBuffer, buffers + index * header->Size, aSize);
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			if (header->Sequence[index].load(std::memory_order_relaxed) == begin)
+			{
+				return true;
+			}
+		}
+
+		if (attempt >= DL_SNAPSHOT_SPINS)
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void* CDataLinkApi::Share(const char* aIdentifier, size_t aResourceSize, const char* aUnderlyingName, bool aIsPublic, ELinkedResourceLayout aLayout, signed int aSignature)
 {
 	if (aIdentifier == nullptr) { return nullptr; }
 	if (aResourceSize == 0)     { return nullptr; }
@@ -81,11 +311,25 @@ void* CDataLinkApi::ShareResource(const char* aIdentifier, size_t aResourceSize,
 
 	auto it = this->Registry.find(aIdentifier);
 
+	/* Nobody references it anymore, recreate it with the requested layout instead of failing. */
+	if (it != this->Registry.end() && it->second.Users.empty() && (it->second.Layout != aLayout || it->second.Size != aResourceSize))
+	{
+		this->Free(it->second);
+		this->Registry.erase(it);
+		it = this->Registry.end();
+	}
+
 	/* resource already exists */
 	if (it != this->Registry.end())
 	{
-		if (it->second.Size == aResourceSize)
+		if (it->second.Layout != aLayout)
+		{
+			this->Logger->Warning(CH_DATALINK, "Resource with name \"%s\" already exists, but with a different layout.", aIdentifier);
+			return nullptr;
+		}
+		else if (it->second.Size == aResourceSize)
 		{
+			CDataLinkApi::AddUser(it->second, aSignature);
 			return it->second.Pointer;
 		}
 		else /* size mismatch */
@@ -99,6 +343,9 @@ void* CDataLinkApi::ShareResource(const char* aIdentifier, size_t aResourceSize,
 	LinkedResource_t resource{};
 	resource.Size = aResourceSize;
 	resource.Type = aIsPublic ? ELinkedResourceType::Public : ELinkedResourceType::Internal;
+	resource.Layout = aLayout;
+	resource.Owner = aSignature;
+	resource.Users.push_back(aSignature);
 
 	switch (resource.Type)
 	{
@@ -109,6 +356,21 @@ void* CDataLinkApi::ShareResource(const char* aIdentifier, size_t aResourceSize,
 		}
 		case ELinkedResourceType::Public:
 		{
+			/* Small resources without a name override go into the arena, if enabled. */
+			if (this->Arena && aResourceSize <= DL_ARENA_MAX_RESOURCE_SIZE && (!aUnderlyingName || !aUnderlyingName[0]))
+			{
+				resource.Pointer = this->Arena->Allocate(aIdentifier, aResourceSize);
+
+				if (resource.Pointer)
+				{
+					resource.Type = ELinkedResourceType::Arena;
+					resource.UnderlyingName = this->Arena->GetName();
+
+					this->Logger->Info(CH_DATALINK, "Created public shared resource: \"%s\" (Arena: \"%s\")", aIdentifier, resource.UnderlyingName.c_str());
+					break;
+				}
+			}
+
 			resource.UnderlyingName = aUnderlyingName;
 
 			/* If no name override is set, use identifier + process ID. */
@@ -116,46 +378,19 @@ void* CDataLinkApi::ShareResource(const char* aIdentifier, size_t aResourceSize,
 			{
 				resource.UnderlyingName = aIdentifier;
 				resource.UnderlyingName.append("_");
-				resource.UnderlyingName.append(std::to_string(GetCurrentProcessId()));
+				resource.UnderlyingName.append(std::to_string(Platform::GetProcessId()));
 			}
 
-			/* acquire handle */
-			resource.Handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, resource.UnderlyingName.c_str());
-
-			if (!resource.Handle)
-			{
-				resource.Handle = CreateFileMappingA(
-					INVALID_HANDLE_VALUE,
-					0,
-					PAGE_READWRITE,
-					0,
-					static_cast<DWORD>(aResourceSize),
-					resource.UnderlyingName.c_str()
-				);
-			}
-
-			/* still no resource handle */
-			if (!resource.Handle)
-			{
-				this->Logger->Warning(
-					CH_DATALINK,
-					"Failed to create resource \"%s\". OpenFileMapping failed. CreateFileMapping failed. GetLastError: %d",
-					aIdentifier,
-					GetLastError()
-				);
-				return nullptr;
-			}
-
-			resource.Pointer = MapViewOfFile(resource.Handle, FILE_MAP_ALL_ACCESS, 0, 0, static_cast<DWORD>(aResourceSize));
+			resource.Pointer = Platform::OpenSharedMemory(resource.UnderlyingName.c_str(), aResourceSize, resource.Handle);
 
 			/* sanity check */
 			if (!resource.Pointer)
 			{
 				this->Logger->Warning(
 					CH_DATALINK,
-					"Failed to create resource \"%s\". MapViewOfFile failed. GetLastError: %d",
+					"Failed to create resource \"%s\". Could not open or map shared memory. Error: %d",
 					aIdentifier,
-					GetLastError()
+					Platform::GetLastError()
 				);
 				return nullptr;
 			}
@@ -169,17 +404,239 @@ void* CDataLinkApi::ShareResource(const char* aIdentifier, size_t aResourceSize,
 		{
 			resource.Pointer = new char[resource.Size];
 
+			/* Versioned and triple buffered resources start out as an empty, consistent snapshot. */
+			if (resource.Layout != ELinkedResourceLayout::Plain)
+			{
+				memset(resource.Pointer, 0, resource.Size);
+			}
+
 			this->Logger->Info(CH_DATALINK, "Created internal shared resource: \"%s\"", aIdentifier);
 			break;
 		}
 	}
 
+	switch (resource.Layout)
+	{
+		case ELinkedResourceLayout::Plain:
+			break;
+
+		case ELinkedResourceLayout::Versioned:
+		{
+			VersionedHeader_t* header = new (resource.Pointer) VersionedHeader_t{};
+			header->Magic = DL_VERSIONED_MAGIC;
+			header->Size  = resource.Size - sizeof(VersionedHeader_t);
+			break;
+		}
+		case ELinkedResourceLayout::TripleBuffered:
+		{
+			TripleBufferHeader_t* header = new (resource.Pointer) TripleBufferHeader_t{};
+			header->Magic = DL_TRIPLEBUFFER_MAGIC;
+			header->Size  = (resource.Size - sizeof(TripleBufferHeader_t)) / DL_TRIPLEBUFFER_BUFFERS;
+			break;
+		}
+	}
+
+	resource.Slot = this->AcquireSlot(resource.Pointer, resource.Size);
+
+	if (resource.Slot == UINT32_MAX)
+	{
+		this->Logger->Warning(CH_DATALINK, "Resource \"%s\" has no handle. All %u slots are in use.", aIdentifier, DL_SLOTS_PER_PAGE * DL_MAX_PAGES);
+	}
+
 	/* store linkedresource */
 	this->Registry.emplace(aIdentifier, resource);
 
 	return resource.Pointer;
 }
 
+void CDataLinkApi::AddUser(LinkedResource_t& aResource, signed int aSignature)
+{
+	if (std::find(aResource.Users.begin(), aResource.Users.end(), aSignature) == aResource.Users.end())
+	{
+		aResource.Users.push_back(aSignature);
+	}
+}
+
+signed int CDataLinkApi::GetSignature(void* aCaller) const
+{
+	if (aCaller == nullptr || this->ResolveOwner == nullptr) { return 0; }
+
+	return this->ResolveOwner(aCaller);
+}
+
+uint32_t CDataLinkApi::AcquireSlot(void* aPointer, size_t aSize)
+{
+	uint32_t index = UINT32_MAX;
+
+	if (!this->FreeSlots.empty())
+	{
+		index = this->FreeSlots.back();
+		this->FreeSlots.pop_back();
+	}
+	else if (this->SlotCount < DL_SLOTS_PER_PAGE * DL_MAX_PAGES)
+	{
+		index = this->SlotCount++;
+
+		std::atomic<LinkedResourceSlot_t*>& page = this->Pages[index / DL_SLOTS_PER_PAGE];
+
+		if (!page.load(std::memory_order_relaxed))
+		{
+			page.store(new LinkedResourceSlot_t[DL_SLOTS_PER_PAGE], std::memory_order_release);
+		}
+	}
+	else
+	{
+		return UINT32_MAX;
+	}
+
+	LinkedResourceSlot_t& slot = this->Pages[index / DL_SLOTS_PER_PAGE].load(std::memory_order_relaxed)[index % DL_SLOTS_PER_PAGE];
+	slot.Size.store(aSize, std::memory_order_relaxed);
+	slot.Pointer.store(aPointer, std::memory_order_release);
+
+	return index;
+}
+
+void CDataLinkApi::Free(LinkedResource_t& aResource)
+{
+	if (aResource.Slot != UINT32_MAX)
+	{
+		LinkedResourceSlot_t& slot = this->Pages[aResource.Slot / DL_SLOTS_PER_PAGE].load(std::memory_order_relaxed)[aResource.Slot % DL_SLOTS_PER_PAGE];
+
+		/* Outstanding handles fail the generation check from here on. */
+		slot.Pointer.store(nullptr, std::memory_order_relaxed);
+		slot.Size.store(0, std::memory_order_relaxed);
+		slot.Generation.fetch_add(1, std::memory_order_release);
+
+		this->FreeSlots.push_back(aResource.Slot);
+		aResource.Slot = UINT32_MAX;
+	}
+
+	switch (aResource.Type)
+	{
+		case ELinkedResourceType::Public:
+			Platform::CloseSharedMemory(aResource.Pointer, aResource.Size, aResource.Handle);
+			aResource.Pointer = nullptr;
+			aResource.Handle = nullptr;
+			break;
+
+		case ELinkedResourceType::Arena:
+			if (this->Arena)
+			{
+				this->Arena->Free(aResource.Pointer);
+			}
+			aResource.Pointer = nullptr;
+			break;
+
+		case ELinkedResourceType::Internal:
+			if (aResource.Pointer)
+			{
+				delete[] static_cast<char*>(aResource.Pointer);
+				aResource.Pointer = nullptr;
+			}
+			break;
+
+		case ELinkedResourceType::None:
+			break;
+	}
+}
+
+void CDataLinkApi::EnableArena(size_t aSize)
+{
+	const std::lock_guard<std::mutex> lock(this->Mutex);
+
+	if (this->Arena) { return; }
+
+	std::string name = DL_ARENA;
+	name.append("_");
+	name.append(std::to_string(Platform::GetProcessId()));
+
+	this->Arena = std::make_unique<CDataLinkArena>(name.c_str(), aSize);
+
+	if (!this->Arena->IsValid())
+	{
+		this->Logger->Warning(CH_DATALINK, "Failed to create arena \"%s\". Error: %d", name.c_str(), Platform::GetLastError());
+		this->Arena.reset();
+		return;
+	}
+
+	this->Logger->Info(CH_DATALINK, "Created arena \"%s\" with %zu bytes.", name.c_str(), this->Arena->GetSize());
+}
+
+bool CDataLinkApi::GetArenaUsage(size_t& aUsed, size_t& aSize)
+{
+	const std::lock_guard<std::mutex> lock(this->Mutex);
+
+	if (!this->Arena) { return false; }
+
+	aUsed = this->Arena->GetUsed();
+	aSize = this->Arena->GetSize();
+
+	return true;
+}
+
+int CDataLinkApi::Verify(void* aStartAddress, void* /*aEndAddress*/)
+{
+	/* Any address of the module resolves to the same addon. Called before the module is freed, so it still resolves. */
+	signed int signature = this->GetSignature(aStartAddress);
+
+	if (signature == 0) { return 0; }
+
+	int refCounter = 0;
+
+	const std::lock_guard<std::mutex> lock(this->Mutex);
+
+	for (auto& [identifier, resource] : this->Registry)
+	{
+		auto it = std::find(resource.Users.begin(), resource.Users.end(), signature);
+
+		if (it == resource.Users.end()) { continue; }
+
+		resource.Users.erase(it);
+		refCounter++;
+	}
+
+	return refCounter;
+}
+
+size_t CDataLinkApi::Reclaim()
+{
+	size_t bytes = 0;
+
+	const std::lock_guard<std::mutex> lock(this->Mutex);
+
+	for (auto it = this->Registry.begin(); it != this->Registry.end();)
+	{
+		if (!it->second.Users.empty())
+		{
+			it++;
+			continue;
+		}
+
+		bytes += it->second.Size;
+
+		this->Free(it->second);
+
+		this->Logger->Info(CH_DATALINK, "Reclaimed shared resource: \"%s\"", it->first.c_str());
+
+		it = this->Registry.erase(it);
+	}
+
+	return bytes;
+}
+
+void CDataLinkApi::GetUsage(size_t& aLiveBytes, size_t& aReclaimableBytes)
+{
+	aLiveBytes = 0;
+	aReclaimableBytes = 0;
+
+	const std::lock_guard<std::mutex> lock(this->Mutex);
+
+	for (auto& [identifier, resource] : this->Registry)
+	{
+		(resource.Users.empty() ? aReclaimableBytes : aLiveBytes) += resource.Size;
+	}
+}
+
 std::unordered_map<std::string, LinkedResource_t> CDataLinkApi::GetRegistry()
 {
 	const std::lock_guard<std::mutex> lock(this->Mutex);
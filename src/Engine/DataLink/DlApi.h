@@ -9,14 +9,28 @@
 #ifndef DLAPI_H
 #define DLAPI_H
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
+#include "DlArena.h"
+#include "DlFuncDefs.h"
 #include "DlLinkedResource.h"
+#include "DlSlot.h"
+#include "DlTripleBufferHeader.h"
+#include "DlVersionedHeader.h"
 #include "Engine/Logging/LogApi.h"
 
-constexpr const char* CH_DATALINK = "DataLink";
+constexpr const char* CH_DATALINK                = "DataLink";
+constexpr uint32_t    DL_SNAPSHOT_SPINS          = 64;        /* Snapshot attempts before yielding to the writer. */
+constexpr size_t      DL_ARENA_MAX_RESOURCE_SIZE = 16 * 1024; /* Larger public resources keep their own mapping. */
+
+/* Returns the signature of the addon owning the address or 0. Called on every lookup from any thread, must not block. */
+typedef signed int (*DATALINK_RESOLVEOWNER)(void* aAddress);
 
 ///----------------------------------------------------------------------------------------------------
 /// CDataLinkApi Class
@@ -26,8 +40,10 @@ class CDataLinkApi
 	public:
 	///----------------------------------------------------------------------------------------------------
 	/// ctor
+	/// 	aResolveOwner attributes resources to addons by caller address, without it all resources are pinned.
+	/// 	It is called outside of the DataLink lock, see Loader::GetOwnerSignature.
 	///----------------------------------------------------------------------------------------------------
-	CDataLinkApi(CLogApi* aLogger);
+	CDataLinkApi(CLogApi* aLogger, DATALINK_RESOLVEOWNER aResolveOwner = nullptr);
 	///----------------------------------------------------------------------------------------------------
 	/// dtor
 	///----------------------------------------------------------------------------------------------------
@@ -35,9 +51,48 @@ class CDataLinkApi
 
 	///----------------------------------------------------------------------------------------------------
 	/// GetResource:
-	/// 	Retrieves the resource with the given identifier.
+	/// 	Retrieves the resource with the given identifier. The caller's addon holds a reference from then on.
+	///----------------------------------------------------------------------------------------------------
+	void* GetResource(const char* aIdentifier, void* aCaller = nullptr);
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetHandle:
+	/// 	Returns a handle to the resource with the given identifier or 0, if it does not exist.
+	/// 	The handle stays valid until the resource is reclaimed. The caller's addon holds a reference from then on.
 	///----------------------------------------------------------------------------------------------------
-	void* GetResource(const char* aIdentifier);
+	DataLinkHandle GetHandle(const char* aIdentifier, void* aCaller = nullptr);
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetResource:
+	/// 	Retrieves the resource of the given handle, without a lock or a lookup.
+	/// 	Returns nullptr, if the handle is invalid or the resource was released.
+	///----------------------------------------------------------------------------------------------------
+	inline void* GetResource(DataLinkHandle aHandle) const
+	{
+		const LinkedResourceSlot_t* slot = this->GetSlot(aHandle);
+
+		if (!slot) { return nullptr; }
+
+		void* ptr = slot->Pointer.load(std::memory_order_acquire);
+
+		/* Checked after the load, a reused slot only gets its new pointer after the generation moved on. */
+		return slot->Generation.load(std::memory_order_acquire) == (uint32_t)(aHandle >> 32) ? ptr : nullptr;
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetResourceSize:
+	/// 	Returns the size of the resource of the given handle or 0, if it is invalid.
+	///----------------------------------------------------------------------------------------------------
+	inline size_t GetResourceSize(DataLinkHandle aHandle) const
+	{
+		const LinkedResourceSlot_t* slot = this->GetSlot(aHandle);
+
+		if (!slot) { return 0; }
+
+		size_t size = slot->Size.load(std::memory_order_acquire);
+
+		return slot->Generation.load(std::memory_order_acquire) == (uint32_t)(aHandle >> 32) ? size : 0;
+	}
 
 	///----------------------------------------------------------------------------------------------------
 	/// ShareResource:
@@ -48,9 +103,129 @@ class CDataLinkApi
 		const char* aIdentifier,
 		size_t      aResourceSize,
 		const char* aUnderlyingName = "",
-		bool        aIsPublic       = false
+		bool        aIsPublic       = false,
+		void*       aCaller         = nullptr
+	);
+
+	///----------------------------------------------------------------------------------------------------
+	/// ShareVersionedResource:
+	/// 	Same as ShareResource, but the resource starts with a VersionedHeader_t followed by aResourceSize bytes.
+	/// 	Writers wrap their writes in BeginWrite/EndWrite, readers copy the data with ReadSnapshot.
+	/// 	Returns the header.
+	///----------------------------------------------------------------------------------------------------
+	void* ShareVersionedResource(
+		const char* aIdentifier,
+		size_t      aResourceSize,
+		const char* aUnderlyingName = "",
+		bool        aIsPublic       = false,
+		void*       aCaller         = nullptr
 	);
 
+	///----------------------------------------------------------------------------------------------------
+	/// ShareTripleBuffer:
+	/// 	Same as ShareResource, but the resource starts with a TripleBufferHeader_t followed by three buffers of aResourceSize bytes.
+	/// 	The producer fills a free buffer between BeginPublish/EndPublish, readers copy the newest complete one with ReadLatest.
+	/// 	Returns the header.
+	///----------------------------------------------------------------------------------------------------
+	void* ShareTripleBuffer(
+		const char* aIdentifier,
+		size_t      aResourceSize,
+		const char* aUnderlyingName = "",
+		bool        aIsPublic       = false,
+		void*       aCaller         = nullptr
+	);
+
+	///----------------------------------------------------------------------------------------------------
+	/// ReleaseResource:
+	/// 	Drops the reference of the caller's addon. The resource is freed once no addon references it.
+	///----------------------------------------------------------------------------------------------------
+	void ReleaseResource(const char* aIdentifier, void* aCaller = nullptr);
+
+	///----------------------------------------------------------------------------------------------------
+	/// BeginWrite:
+	/// 	Marks a versioned resource as being written and returns its data.
+	/// 	Concurrent writers wait for each other. Returns nullptr, if the resource is not versioned.
+	///----------------------------------------------------------------------------------------------------
+	static void* BeginWrite(void* aResource);
+
+	///----------------------------------------------------------------------------------------------------
+	/// EndWrite:
+	/// 	Publishes the writes since BeginWrite.
+	///----------------------------------------------------------------------------------------------------
+	static void EndWrite(void* aResource);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Write:
+	/// 	Copies aSize bytes into the data of a versioned resource. Returns false, if it does not fit.
+	///----------------------------------------------------------------------------------------------------
+	static bool Write(void* aResource, const void* aData, size_t aSize);
+
+	///----------------------------------------------------------------------------------------------------
+	/// ReadSnapshot:
+	/// 	Copies the first aSize bytes of the data of a versioned resource, retrying until no write overlapped the copy.
+	/// 	Takes no lock. Returns false, if the resource is not versioned or smaller than aSize.
+	///----------------------------------------------------------------------------------------------------
+	static bool ReadSnapshot(const void* aResource, void* aBuffer, size_t aSize);
+
+	///----------------------------------------------------------------------------------------------------
+	/// BeginPublish:
+	/// 	Returns the buffer of a triple buffered resource the producer may fill, the one published two frames ago.
+	/// 	Never waits. Returns nullptr, if the resource is not triple buffered or another producer is publishing.
+	///----------------------------------------------------------------------------------------------------
+	static void* BeginPublish(void* aResource);
+
+	///----------------------------------------------------------------------------------------------------
+	/// EndPublish:
+	/// 	Makes the buffer returned by BeginPublish the newest complete one.
+	///----------------------------------------------------------------------------------------------------
+	static void EndPublish(void* aResource);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Publish:
+	/// 	Copies aSize bytes into a free buffer and publishes it. Returns false, if it does not fit or another producer is publishing.
+	///----------------------------------------------------------------------------------------------------
+	static bool Publish(void* aResource, const void* aData, size_t aSize);
+
+	///----------------------------------------------------------------------------------------------------
+	/// ReadLatest:
+	/// 	Copies the first aSize bytes of the newest complete buffer. Takes no lock and only retries,
+	/// 	if the producer published twice during the copy. Returns false, if the resource is not triple buffered or smaller than aSize.
+	///----------------------------------------------------------------------------------------------------
+	static bool ReadLatest(const void* aResource, void* aBuffer, size_t aSize);
+
+	///----------------------------------------------------------------------------------------------------
+	/// EnableArena:
+	/// 	Creates the shared arena. Public resources shared afterwards, that are small enough
+	/// 	and have no underlying name override, are placed in it instead of a mapping of their own.
+	///----------------------------------------------------------------------------------------------------
+	void EnableArena(size_t aSize);
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetArenaUsage:
+	/// 	Returns false, if the arena is not enabled. Otherwise receives the used and total bytes.
+	///----------------------------------------------------------------------------------------------------
+	bool GetArenaUsage(size_t& aUsed, size_t& aSize);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Verify:
+	/// 	Drops the references of the addon within the provided address space.
+	/// 	References are tracked by addon signature, so only aStartAddress is used to resolve the owner.
+	/// 	Resources left without references are freed on the next Reclaim. Returns the dropped references.
+	///----------------------------------------------------------------------------------------------------
+	int Verify(void* aStartAddress, void* aEndAddress);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Reclaim:
+	/// 	Frees all resources without references. Returns the freed bytes.
+	///----------------------------------------------------------------------------------------------------
+	size_t Reclaim();
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetUsage:
+	/// 	Receives the bytes of referenced resources and of resources waiting for Reclaim.
+	///----------------------------------------------------------------------------------------------------
+	void GetUsage(size_t& aLiveBytes, size_t& aReclaimableBytes);
+
 	///----------------------------------------------------------------------------------------------------
 	/// GetRegistry:
 	/// 	Returns a copy of the registry.
@@ -58,10 +233,65 @@ class CDataLinkApi
 	std::unordered_map<std::string, LinkedResource_t> GetRegistry();
 
 	private:
-	CLogApi*                                        Logger = nullptr;
+	CLogApi*                                        Logger       = nullptr;
+	DATALINK_RESOLVEOWNER                           ResolveOwner = nullptr;
 
 	std::mutex                                      Mutex;
 	std::unordered_map<std::string, LinkedResource_t> Registry;
+
+	std::atomic<LinkedResourceSlot_t*>              Pages[DL_MAX_PAGES] = {}; /* Handle table, pages are allocated on demand and never moved. */
+	uint32_t                                        SlotCount = 0;
+	std::vector<uint32_t>                           FreeSlots;
+
+	std::unique_ptr<CDataLinkArena>                 Arena;
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetSlot:
+	/// 	Returns the slot of a handle or nullptr, if the index is out of range.
+	///----------------------------------------------------------------------------------------------------
+	inline const LinkedResourceSlot_t* GetSlot(DataLinkHandle aHandle) const
+	{
+		uint32_t index = (uint32_t)aHandle;
+
+		if (index == 0 || index > DL_SLOTS_PER_PAGE * DL_MAX_PAGES) { return nullptr; }
+
+		index--;
+
+		const LinkedResourceSlot_t* page = this->Pages[index / DL_SLOTS_PER_PAGE].load(std::memory_order_acquire);
+
+		return page ? &page[index % DL_SLOTS_PER_PAGE] : nullptr;
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// AcquireSlot:
+	/// 	Publishes a resource in the handle table. Returns its index or UINT32_MAX, if the table is full.
+	/// 	Must be called with the Mutex held.
+	///----------------------------------------------------------------------------------------------------
+	uint32_t AcquireSlot(void* aPointer, size_t aSize);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Free:
+	/// 	Invalidates the handles of a resource and frees its memory. Must be called with the Mutex held.
+	///----------------------------------------------------------------------------------------------------
+	void Free(LinkedResource_t& aResource);
+
+	///----------------------------------------------------------------------------------------------------
+	/// AddUser:
+	/// 	Adds a reference of the given signature, once per addon. Must be called with the Mutex held.
+	///----------------------------------------------------------------------------------------------------
+	static void AddUser(LinkedResource_t& aResource, signed int aSignature);
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetSignature:
+	/// 	Returns the signature of the addon owning the caller address or 0.
+	///----------------------------------------------------------------------------------------------------
+	signed int GetSignature(void* aCaller) const;
+
+	///----------------------------------------------------------------------------------------------------
+	/// Share:
+	/// 	Creates or returns the resource. aResourceSize includes the header of versioned and triple buffered resources.
+	///----------------------------------------------------------------------------------------------------
+	void* Share(const char* aIdentifier, size_t aResourceSize, const char* aUnderlyingName, bool aIsPublic, ELinkedResourceLayout aLayout, signed int aSignature);
 };
 
 #endif
@@ -0,0 +1,182 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  DlArena.cpp
+/// Description  :  Shared memory arena for small public resources.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include "DlArena.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <new>
+
+#include "Util/Platform.h"
+
+///----------------------------------------------------------------------------------------------------
+/// Align:
+/// 	Rounds up to the arena alignment.
+///----------------------------------------------------------------------------------------------------
+static uint64_t Align(uint64_t aValue)
+{
+	return (aValue + DL_ARENA_ALIGNMENT - 1) & ~(uint64_t)(DL_ARENA_ALIGNMENT - 1);
+}
+
+CDataLinkArena::CDataLinkArena(const char* aName, size_t aSize)
+{
+	this->Name       = aName;
+	this->DataOffset = (size_t)Align(sizeof(ArenaHeader_t));
+	this->Size       = (size_t)Align((std::max)(aSize, this->DataOffset + DL_ARENA_ALIGNMENT));
+
+	this->Header = static_cast<ArenaHeader_t*>(Platform::OpenSharedMemory(this->Name.c_str(), this->Size, this->Handle));
+
+	if (!this->Header) { return; }
+
+	/* Clear the data as raw memory, then construct the header over it. */
+	memset(static_cast<void*>(this->Header), 0, this->Size);
+	new (this->Header) ArenaHeader_t{};
+
+	this->Header->Magic    = DL_ARENA_MAGIC;
+	this->Header->Version  = DL_ARENA_VERSION;
+	this->Header->Size     = this->Size;
+	this->Header->Capacity = DL_ARENA_MAX_ENTRIES;
+
+	this->FreeBlocks.emplace(this->DataOffset, this->Size - this->DataOffset);
+}
+
+CDataLinkArena::~CDataLinkArena()
+{
+	if (this->Header)
+	{
+		Platform::CloseSharedMemory(this->Header, this->Size, this->Handle);
+		this->Header = nullptr;
+		this->Handle = nullptr;
+	}
+}
+
+bool CDataLinkArena::IsValid() const
+{
+	return this->Header != nullptr;
+}
+
+void* CDataLinkArena::Allocate(const char* aIdentifier, size_t aSize)
+{
+	if (!this->Header || !aIdentifier || aSize == 0) { return nullptr; }
+
+	if (strlen(aIdentifier) >= DL_ARENA_NAME_LENGTH) { return nullptr; }
+
+	/* Released entries are reused before the directory grows. */
+	uint32_t count = this->Header->EntryCount.load(std::memory_order_relaxed);
+	uint32_t index = count;
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		if (!this->Header->Entries[i].IsUsed.load(std::memory_order_relaxed))
+		{
+			index = i;
+			break;
+		}
+	}
+
+	if (index == DL_ARENA_MAX_ENTRIES) { return nullptr; }
+
+	/* First fit. */
+	uint64_t size = Align(aSize);
+	auto block = this->FreeBlocks.begin();
+
+	while (block != this->FreeBlocks.end() && block->second < size)
+	{
+		block++;
+	}
+
+	if (block == this->FreeBlocks.end()) { return nullptr; }
+
+	uint64_t offset = block->first;
+	uint64_t remaining = block->second - size;
+
+	this->FreeBlocks.erase(block);
+
+	if (remaining > 0)
+	{
+		this->FreeBlocks.emplace(offset + size, remaining);
+	}
+
+	this->Used += (size_t)size;
+
+	char* ptr = reinterpret_cast<char*>(this->Header) + offset;
+	memset(ptr, 0, (size_t)size);
+
+	ArenaEntry_t& entry = this->Header->Entries[index];
+	memset(entry.Name, 0, sizeof(entry.Name));
+	strcpy(entry.Name, aIdentifier);
+	entry.Offset = offset;
+	entry.Size   = aSize;
+	entry.IsUsed.store(1, std::memory_order_release);
+
+	if (index == count)
+	{
+		this->Header->EntryCount.store(count + 1, std::memory_order_release);
+	}
+
+	return ptr;
+}
+
+void CDataLinkArena::Free(void* aPointer)
+{
+	if (!this->Header || !aPointer) { return; }
+
+	uint64_t offset = (uint64_t)(static_cast<char*>(aPointer) - reinterpret_cast<char*>(this->Header));
+	uint32_t count = this->Header->EntryCount.load(std::memory_order_relaxed);
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		ArenaEntry_t& entry = this->Header->Entries[i];
+
+		if (!entry.IsUsed.load(std::memory_order_relaxed) || entry.Offset != offset) { continue; }
+
+		entry.IsUsed.store(0, std::memory_order_release);
+
+		uint64_t size = Align(entry.Size);
+		this->Used -= (size_t)size;
+
+		/* Merge with the neighbouring free blocks. */
+		auto next = this->FreeBlocks.lower_bound(offset);
+
+		if (next != this->FreeBlocks.end() && offset + size == next->first)
+		{
+			size += next->second;
+			next = this->FreeBlocks.erase(next);
+		}
+
+		if (next != this->FreeBlocks.begin())
+		{
+			auto prev = std::prev(next);
+
+			if (prev->first + prev->second == offset)
+			{
+				prev->second += size;
+				return;
+			}
+		}
+
+		this->FreeBlocks.emplace(offset, size);
+		return;
+	}
+}
+
+const std::string& CDataLinkArena::GetName() const
+{
+	return this->Name;
+}
+
+size_t CDataLinkArena::GetUsed() const
+{
+	return this->Used;
+}
+
+size_t CDataLinkArena::GetSize() const
+{
+	return this->Size - this->DataOffset;
+}
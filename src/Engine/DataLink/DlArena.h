@@ -0,0 +1,85 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  DlArena.h
+/// Description  :  Shared memory arena for small public resources.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef DLARENA_H
+#define DLARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "DlArenaHeader.h"
+
+///----------------------------------------------------------------------------------------------------
+/// CDataLinkArena Class
+/// 	One named mapping that holds many resources, so small ones don't cost a mapping each.
+/// 	Not thread-safe, guarded by the owning CDataLinkApi.
+///----------------------------------------------------------------------------------------------------
+class CDataLinkArena
+{
+	public:
+	///----------------------------------------------------------------------------------------------------
+	/// ctor
+	/// 	Creates and maps the arena. Check IsValid.
+	///----------------------------------------------------------------------------------------------------
+	CDataLinkArena(const char* aName, size_t aSize);
+
+	///----------------------------------------------------------------------------------------------------
+	/// dtor
+	///----------------------------------------------------------------------------------------------------
+	~CDataLinkArena();
+
+	///----------------------------------------------------------------------------------------------------
+	/// IsValid:
+	/// 	Returns true, if the mapping was created.
+	///----------------------------------------------------------------------------------------------------
+	bool IsValid() const;
+
+	///----------------------------------------------------------------------------------------------------
+	/// Allocate:
+	/// 	Allocates zeroed memory and adds it to the directory under aIdentifier.
+	/// 	Returns nullptr, if the identifier is too long or the arena is full.
+	///----------------------------------------------------------------------------------------------------
+	void* Allocate(const char* aIdentifier, size_t aSize);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Free:
+	/// 	Removes an allocation from the directory and returns its memory to the arena.
+	///----------------------------------------------------------------------------------------------------
+	void Free(void* aPointer);
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetName:
+	/// 	Returns the name of the mapping.
+	///----------------------------------------------------------------------------------------------------
+	const std::string& GetName() const;
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetUsed:
+	/// 	Returns the bytes allocated, including alignment.
+	///----------------------------------------------------------------------------------------------------
+	size_t GetUsed() const;
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetSize:
+	/// 	Returns the bytes available for allocations.
+	///----------------------------------------------------------------------------------------------------
+	size_t GetSize() const;
+
+	private:
+	std::string                  Name;
+	void*                        Handle     = nullptr;
+	ArenaHeader_t*               Header     = nullptr;
+	size_t                       Size       = 0;
+	size_t                       DataOffset = 0;
+	size_t                       Used       = 0;
+	std::map<uint64_t, uint64_t> FreeBlocks;        /* Offset to size, adjacent blocks are merged. */
+};
+
+#endif
@@ -0,0 +1,31 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  DlArenaEntry.h
+/// Description  :  Contains the ArenaEntry_t struct definition.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef DLARENAENTRY_H
+#define DLARENAENTRY_H
+
+#include <atomic>
+#include <cstdint>
+
+constexpr uint32_t DL_ARENA_NAME_LENGTH = 52;
+
+///----------------------------------------------------------------------------------------------------
+/// ArenaEntry_t Struct
+/// 	Directory entry of a resource in the arena. Only read while IsUsed is set.
+///----------------------------------------------------------------------------------------------------
+struct ArenaEntry_t
+{
+	char                  Name[DL_ARENA_NAME_LENGTH]; /* Identifier of the resource, null terminated. */
+	std::atomic<uint32_t> IsUsed;
+	uint64_t              Offset;                     /* Offset of the data from the start of the mapping. */
+	uint64_t              Size;
+};
+
+static_assert(sizeof(ArenaEntry_t) == 72, "The arena is read by other processes, the layout must not change.");
+
+#endif
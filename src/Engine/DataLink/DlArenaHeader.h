@@ -0,0 +1,39 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  DlArenaHeader.h
+/// Description  :  Contains the ArenaHeader_t struct definition.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef DLARENAHEADER_H
+#define DLARENAHEADER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "DlArenaEntry.h"
+
+constexpr const char* DL_ARENA             = "DL_ARENA"; /* Mapped as DL_ARENA_<pid>. */
+constexpr uint32_t    DL_ARENA_MAGIC       = 0x52414C44; /* "DLAR" */
+constexpr uint32_t    DL_ARENA_VERSION     = 1;
+constexpr uint32_t    DL_ARENA_MAX_ENTRIES = 256;
+constexpr size_t      DL_ARENA_ALIGNMENT   = 16;
+
+///----------------------------------------------------------------------------------------------------
+/// ArenaHeader_t Struct
+/// 	Start of the arena mapping. External readers look resources up by name in the Entries,
+/// 	entries are fully written before EntryCount includes them.
+///----------------------------------------------------------------------------------------------------
+struct ArenaHeader_t
+{
+	uint32_t              Magic;
+	uint32_t              Version;
+	uint64_t              Size;                           /* Size of the mapping, including the header. */
+	std::atomic<uint32_t> EntryCount;                     /* Entries in use or released, never decreases. */
+	uint32_t              Capacity;                       /* DL_ARENA_MAX_ENTRIES. */
+	ArenaEntry_t          Entries[DL_ARENA_MAX_ENTRIES];
+};
+
+#endif
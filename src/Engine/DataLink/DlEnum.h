@@ -18,7 +18,18 @@ enum class ELinkedResourceType : uint32_t
 {
 	None,
 	Public,
-	Internal
+	Internal,
+	Arena     /* Public, but sub-allocated in the shared arena. */
+};
+
+///----------------------------------------------------------------------------------------------------
+/// ELinkedResourceLayout Enumeration
+///----------------------------------------------------------------------------------------------------
+enum class ELinkedResourceLayout : uint32_t
+{
+	Plain,
+	Versioned,      /* Starts with a VersionedHeader_t. */
+	TripleBuffered  /* Starts with a TripleBufferHeader_t. */
 };
 
 #endif
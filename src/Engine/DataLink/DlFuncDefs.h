@@ -9,7 +9,24 @@
 #ifndef DLFUNCDEFS_H
 #define DLFUNCDEFS_H
 
-typedef void* (*DATALINK_GETRESOURCE)  (const char* aIdentifier);
-typedef void* (*DATALINK_SHARERESOURCE)(const char* aIdentifier, size_t aResourceSize);
+#include <cstddef>
+#include <cstdint>
+
+/* Generation in the upper, slot index + 1 in the lower 32 bits. 0 is invalid, released resources invalidate their handles. */
+typedef uint64_t DataLinkHandle;
+
+typedef void*          (*DATALINK_GETRESOURCE)      (const char* aIdentifier);
+typedef void*          (*DATALINK_SHARERESOURCE)    (const char* aIdentifier, size_t aResourceSize);
+typedef void*          (*DATALINK_SHAREVERSIONED)   (const char* aIdentifier, size_t aResourceSize);
+typedef void*          (*DATALINK_BEGINWRITE)       (void* aResource);
+typedef void           (*DATALINK_ENDWRITE)         (void* aResource);
+typedef bool           (*DATALINK_READSNAPSHOT)     (const void* aResource, void* aBuffer, size_t aSize);
+typedef DataLinkHandle (*DATALINK_GETHANDLE)        (const char* aIdentifier);
+typedef void*          (*DATALINK_GETBYHANDLE)      (DataLinkHandle aHandle);
+typedef void           (*DATALINK_RELEASE)          (const char* aIdentifier);
+typedef void*          (*DATALINK_SHARETRIPLEBUFFER)(const char* aIdentifier, size_t aResourceSize);
+typedef void*          (*DATALINK_BEGINPUBLISH)     (void* aResource);
+typedef void           (*DATALINK_ENDPUBLISH)       (void* aResource);
+typedef bool           (*DATALINK_READLATEST)       (const void* aResource, void* aBuffer, size_t aSize);
 
 #endif
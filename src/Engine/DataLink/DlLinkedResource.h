@@ -9,8 +9,9 @@
 #ifndef DLLINKEDRESOURCE_H
 #define DLLINKEDRESOURCE_H
 
-#include <windows.h>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include "DlEnum.h"
 
@@ -19,11 +20,15 @@
 ///----------------------------------------------------------------------------------------------------
 struct LinkedResource_t
 {
-	ELinkedResourceType Type;           /* The type of the resource. Public or Internal. */
-	HANDLE              Handle;         /* The handle of the resource.                   */
-	void*               Pointer;        /* The pointer to the resource.                  */
-	size_t              Size;           /* The size of the resource.                     */
-	std::string         UnderlyingName; /* The real name of the memory mapped file.      */
+	ELinkedResourceType     Type;           /* The type of the resource. Public, Internal or Arena. */
+	void*                   Handle;         /* The handle of the resource.                          */
+	void*                   Pointer;        /* The pointer to the resource.                         */
+	size_t                  Size;           /* The size of the resource.                            */
+	std::string             UnderlyingName; /* The real name of the memory mapped file.             */
+	ELinkedResourceLayout   Layout;         /* Plain, versioned or triple buffered.                 */
+	uint32_t                Slot;           /* Index in the handle table.                           */
+	signed int              Owner;          /* Signature of the creator, 0 if Nexus.                */
+	std::vector<signed int> Users;          /* Signatures holding a reference, 0 pins it.           */
 };
 
 #endif
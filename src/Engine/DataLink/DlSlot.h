@@ -0,0 +1,29 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  DlSlot.h
+/// Description  :  Contains the LinkedResourceSlot_t struct definition.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef DLSLOT_H
+#define DLSLOT_H
+
+#include <atomic>
+#include <cstdint>
+
+constexpr uint32_t DL_SLOTS_PER_PAGE = 256;
+constexpr uint32_t DL_MAX_PAGES      = 256;
+
+///----------------------------------------------------------------------------------------------------
+/// LinkedResourceSlot_t Struct
+/// 	Entry of the handle table. Read without a lock, a handle is valid while its generation matches.
+///----------------------------------------------------------------------------------------------------
+struct LinkedResourceSlot_t
+{
+	std::atomic<uint32_t> Generation = 0; /* Incremented, when the resource is released. */
+	std::atomic<void*>    Pointer    = nullptr;
+	std::atomic<size_t>   Size       = 0;
+};
+
+#endif
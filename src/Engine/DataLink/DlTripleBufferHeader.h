@@ -0,0 +1,35 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  DlTripleBufferHeader.h
+/// Description  :  Contains the triple buffered resource header struct definition.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef DLTRIPLEBUFFERHEADER_H
+#define DLTRIPLEBUFFERHEADER_H
+
+#include <atomic>
+#include <cstdint>
+
+constexpr uint32_t DL_TRIPLEBUFFER_MAGIC   = 0x42544C44; /* "DLTB" */
+constexpr uint32_t DL_TRIPLEBUFFER_BUFFERS = 3;
+
+///----------------------------------------------------------------------------------------------------
+/// TripleBufferHeader_t Struct
+/// 	Precedes the three buffers of a triple buffered resource. Buffer i starts at sizeof(TripleBufferHeader_t) + i * Size.
+/// 	Latest holds the number of published frames in the upper 30 bits and the index of the newest complete buffer in the lower 2.
+/// 	The sequence of a buffer is odd while it is written.
+///----------------------------------------------------------------------------------------------------
+struct TripleBufferHeader_t
+{
+	std::atomic<uint32_t> Latest;
+	uint32_t              Magic;                              /* DL_TRIPLEBUFFER_MAGIC. */
+	uint64_t              Size;                               /* Size of one buffer. */
+	std::atomic<uint32_t> Sequence[DL_TRIPLEBUFFER_BUFFERS];
+	std::atomic<uint32_t> IsPublishing;                       /* Keeps a second producer out. */
+};
+
+static_assert(sizeof(TripleBufferHeader_t) == 32, "Triple buffered resources are shared with addons, the layout must not change.");
+
+#endif
@@ -0,0 +1,32 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  DlVersionedHeader.h
+/// Description  :  Contains the versioned resource header struct definition.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef DLVERSIONEDHEADER_H
+#define DLVERSIONEDHEADER_H
+
+#include <atomic>
+#include <cstdint>
+
+constexpr uint32_t DL_VERSIONED_MAGIC = 0x4E564C44; /* "DLVN" */
+
+///----------------------------------------------------------------------------------------------------
+/// VersionedHeader_t Struct
+/// 	Precedes the data of a versioned resource. The data follows at offset sizeof(VersionedHeader_t).
+/// 	Sequence is odd while a write is in progress and increases by two with every completed write.
+///----------------------------------------------------------------------------------------------------
+struct VersionedHeader_t
+{
+	std::atomic<uint32_t> Sequence;
+	uint32_t              Magic;    /* DL_VERSIONED_MAGIC. */
+	uint64_t              Size;     /* Size of the data, excluding the header. */
+};
+
+static_assert(sizeof(VersionedHeader_t) == 16, "Versioned resources are shared with addons, the layout must not change.");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "The sequence must be usable from other processes.");
+
+#endif
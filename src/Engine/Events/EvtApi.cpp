@@ -8,159 +8,1084 @@
 
 #include "EvtApi.h"
 
-#include "Engine/Loader/Loader.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string_view>
 
-void CEventApi::Raise(const char* aIdentifier, void* aEventData)
+#include "EvtStream.h"
+
+/* Amount of raises currently dispatching on this thread. Used to avoid waiting on ourselves. */
+static thread_local int s_DispatchDepth = 0;
+
+/* Maximum amount of idle deferred event nodes kept for reuse. */
+constexpr size_t s_DeferredPoolCapacity = 256;
+
+/* Payload capacity above which a node is not returned to the pool. */
+constexpr size_t s_DeferredPoolMaxPayload = 64 * 1024;
+
+CEventApi::CEventApi(EEventDeferMode aDeferMode, EVENTS_RESOLVEOWNER aResolveOwner)
 {
-	if (aIdentifier == nullptr) { return; }
+	this->DeferMode = aDeferMode;
+	this->ResolveOwner = aResolveOwner;
+	this->QueueHead = &this->QueueStub;
+	this->QueueTail = &this->QueueStub;
+
+	if (this->DeferMode == EEventDeferMode::Thread)
+	{
+		this->IsDispatcherRunning = true;
+		this->DispatcherThread = std::thread(&CEventApi::ProcessDispatcher, this);
+	}
+}
 
-	const std::lock_guard<std::recursive_mutex> lock(this->Mutex);
+CEventApi::~CEventApi()
+{
+	if (this->DispatcherThread.joinable())
+	{
+		this->IsDispatcherRunning = false;
+		this->DispatcherConVar.notify_one();
+		this->DispatcherThread.join();
+	}
 
-	auto it = this->Registry.find(aIdentifier);
-	
-	if (it == this->Registry.end())
+	/* Drop anything that has not been dispatched anymore. */
 	{
-		return;
+		const std::lock_guard<std::mutex> lock(this->ConsumerMutex);
+
+		while (DeferredEvent_t* node = this->Dequeue())
+		{
+			delete node;
+		}
+	}
+
+	{
+		const std::lock_guard<std::mutex> lock(this->PoolMutex);
+
+		for (DeferredEvent_t* node : this->Pool)
+		{
+			delete node;
+		}
+
+		this->Pool.clear();
 	}
 
-	it->second.AmountRaises++;
+	const std::unique_lock<std::shared_mutex> lock(this->Mutex);
 
-	for (EventSubscriber_t& sub : it->second.Subscribers)
+	for (auto& [identifier, ev] : this->Registry)
 	{
-		sub.Callback(aEventData);
+		delete ev;
 	}
+
+	this->Registry.clear();
+}
+
+void CEventApi::Raise(const char* aIdentifier, void* aEventData)
+{
+	if (aIdentifier == nullptr) { return; }
+
+	this->RaiseByHandle(this->FindOrCreateRaised(aIdentifier), aEventData);
 }
 
 void CEventApi::Raise(signed int aSignature, const char* aIdentifier, void* aEventData)
 {
 	if (aIdentifier == nullptr) { return; }
 
-	const std::lock_guard<std::recursive_mutex> lock(this->Mutex);
+	this->RaiseByHandle(aSignature, this->FindOrCreateRaised(aIdentifier), aEventData);
+}
 
-	auto it = this->Registry.find(aIdentifier);
+void CEventApi::Subscribe(const char* aIdentifier, EVENT_CONSUME aConsumeEventCallback)
+{
+	if (aIdentifier == nullptr)           { return; }
+	if (aConsumeEventCallback == nullptr) { return; }
 
-	if (it == this->Registry.end())
+	std::string_view identifier = aIdentifier;
+
+	if (!identifier.empty() && identifier.back() == '*')
 	{
+		this->SubscribePattern(std::string(identifier.substr(0, identifier.size() - 1)), aConsumeEventCallback);
 		return;
 	}
 
-	it->second.AmountRaises++;
+	this->SubscribeByHandle(this->FindOrCreate(aIdentifier), aConsumeEventCallback);
+}
+
+void CEventApi::Unsubscribe(const char* aIdentifier, EVENT_CONSUME aConsumeEventCallback)
+{
+	if (aIdentifier == nullptr) { return; }
+
+	std::string_view identifier = aIdentifier;
 
-	for (EventSubscriber_t& sub : it->second.Subscribers)
+	if (!identifier.empty() && identifier.back() == '*')
 	{
-		if (sub.Signature == aSignature)
-		{
-			sub.Callback(aEventData);
-			break;
-		}
+		this->UnsubscribePattern(std::string(identifier.substr(0, identifier.size() - 1)), aConsumeEventCallback);
+		return;
 	}
+
+	this->UnsubscribeByHandle(this->Find(aIdentifier), aConsumeEventCallback);
 }
 
-void CEventApi::Subscribe(const char* aIdentifier, EVENT_CONSUME aConsumeEventCallback)
+EventHandle CEventApi::GetHandle(const char* aIdentifier)
 {
-	if (aIdentifier == nullptr)           { return; }
+	if (aIdentifier == nullptr) { return nullptr; }
+
+	return this->FindOrCreate(aIdentifier);
+}
+
+const char* CEventApi::GetIdentifier(EventHandle aHandle) const
+{
+	if (aHandle == nullptr) { return nullptr; }
+
+	return static_cast<EventData_t*>(aHandle)->Identifier.c_str();
+}
+
+void CEventApi::RaiseByHandle(EventHandle aHandle, void* aEventData)
+{
+	if (aHandle == nullptr) { return; }
+
+	EventData_t* ev = static_cast<EventData_t*>(aHandle);
+
+	if (this->Coalesce(ev, aEventData, 0))
+	{
+		return;
+	}
+
+	this->Dispatch(ev, aEventData);
+}
+
+void CEventApi::RaiseByHandle(signed int aSignature, EventHandle aHandle, void* aEventData)
+{
+	if (aHandle == nullptr) { return; }
+
+	/* Targeted raises are never coalesced. */
+	this->Dispatch(static_cast<EventData_t*>(aHandle), aSignature, aEventData);
+}
+
+void CEventApi::SubscribeByHandle(EventHandle aHandle, EVENT_CONSUME aConsumeEventCallback)
+{
+	if (aHandle == nullptr)               { return; }
 	if (aConsumeEventCallback == nullptr) { return; }
 
-	const std::lock_guard<std::recursive_mutex> lock(this->Mutex);
-	
+	EventData_t* ev = static_cast<EventData_t*>(aHandle);
+
 	EventSubscriber_t sub{};
 	sub.Callback = aConsumeEventCallback;
+	sub.Signature = this->ResolveSignature(aConsumeEventCallback);
 
-	/* Resolve addon signature. */
-	for (Addon_t* addon : Loader::Addons)
+	const std::lock_guard<std::mutex> lock(this->WriteMutex);
+
+	EventSubscriberList_t current = std::atomic_load(&ev->Subscribers);
+
+	std::vector<EventSubscriber_t> subscribers;
+	if (current)
 	{
-		if (addon->Module == nullptr ||
-			addon->ModuleSize == 0 ||
-			addon->Definitions == nullptr ||
-			addon->Definitions->Signature == 0)
-		{
-			continue;
-		}
+		subscribers.reserve(current->size() + 1);
+		subscribers.assign(current->begin(), current->end());
+	}
+	subscribers.push_back(sub);
+
+	/* Adding a subscriber never invalidates anything a reader might be calling, no need to wait. */
+	this->Publish(ev, std::move(subscribers));
+}
 
-		void* startAddress = addon->Module;
-		void* endAddress = ((PBYTE)addon->Module) + addon->ModuleSize;
+void CEventApi::UnsubscribeByHandle(EventHandle aHandle, EVENT_CONSUME aConsumeEventCallback)
+{
+	if (aHandle == nullptr) { return; }
+
+	EventData_t* ev = static_cast<EventData_t*>(aHandle);
+
+	EventSubscriberList_t prev;
+
+	{
+		const std::lock_guard<std::mutex> lock(this->WriteMutex);
+
+		EventSubscriberList_t current = std::atomic_load(&ev->Subscribers);
 
-		if (aConsumeEventCallback >= startAddress && aConsumeEventCallback <= endAddress)
+		if (!current)
 		{
-			sub.Signature = addon->Definitions->Signature;
-			break;
+			return;
 		}
+
+		std::vector<EventSubscriber_t> subscribers = *current;
+		current.reset();
+
+		subscribers.erase(
+			std::remove_if(
+				subscribers.begin(),
+				subscribers.end(),
+				[aConsumeEventCallback](EventSubscriber_t& sub)
+				{
+					/* Subscriptions through a pattern are only removed by unsubscribing the pattern. */
+					return aConsumeEventCallback == sub.Callback && sub.Pattern == nullptr;
+				}
+			),
+			subscribers.end()
+		);
+
+		prev = this->Publish(ev, std::move(subscribers));
 	}
 
-	auto it = this->Registry.find(aIdentifier);
+	/* Wait outside of the lock, a callback still in flight might (un)subscribe itself. */
+	CEventApi::WaitForReaders(prev);
+}
 
-	/* Emplace new event or add subscriber to existing. */
-	if (it == this->Registry.end())
-	{
-		EventData_t ev{};
-		ev.Subscribers.push_back(sub);
+void CEventApi::RaiseDeferred(const char* aIdentifier, const void* aEventData, size_t aSize)
+{
+	if (aIdentifier == nullptr) { return; }
+
+	this->RaiseDeferredByHandle(this->FindOrCreateRaised(aIdentifier), aEventData, aSize);
+}
+
+void CEventApi::RaiseDeferredByHandle(EventHandle aHandle, const void* aEventData, size_t aSize)
+{
+	if (aHandle == nullptr) { return; }
+
+	EventData_t* ev = static_cast<EventData_t*>(aHandle);
 
-		this->Registry.emplace(aIdentifier, ev);
+	if (this->Coalesce(ev, aEventData, aSize))
+	{
+		return;
 	}
-	else
+
+	this->Enqueue(ev, false, 0, aEventData, aSize);
+}
+
+void CEventApi::RaiseDeferredByHandle(signed int aSignature, EventHandle aHandle, const void* aEventData, size_t aSize)
+{
+	if (aHandle == nullptr) { return; }
+
+	this->Enqueue(static_cast<EventData_t*>(aHandle), true, aSignature, aEventData, aSize);
+}
+
+bool CEventApi::SetCoalescing(EventHandle aHandle, EEventCoalescing aPolicy, unsigned aLimit, size_t aPayloadSize)
+{
+	if (aHandle == nullptr) { return false; }
+
+	switch (aPolicy)
 	{
-		it->second.Subscribers.push_back(sub);
+		case EEventCoalescing::None:
+		case EEventCoalescing::LastValue:
+			break;
+		case EEventCoalescing::RateLimit:
+			if (aLimit == 0) { return false; }
+			break;
+		case EEventCoalescing::Batch:
+			if (aPayloadSize == 0 || aPayloadSize > UINT32_MAX) { return false; }
+			break;
+		default:
+			return false;
 	}
+
+	EventData_t* ev = static_cast<EventData_t*>(aHandle);
+
+	const std::lock_guard<std::mutex> lock(ev->CoalesceMutex);
+
+	ev->Limit       = aLimit;
+	ev->PayloadSize = aPayloadSize;
+	ev->WindowStart = 0;
+	ev->WindowCount = 0;
+
+	/* Drop anything pending under the previous policy, a queued delivery finds nothing and is skipped. */
+	ev->IsPending      = false;
+	ev->HasPendingData = false;
+	ev->PendingCount   = 0;
+	ev->Pending.clear();
+
+	ev->Coalescing = aPolicy;
+
+	return true;
 }
 
-void CEventApi::Unsubscribe(const char* aIdentifier, EVENT_CONSUME aConsumeEventCallback)
+bool CEventApi::SetCoalescing(const char* aIdentifier, EEventCoalescing aPolicy, unsigned aLimit, size_t aPayloadSize)
+{
+	if (aIdentifier == nullptr) { return false; }
+
+	return this->SetCoalescing(this->FindOrCreate(aIdentifier), aPolicy, aLimit, aPayloadSize);
+}
+
+void CEventApi::SetStream(CEventStream* aStream)
+{
+	this->Stream = aStream;
+}
+
+void CEventApi::SetStreamed(const char* aIdentifier, bool aIsStreamed, size_t aPayloadSize)
 {
 	if (aIdentifier == nullptr) { return; }
 
-	const std::lock_guard<std::recursive_mutex> lock(this->Mutex);
-	
-	auto it = this->Registry.find(aIdentifier);
+	EventData_t* ev = this->FindOrCreate(aIdentifier);
 
-	if (it == this->Registry.end())
+	ev->StreamSize = aPayloadSize;
+	ev->IsStreamed = aIsStreamed;
+}
+
+void CEventApi::Flush()
+{
+	if (this->DeferMode != EEventDeferMode::Frame)
 	{
 		return;
 	}
 
-	it->second.Subscribers.erase(
-		std::remove_if(
-			it->second.Subscribers.begin(),
-			it->second.Subscribers.end(),
-			[aConsumeEventCallback](EventSubscriber_t& sub)
-			{
-				return aConsumeEventCallback == sub.Callback;
-			}
-		),
-		it->second.Subscribers.end()
-	);
+	this->DispatchDeferred();
 }
 
 int CEventApi::Verify(void* aStartAddress, void* aEndAddress)
 {
 	int refCounter = 0;
 
-	const std::lock_guard<std::recursive_mutex> lock(this->Mutex);
-	
-	for (auto& [identifier, ev] : this->Registry)
+	std::vector<EventData_t*> events;
+
+	{
+		const std::shared_lock<std::shared_mutex> lock(this->Mutex);
+
+		events.reserve(this->Registry.size());
+		for (auto& [identifier, ev] : this->Registry)
+		{
+			events.push_back(ev);
+		}
+	}
+
+	std::vector<EventSubscriberList_t> prevs;
+
+	std::unique_lock<std::mutex> lock(this->WriteMutex);
+
+	for (EventData_t* ev : events)
 	{
-		ev.Subscribers.erase(
+		EventSubscriberList_t current = std::atomic_load(&ev->Subscribers);
+
+		if (!current)
+		{
+			continue;
+		}
+
+		std::vector<EventSubscriber_t> subscribers = *current;
+		current.reset();
+
+		size_t prevCount = subscribers.size();
+
+		subscribers.erase(
 			std::remove_if(
-				ev.Subscribers.begin(),
-				ev.Subscribers.end(),
+				subscribers.begin(),
+				subscribers.end(),
 				[&refCounter, aStartAddress, aEndAddress](EventSubscriber_t& sub)
 				{
 					if (sub.Callback >= aStartAddress && sub.Callback <= aEndAddress)
 					{
-						refCounter++;
+						/* Pattern subscriptions are counted once below, not per resolved event. */
+						if (sub.Pattern == nullptr)
+						{
+							refCounter++;
+						}
 						return true;
 					}
 					return false;
 				}
 			),
-			ev.Subscribers.end()
+			subscribers.end()
+		);
+
+		/* Nothing removed, no need to publish. */
+		if (subscribers.size() == prevCount)
+		{
+			continue;
+		}
+
+		prevs.push_back(this->Publish(ev, std::move(subscribers)));
+	}
+
+	/* Remove the pattern subscriptions themselves, so future events do not resolve to them. */
+	std::vector<EventPatternNode_t*> nodes{ &this->PatternRoot };
+
+	while (!nodes.empty())
+	{
+		EventPatternNode_t* node = nodes.back();
+		nodes.pop_back();
+
+		size_t prevCount = node->Subscribers.size();
+
+		node->Subscribers.erase(
+			std::remove_if(
+				node->Subscribers.begin(),
+				node->Subscribers.end(),
+				[aStartAddress, aEndAddress](EventSubscriber_t& sub)
+				{
+					return sub.Callback >= aStartAddress && sub.Callback <= aEndAddress;
+				}
+			),
+			node->Subscribers.end()
 		);
+
+		refCounter += static_cast<int>(prevCount - node->Subscribers.size());
+		this->PatternCount -= prevCount - node->Subscribers.size();
+
+		for (auto& [c, child] : node->Children)
+		{
+			nodes.push_back(child.get());
+		}
+	}
+
+	lock.unlock();
+
+	for (EventSubscriberList_t& prev : prevs)
+	{
+		CEventApi::WaitForReaders(prev);
 	}
 
 	return refCounter;
 }
 
-std::unordered_map<std::string, EventData_t> CEventApi::GetRegistry() const
+std::unordered_map<std::string, EventInfo_t> CEventApi::GetRegistry() const
+{
+	const std::shared_lock<std::shared_mutex> lock(this->Mutex);
+
+	std::unordered_map<std::string, EventInfo_t> registry;
+	registry.reserve(this->Registry.size());
+
+	for (auto& [identifier, ev] : this->Registry)
+	{
+		EventInfo_t info{};
+		info.AmountRaises     = ev->AmountRaises;
+		info.Coalescing       = ev->Coalescing;
+		info.AmountMerged     = ev->AmountMerged;
+		info.AmountSuppressed = ev->AmountSuppressed;
+		info.IsStreamed       = ev->IsStreamed;
+
+		EventSubscriberList_t subscribers = std::atomic_load(&ev->Subscribers);
+		if (subscribers)
+		{
+			info.Subscribers = *subscribers;
+		}
+
+		registry.emplace(identifier, std::move(info));
+	}
+
+	return registry;
+}
+
+EventData_t* CEventApi::Find(const char* aIdentifier) const
+{
+	const std::shared_lock<std::shared_mutex> lock(this->Mutex);
+
+	auto it = this->Registry.find(aIdentifier);
+
+	if (it == this->Registry.end())
+	{
+		return nullptr;
+	}
+
+	return it->second;
+}
+
+EventData_t* CEventApi::FindOrCreate(const char* aIdentifier)
+{
+	EventData_t* ev = this->Find(aIdentifier);
+
+	if (ev)
+	{
+		return ev;
+	}
+
+	/* The WriteMutex is taken first, so pattern subscriptions cannot change until the event is resolved. */
+	const std::lock_guard<std::mutex> writeLock(this->WriteMutex);
+	const std::unique_lock<std::shared_mutex> lock(this->Mutex);
+
+	/* Check again, might have been created between releasing the shared and acquiring the unique lock. */
+	auto it = this->Registry.find(aIdentifier);
+
+	if (it != this->Registry.end())
+	{
+		return it->second;
+	}
+
+	ev = new EventData_t();
+	ev->Identifier = aIdentifier;
+
+	/* Resolve the pattern subscriptions once, every node along the identifier is a matching prefix. */
+	std::vector<EventSubscriber_t> subscribers;
+	EventPatternNode_t* node = &this->PatternRoot;
+
+	subscribers.insert(subscribers.end(), node->Subscribers.begin(), node->Subscribers.end());
+
+	for (char c : ev->Identifier)
+	{
+		std::unique_ptr<EventPatternNode_t>& child = node->Children[c];
+
+		if (!child)
+		{
+			child = std::make_unique<EventPatternNode_t>();
+			child->Prefix = node->Prefix + c;
+		}
+
+		node = child.get();
+		subscribers.insert(subscribers.end(), node->Subscribers.begin(), node->Subscribers.end());
+	}
+
+	node->Events.push_back(ev);
+
+	if (!subscribers.empty())
+	{
+		this->Publish(ev, std::move(subscribers));
+	}
+
+	/* Only publish the event after its subscribers, so no raise can miss them. */
+	this->Registry.emplace(aIdentifier, ev);
+
+	return ev;
+}
+
+EventData_t* CEventApi::FindOrCreateRaised(const char* aIdentifier)
+{
+	EventData_t* ev = this->Find(aIdentifier);
+
+	/* Without patterns, nobody could receive a raise of an unknown event. */
+	if (ev == nullptr && this->PatternCount > 0)
+	{
+		ev = this->FindOrCreate(aIdentifier);
+	}
+
+	return ev;
+}
+
+void CEventApi::SubscribePattern(const std::string& aPrefix, EVENT_CONSUME aConsumeEventCallback)
 {
-	const std::lock_guard<std::recursive_mutex> lock(this->Mutex);
+	EventSubscriber_t sub{};
+	sub.Callback = aConsumeEventCallback;
+	sub.Signature = this->ResolveSignature(aConsumeEventCallback);
+
+	const std::lock_guard<std::mutex> lock(this->WriteMutex);
 
-	return this->Registry;
+	EventPatternNode_t* node = this->GetPatternNode(aPrefix, true);
+	sub.Pattern = node;
+
+	node->Subscribers.push_back(sub);
+	this->PatternCount++;
+
+	std::vector<EventData_t*> events;
+	CEventApi::CollectEvents(node, events);
+
+	for (EventData_t* ev : events)
+	{
+		EventSubscriberList_t current = std::atomic_load(&ev->Subscribers);
+
+		std::vector<EventSubscriber_t> subscribers;
+		if (current)
+		{
+			subscribers.reserve(current->size() + 1);
+			subscribers.assign(current->begin(), current->end());
+		}
+		subscribers.push_back(sub);
+
+		this->Publish(ev, std::move(subscribers));
+	}
+}
+
+void CEventApi::UnsubscribePattern(const std::string& aPrefix, EVENT_CONSUME aConsumeEventCallback)
+{
+	std::vector<EventSubscriberList_t> prevs;
+
+	{
+		const std::lock_guard<std::mutex> lock(this->WriteMutex);
+
+		EventPatternNode_t* node = this->GetPatternNode(aPrefix, false);
+
+		if (node == nullptr)
+		{
+			return;
+		}
+
+		size_t prevCount = node->Subscribers.size();
+
+		node->Subscribers.erase(
+			std::remove_if(
+				node->Subscribers.begin(),
+				node->Subscribers.end(),
+				[aConsumeEventCallback](EventSubscriber_t& sub)
+				{
+					return aConsumeEventCallback == sub.Callback;
+				}
+			),
+			node->Subscribers.end()
+		);
+
+		if (node->Subscribers.size() == prevCount)
+		{
+			return;
+		}
+
+		this->PatternCount -= prevCount - node->Subscribers.size();
+
+		std::vector<EventData_t*> events;
+		CEventApi::CollectEvents(node, events);
+
+		for (EventData_t* ev : events)
+		{
+			EventSubscriberList_t current = std::atomic_load(&ev->Subscribers);
+
+			if (!current)
+			{
+				continue;
+			}
+
+			std::vector<EventSubscriber_t> subscribers = *current;
+			current.reset();
+
+			subscribers.erase(
+				std::remove_if(
+					subscribers.begin(),
+					subscribers.end(),
+					[aConsumeEventCallback, node](EventSubscriber_t& sub)
+					{
+						return aConsumeEventCallback == sub.Callback && sub.Pattern == node;
+					}
+				),
+				subscribers.end()
+			);
+
+			prevs.push_back(this->Publish(ev, std::move(subscribers)));
+		}
+	}
+
+	for (EventSubscriberList_t& prev : prevs)
+	{
+		CEventApi::WaitForReaders(prev);
+	}
+}
+
+EventPatternNode_t* CEventApi::GetPatternNode(const std::string& aPrefix, bool aCreate)
+{
+	EventPatternNode_t* node = &this->PatternRoot;
+
+	for (char c : aPrefix)
+	{
+		auto it = node->Children.find(c);
+
+		if (it != node->Children.end())
+		{
+			node = it->second.get();
+			continue;
+		}
+
+		if (!aCreate)
+		{
+			return nullptr;
+		}
+
+		std::unique_ptr<EventPatternNode_t> child = std::make_unique<EventPatternNode_t>();
+		child->Prefix = node->Prefix + c;
+
+		node = node->Children.emplace(c, std::move(child)).first->second.get();
+	}
+
+	return node;
+}
+
+void CEventApi::CollectEvents(const EventPatternNode_t* aNode, std::vector<EventData_t*>& aEvents)
+{
+	std::vector<const EventPatternNode_t*> nodes{ aNode };
+
+	while (!nodes.empty())
+	{
+		const EventPatternNode_t* node = nodes.back();
+		nodes.pop_back();
+
+		aEvents.insert(aEvents.end(), node->Events.begin(), node->Events.end());
+
+		for (auto& [c, child] : node->Children)
+		{
+			nodes.push_back(child.get());
+		}
+	}
+}
+
+EventSubscriberList_t CEventApi::Publish(EventData_t* aEvent, std::vector<EventSubscriber_t>&& aSubscribers)
+{
+	EventSubscriberList_t next = std::make_shared<const std::vector<EventSubscriber_t>>(std::move(aSubscribers));
+	return std::atomic_exchange(&aEvent->Subscribers, next);
+}
+
+void CEventApi::WaitForReaders(EventSubscriberList_t& aSubscribers)
+{
+	if (!aSubscribers)
+	{
+		return;
+	}
+
+	/* Called from within a callback, this thread might hold the old list itself. */
+	if (s_DispatchDepth > 0)
+	{
+		return;
+	}
+
+	/* The list was replaced, no new reader can acquire it anymore. Wait for the in-flight ones to drop it. */
+	while (aSubscribers.use_count() > 1)
+	{
+		std::this_thread::yield();
+	}
+	std::atomic_thread_fence(std::memory_order_acquire);
+
+	aSubscribers.reset();
+}
+
+signed int CEventApi::ResolveSignature(EVENT_CONSUME aConsumeEventCallback) const
+{
+	if (this->ResolveOwner == nullptr)
+	{
+		return 0;
+	}
+
+	return this->ResolveOwner((void*)aConsumeEventCallback);
+}
+
+void CEventApi::Dispatch(EventData_t* aEvent, void* aEventData, size_t aSize)
+{
+	aEvent->AmountRaises++;
+
+	if (aEvent->IsStreamed)
+	{
+		CEventStream* stream = this->Stream;
+
+		if (stream)
+		{
+			stream->Write(aEvent->Identifier.c_str(), aEventData, aSize > 0 ? aSize : aEvent->StreamSize.load());
+		}
+	}
+
+	EventSubscriberList_t subscribers = std::atomic_load(&aEvent->Subscribers);
+
+	if (!subscribers)
+	{
+		return;
+	}
+
+	s_DispatchDepth++;
+	for (const EventSubscriber_t& sub : *subscribers)
+	{
+		sub.Callback(aEventData);
+	}
+	s_DispatchDepth--;
+}
+
+void CEventApi::Dispatch(EventData_t* aEvent, signed int aSignature, void* aEventData)
+{
+	aEvent->AmountRaises++;
+
+	EventSubscriberList_t subscribers = std::atomic_load(&aEvent->Subscribers);
+
+	if (!subscribers)
+	{
+		return;
+	}
+
+	s_DispatchDepth++;
+	for (const EventSubscriber_t& sub : *subscribers)
+	{
+		if (sub.Signature == aSignature)
+		{
+			sub.Callback(aEventData);
+			break;
+		}
+	}
+	s_DispatchDepth--;
+}
+
+bool CEventApi::Coalesce(EventData_t* aEvent, const void* aEventData, size_t aSize)
+{
+	EEventCoalescing policy = aEvent->Coalescing;
+
+	if (policy == EEventCoalescing::None)
+	{
+		return false;
+	}
+
+	std::unique_lock<std::mutex> lock(aEvent->CoalesceMutex);
+
+	/* Re-read, the policy might have changed while waiting for the lock. */
+	policy = aEvent->Coalescing;
+
+	switch (policy)
+	{
+		case EEventCoalescing::RateLimit:
+		{
+			long long now = std::chrono::duration_cast<std::chrono::milliseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()
+			).count();
+
+			if (now - aEvent->WindowStart >= 1000)
+			{
+				aEvent->WindowStart = now;
+				aEvent->WindowCount = 0;
+			}
+
+			if (aEvent->WindowCount >= aEvent->Limit)
+			{
+				aEvent->AmountSuppressed++;
+				return true;
+			}
+
+			aEvent->WindowCount++;
+			return false;
+		}
+		case EEventCoalescing::LastValue:
+		{
+			size_t size = aSize > 0 ? aSize : aEvent->PayloadSize;
+
+			/* The payload cannot be copied without knowing its size, deliver it right away. */
+			if (aEventData != nullptr && size == 0)
+			{
+				return false;
+			}
+
+			if (aEventData != nullptr)
+			{
+				const unsigned char* data = static_cast<const unsigned char*>(aEventData);
+				aEvent->Pending.assign(data, data + size);
+				aEvent->HasPendingData = true;
+			}
+			else
+			{
+				aEvent->Pending.clear();
+				aEvent->HasPendingData = false;
+			}
+
+			break;
+		}
+		case EEventCoalescing::Batch:
+		{
+			size_t stride = aEvent->PayloadSize;
+
+			if (aEvent->Limit > 0 && aEvent->PendingCount >= aEvent->Limit)
+			{
+				aEvent->AmountSuppressed++;
+				return true;
+			}
+
+			if (aEvent->PendingCount == 0)
+			{
+				aEvent->Pending.assign(sizeof(EventBatch_t), 0);
+			}
+
+			/* Every item occupies exactly one stride, shorter payloads are zero-padded. */
+			size_t offset = aEvent->Pending.size();
+			aEvent->Pending.resize(offset + stride, 0);
+
+			if (aEventData != nullptr)
+			{
+				size_t size = aSize > 0 ? (std::min)(aSize, stride) : stride;
+				memcpy(aEvent->Pending.data() + offset, aEventData, size);
+			}
+
+			aEvent->PendingCount++;
+			aEvent->HasPendingData = true;
+
+			break;
+		}
+		default:
+			return false;
+	}
+
+	if (aEvent->IsPending)
+	{
+		aEvent->AmountMerged++;
+		return true;
+	}
+
+	aEvent->IsPending = true;
+	lock.unlock();
+
+	/* The delivery itself carries no payload, it picks up whatever is pending when dispatched. */
+	this->Enqueue(aEvent, false, 0, nullptr, 0, policy);
+
+	return true;
+}
+
+void CEventApi::Enqueue(EventData_t* aEvent, bool aIsTargeted, signed int aSignature, const void* aEventData, size_t aSize, EEventCoalescing aCoalescing)
+{
+	DeferredEvent_t* node = nullptr;
+
+	{
+		const std::lock_guard<std::mutex> lock(this->PoolMutex);
+
+		if (!this->Pool.empty())
+		{
+			node = this->Pool.back();
+			this->Pool.pop_back();
+		}
+	}
+
+	if (node == nullptr)
+	{
+		node = new DeferredEvent_t();
+	}
+
+	node->Next.store(nullptr, std::memory_order_relaxed);
+	node->Event      = aEvent;
+	node->IsTargeted = aIsTargeted;
+	node->Signature  = aSignature;
+	node->Coalescing = aCoalescing;
+
+	/* The payload has to be copied, the producer's memory is not guaranteed to be alive on dispatch. */
+	if (aEventData != nullptr && aSize > 0)
+	{
+		const unsigned char* data = static_cast<const unsigned char*>(aEventData);
+		node->HasPayload = true;
+		node->Payload.assign(data, data + aSize);
+	}
+	else
+	{
+		node->HasPayload = false;
+		node->Payload.clear();
+	}
+
+	DeferredEvent_t* prev = this->QueueHead.exchange(node, std::memory_order_acq_rel);
+	prev->Next.store(node, std::memory_order_release);
+
+	this->QueueSize++;
+
+	if (this->IsDispatcherWaiting)
+	{
+		this->DispatcherConVar.notify_one();
+	}
+}
+
+DeferredEvent_t* CEventApi::Dequeue()
+{
+	DeferredEvent_t* tail = this->QueueTail;
+	DeferredEvent_t* next = tail->Next.load(std::memory_order_acquire);
+
+	/* Skip the stub. */
+	if (tail == &this->QueueStub)
+	{
+		if (next == nullptr)
+		{
+			return nullptr;
+		}
+
+		this->QueueTail = next;
+		tail = next;
+		next = next->Next.load(std::memory_order_acquire);
+	}
+
+	if (next != nullptr)
+	{
+		this->QueueTail = next;
+		this->QueueSize--;
+		return tail;
+	}
+
+	/* A producer is in the middle of pushing, pick it up on the next dispatch. */
+	if (tail != this->QueueHead.load(std::memory_order_acquire))
+	{
+		return nullptr;
+	}
+
+	/* Tail is the last node, re-insert the stub so it can be detached. */
+	this->QueueStub.Next.store(nullptr, std::memory_order_relaxed);
+	DeferredEvent_t* prev = this->QueueHead.exchange(&this->QueueStub, std::memory_order_acq_rel);
+	prev->Next.store(&this->QueueStub, std::memory_order_release);
+
+	next = tail->Next.load(std::memory_order_acquire);
+
+	if (next != nullptr)
+	{
+		this->QueueTail = next;
+		this->QueueSize--;
+		return tail;
+	}
+
+	return nullptr;
+}
+
+void CEventApi::DispatchDeferred()
+{
+	const std::lock_guard<std::mutex> lock(this->ConsumerMutex);
+
+	/* Only dispatch what was queued so far, deferred raises from within callbacks wait for the next dispatch. */
+	size_t amount = this->QueueSize;
+
+	for (size_t i = 0; i < amount; i++)
+	{
+		DeferredEvent_t* node = this->Dequeue();
+
+		if (node == nullptr)
+		{
+			break;
+		}
+
+		bool isStale = false;
+
+		if (node->Coalescing != EEventCoalescing::None)
+		{
+			EventData_t* ev = node->Event;
+
+			const std::lock_guard<std::mutex> coalesceLock(ev->CoalesceMutex);
+
+			/* The pending payload was already delivered or dropped by a policy change. */
+			isStale = !ev->IsPending;
+
+			if (!isStale)
+			{
+				/* Swap, so the node's buffer is reused for the next pending payload. */
+				node->Payload.swap(ev->Pending);
+				node->HasPayload = ev->HasPendingData;
+
+				/* Pending data always matches the current policy, SetCoalescing drops it on change. */
+				if (ev->Coalescing == EEventCoalescing::Batch)
+				{
+					EventBatch_t* batch = reinterpret_cast<EventBatch_t*>(node->Payload.data());
+					batch->Count  = ev->PendingCount;
+					batch->Stride = static_cast<uint32_t>(ev->PayloadSize);
+				}
+
+				ev->IsPending      = false;
+				ev->HasPendingData = false;
+				ev->PendingCount   = 0;
+				ev->Pending.clear();
+			}
+		}
+
+		if (!isStale)
+		{
+			void* data = node->HasPayload ? node->Payload.data() : nullptr;
+
+			if (node->IsTargeted)
+			{
+				this->Dispatch(node->Event, node->Signature, data);
+			}
+			else
+			{
+				this->Dispatch(node->Event, data, node->Payload.size());
+			}
+		}
+
+		if (node->Payload.capacity() > s_DeferredPoolMaxPayload)
+		{
+			delete node;
+			continue;
+		}
+
+		const std::lock_guard<std::mutex> poolLock(this->PoolMutex);
+
+		if (this->Pool.size() < s_DeferredPoolCapacity)
+		{
+			this->Pool.push_back(node);
+		}
+		else
+		{
+			delete node;
+		}
+	}
+}
+
+void CEventApi::ProcessDispatcher()
+{
+	while (this->IsDispatcherRunning)
+	{
+		this->DispatchDeferred();
+
+		std::unique_lock<std::mutex> lock(this->DispatcherMutex);
+
+		this->IsDispatcherWaiting = true;
+		this->DispatcherConVar.wait_for(lock, std::chrono::milliseconds(10), [this]
+		{
+			return !this->IsDispatcherRunning || this->QueueSize > 0;
+		});
+		this->IsDispatcherWaiting = false;
+	}
 }
@@ -9,23 +9,45 @@
 #ifndef EVTAPI_H
 #define EVTAPI_H
 
+#include <condition_variable>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
 #include "EvtFuncDefs.h"
 #include "EvtData.h"
+#include "EvtDeferred.h"
+#include "EvtEnum.h"
+#include "EvtPattern.h"
 #include "EvtSubscriber.h"
 
 constexpr const char* CH_EVENTS = "Events";
 
+/* Returns the signature of the addon owning the address or 0. */
+typedef signed int (*EVENTS_RESOLVEOWNER)(void* aAddress);
+
+class CEventStream;
+
 ///----------------------------------------------------------------------------------------------------
 /// CEventApi Class
 ///----------------------------------------------------------------------------------------------------
 class CEventApi
 {
 	public:
+	///----------------------------------------------------------------------------------------------------
+	/// ctor
+	/// 	aResolveOwner attributes subscriptions to addons, without it all subscribers have signature 0.
+	///----------------------------------------------------------------------------------------------------
+	CEventApi(EEventDeferMode aDeferMode = EEventDeferMode::Frame, EVENTS_RESOLVEOWNER aResolveOwner = nullptr);
+
+	///----------------------------------------------------------------------------------------------------
+	/// dtor
+	///----------------------------------------------------------------------------------------------------
+	~CEventApi();
+
 	///----------------------------------------------------------------------------------------------------
 	/// Raise:
 	/// 	Raises an event of provided name, passing a pointer to the payload.
@@ -41,18 +63,122 @@ class CEventApi
 	///----------------------------------------------------------------------------------------------------
 	/// Subscribe:
 	/// 	Subscribes the provided ConsumeEventCallback function, to the provided event name.
+	/// 	A name ending with '*', such as "EV_ARCDPS_*", subscribes to every event starting with it,
+	/// 	including events that do not exist yet.
 	///----------------------------------------------------------------------------------------------------
 	void Subscribe(const char* aIdentifier, EVENT_CONSUME aConsumeEventCallback);
 
 	///----------------------------------------------------------------------------------------------------
 	/// Unsubscribe:
-	/// 	Unsubscribes the provided ConsumeEventCallback function from the provided event name.
+	/// 	Unsubscribes the provided ConsumeEventCallback function from the provided event name or pattern.
+	/// 	Returns only once no raise is dispatching to the callback anymore.
+	/// 	Except when called from within an event callback: it does not wait then, as it would wait on its own raise,
+	/// 	so raises on other threads may still be dispatching to it.
 	///----------------------------------------------------------------------------------------------------
 	void Unsubscribe(const char* aIdentifier, EVENT_CONSUME aConsumeEventCallback);
 
+	///----------------------------------------------------------------------------------------------------
+	/// GetHandle:
+	/// 	Interns the provided event name and returns a handle to it, that stays valid for the lifetime
+	/// 	of the CEventApi. Returns nullptr if no identifier is passed.
+	///----------------------------------------------------------------------------------------------------
+	EventHandle GetHandle(const char* aIdentifier);
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetIdentifier:
+	/// 	Returns the event name of the provided handle or nullptr.
+	///----------------------------------------------------------------------------------------------------
+	const char* GetIdentifier(EventHandle aHandle) const;
+
+	///----------------------------------------------------------------------------------------------------
+	/// RaiseByHandle:
+	/// 	Raises the event of the provided handle, passing a pointer to the payload.
+	///----------------------------------------------------------------------------------------------------
+	void RaiseByHandle(EventHandle aHandle, void* aEventData = nullptr);
+
+	///----------------------------------------------------------------------------------------------------
+	/// RaiseByHandle:
+	/// 	Raises the event of the provided handle with a payload meant for only a specific subscriber.
+	///----------------------------------------------------------------------------------------------------
+	void RaiseByHandle(signed int aSignature, EventHandle aHandle, void* aEventData = nullptr);
+
+	///----------------------------------------------------------------------------------------------------
+	/// SubscribeByHandle:
+	/// 	Subscribes the provided ConsumeEventCallback function, to the event of the provided handle.
+	///----------------------------------------------------------------------------------------------------
+	void SubscribeByHandle(EventHandle aHandle, EVENT_CONSUME aConsumeEventCallback);
+
+	///----------------------------------------------------------------------------------------------------
+	/// UnsubscribeByHandle:
+	/// 	Unsubscribes the provided ConsumeEventCallback function from the event of the provided handle.
+	/// 	Returns only once no raise is dispatching to the callback anymore.
+	/// 	Except when called from within an event callback: it does not wait then, as it would wait on its own raise,
+	/// 	so raises on other threads may still be dispatching to it.
+	///----------------------------------------------------------------------------------------------------
+	void UnsubscribeByHandle(EventHandle aHandle, EVENT_CONSUME aConsumeEventCallback);
+
+	///----------------------------------------------------------------------------------------------------
+	/// RaiseDeferred:
+	/// 	Copies the payload and queues the event of provided name to be dispatched later.
+	/// 	Subscribers receive a pointer to the copy, only valid for the duration of the callback.
+	///----------------------------------------------------------------------------------------------------
+	void RaiseDeferred(const char* aIdentifier, const void* aEventData = nullptr, size_t aSize = 0);
+
+	///----------------------------------------------------------------------------------------------------
+	/// RaiseDeferredByHandle:
+	/// 	Copies the payload and queues the event of the provided handle to be dispatched later.
+	///----------------------------------------------------------------------------------------------------
+	void RaiseDeferredByHandle(EventHandle aHandle, const void* aEventData = nullptr, size_t aSize = 0);
+
+	///----------------------------------------------------------------------------------------------------
+	/// RaiseDeferredByHandle:
+	/// 	Copies the payload and queues the event of the provided handle to be dispatched later,
+	/// 	meant for only a specific subscriber.
+	///----------------------------------------------------------------------------------------------------
+	void RaiseDeferredByHandle(signed int aSignature, EventHandle aHandle, const void* aEventData = nullptr, size_t aSize = 0);
+
+	///----------------------------------------------------------------------------------------------------
+	/// SetCoalescing:
+	/// 	Sets how raises of the event of the provided handle are delivered.
+	/// 	aLimit is the amount of deliveries per second for RateLimit or the maximum batch size for Batch.
+	/// 	aPayloadSize is the size of the payload for raises that do not pass one, required for Batch.
+	/// 	Returns false if the parameters are invalid for the policy.
+	///----------------------------------------------------------------------------------------------------
+	bool SetCoalescing(EventHandle aHandle, EEventCoalescing aPolicy, unsigned aLimit = 0, size_t aPayloadSize = 0);
+
+	///----------------------------------------------------------------------------------------------------
+	/// SetCoalescing:
+	/// 	Sets how raises of the event of provided name are delivered.
+	///----------------------------------------------------------------------------------------------------
+	bool SetCoalescing(const char* aIdentifier, EEventCoalescing aPolicy, unsigned aLimit = 0, size_t aPayloadSize = 0);
+
+	///----------------------------------------------------------------------------------------------------
+	/// SetStream:
+	/// 	Sets the event stream raises of streamed events are mirrored into.
+	/// 	The stream has to outlive the CEventApi.
+	///----------------------------------------------------------------------------------------------------
+	void SetStream(CEventStream* aStream);
+
+	///----------------------------------------------------------------------------------------------------
+	/// SetStreamed:
+	/// 	Sets whether raises of the event of provided name are mirrored into the event stream.
+	/// 	aPayloadSize is the size of the payload for raises that do not pass one.
+	///----------------------------------------------------------------------------------------------------
+	void SetStreamed(const char* aIdentifier, bool aIsStreamed, size_t aPayloadSize = 0);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Flush:
+	/// 	Dispatches all queued deferred events in the order they were raised.
+	/// 	Does nothing, if deferred events are dispatched by the dispatcher thread.
+	///----------------------------------------------------------------------------------------------------
+	void Flush();
+
 	///----------------------------------------------------------------------------------------------------
 	/// Verify:
 	/// 	Removes any elements within the provided address space from the Registry.
+	/// 	Returns only once no raise is dispatching to the removed callbacks anymore.
+	/// 	Except when called from within an event callback: it does not wait then, as it would wait on its own raise,
+	/// 	so raises on other threads may still be dispatching to them.
 	///----------------------------------------------------------------------------------------------------
 	int Verify(void* aStartAddress, void* aEndAddress);
 
@@ -60,11 +186,146 @@ class CEventApi
 	/// GetRegistry:
 	/// 	Returns a copy of the registry.
 	///----------------------------------------------------------------------------------------------------
-	std::unordered_map<std::string, EventData_t> GetRegistry() const;
+	std::unordered_map<std::string, EventInfo_t> GetRegistry() const;
 
 	private:
-	mutable std::recursive_mutex               Mutex;
-	std::unordered_map<std::string, EventData_t> Registry;
+	mutable std::shared_mutex                     Mutex;      /* Guards the Registry layout, never held while dispatching. */
+	std::mutex                                    WriteMutex; /* Serializes subscriber list replacements.               */
+	std::unordered_map<std::string, EventData_t*> Registry;   /* Entries are never erased, pointers stay valid.         */
+
+	EventPatternNode_t                            PatternRoot;      /* Guarded by the WriteMutex.                    */
+	std::atomic<size_t>                           PatternCount = 0; /* Amount of active pattern subscriptions.       */
+
+	EVENTS_RESOLVEOWNER                           ResolveOwner = nullptr;
+
+	EEventDeferMode                               DeferMode;
+	std::atomic<DeferredEvent_t*>                 QueueHead;  /* Producers push here.                                   */
+	DeferredEvent_t*                              QueueTail;  /* Consumer pops here, guarded by the ConsumerMutex.      */
+	DeferredEvent_t                               QueueStub;
+	std::atomic<size_t>                           QueueSize = 0;
+	std::mutex                                    ConsumerMutex;
+
+	std::mutex                                    PoolMutex;
+	std::vector<DeferredEvent_t*>                 Pool;
+
+	std::atomic<CEventStream*>                    Stream = nullptr;
+
+	std::thread                                   DispatcherThread;
+	std::atomic<bool>                             IsDispatcherRunning = false;
+	std::atomic<bool>                             IsDispatcherWaiting = false;
+	std::mutex                                    DispatcherMutex;
+	std::condition_variable                       DispatcherConVar;
+
+	///----------------------------------------------------------------------------------------------------
+	/// Find:
+	/// 	Returns the event with the given identifier or nullptr.
+	///----------------------------------------------------------------------------------------------------
+	EventData_t* Find(const char* aIdentifier) const;
+
+	///----------------------------------------------------------------------------------------------------
+	/// FindOrCreate:
+	/// 	Returns the event with the given identifier, creates it if it does not exist yet.
+	///----------------------------------------------------------------------------------------------------
+	EventData_t* FindOrCreate(const char* aIdentifier);
+
+	///----------------------------------------------------------------------------------------------------
+	/// FindOrCreateRaised:
+	/// 	Returns the event with the given identifier. Only creates it, if a pattern might match it.
+	///----------------------------------------------------------------------------------------------------
+	EventData_t* FindOrCreateRaised(const char* aIdentifier);
+
+	///----------------------------------------------------------------------------------------------------
+	/// SubscribePattern:
+	/// 	Subscribes the callback to all current and future events starting with the prefix.
+	///----------------------------------------------------------------------------------------------------
+	void SubscribePattern(const std::string& aPrefix, EVENT_CONSUME aConsumeEventCallback);
+
+	///----------------------------------------------------------------------------------------------------
+	/// UnsubscribePattern:
+	/// 	Unsubscribes the callback from the pattern and all events it was resolved to.
+	///----------------------------------------------------------------------------------------------------
+	void UnsubscribePattern(const std::string& aPrefix, EVENT_CONSUME aConsumeEventCallback);
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetPatternNode:
+	/// 	Returns the trie node of the prefix, creates it and its parents if aCreate is set.
+	/// 	Must be called with the WriteMutex held.
+	///----------------------------------------------------------------------------------------------------
+	EventPatternNode_t* GetPatternNode(const std::string& aPrefix, bool aCreate);
+
+	///----------------------------------------------------------------------------------------------------
+	/// CollectEvents:
+	/// 	Appends all events of the node and its children.
+	///----------------------------------------------------------------------------------------------------
+	static void CollectEvents(const EventPatternNode_t* aNode, std::vector<EventData_t*>& aEvents);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Publish:
+	/// 	Replaces the subscriber list of an event and returns the previous one.
+	/// 	Must be called with the WriteMutex held.
+	///----------------------------------------------------------------------------------------------------
+	EventSubscriberList_t Publish(EventData_t* aEvent, std::vector<EventSubscriber_t>&& aSubscribers);
+
+	///----------------------------------------------------------------------------------------------------
+	/// WaitForReaders:
+	/// 	Blocks until no raise is dispatching from the provided, already replaced, subscriber list.
+	/// 	Returns right away on a thread that is dispatching a raise itself.
+	/// 	Must not be called with the WriteMutex held.
+	///----------------------------------------------------------------------------------------------------
+	static void WaitForReaders(EventSubscriberList_t& aSubscribers);
+
+	///----------------------------------------------------------------------------------------------------
+	/// ResolveSignature:
+	/// 	Returns the signature of the addon owning the provided callback or 0.
+	///----------------------------------------------------------------------------------------------------
+	signed int ResolveSignature(EVENT_CONSUME aConsumeEventCallback) const;
+
+	///----------------------------------------------------------------------------------------------------
+	/// Dispatch:
+	/// 	Invokes all subscribers of the event.
+	/// 	aSize is only used for the event stream, if 0 the StreamSize of the event is used.
+	///----------------------------------------------------------------------------------------------------
+	void Dispatch(EventData_t* aEvent, void* aEventData, size_t aSize = 0);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Dispatch:
+	/// 	Invokes the subscriber with the provided signature.
+	///----------------------------------------------------------------------------------------------------
+	void Dispatch(EventData_t* aEvent, signed int aSignature, void* aEventData);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Coalesce:
+	/// 	Applies the coalescing policy of the event to a raise.
+	/// 	If aSize is 0, the PayloadSize of the event is used.
+	/// 	Returns true if the raise was consumed, false if it should be delivered as is.
+	///----------------------------------------------------------------------------------------------------
+	bool Coalesce(EventData_t* aEvent, const void* aEventData, size_t aSize);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Enqueue:
+	/// 	Takes a node from the pool, copies the payload and pushes it to the deferred queue.
+	/// 	Nodes with a coalescing policy deliver the pending payload of the event instead.
+	///----------------------------------------------------------------------------------------------------
+	void Enqueue(EventData_t* aEvent, bool aIsTargeted, signed int aSignature, const void* aEventData, size_t aSize, EEventCoalescing aCoalescing = EEventCoalescing::None);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Dequeue:
+	/// 	Pops the oldest node from the deferred queue or returns nullptr.
+	/// 	Must be called with the ConsumerMutex held.
+	///----------------------------------------------------------------------------------------------------
+	DeferredEvent_t* Dequeue();
+
+	///----------------------------------------------------------------------------------------------------
+	/// DispatchDeferred:
+	/// 	Dispatches all queued deferred events.
+	///----------------------------------------------------------------------------------------------------
+	void DispatchDeferred();
+
+	///----------------------------------------------------------------------------------------------------
+	/// ProcessDispatcher:
+	/// 	Thread function of the dispatcher thread.
+	///----------------------------------------------------------------------------------------------------
+	void ProcessDispatcher();
 };
 
 #endif
@@ -0,0 +1,25 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  EvtBatch.h
+/// Description  :  Contains the EventBatch_t struct definition.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef EVTBATCH_H
+#define EVTBATCH_H
+
+#include <cstdint>
+
+///----------------------------------------------------------------------------------------------------
+/// EventBatch_t Struct
+/// 	Payload of events with the EEventCoalescing::Batch policy.
+/// 	Followed by Count payloads of Stride bytes each, in the order they were raised.
+///----------------------------------------------------------------------------------------------------
+struct EventBatch_t
+{
+	uint32_t Count;
+	uint32_t Stride;
+};
+
+#endif
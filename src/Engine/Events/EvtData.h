@@ -9,17 +9,63 @@
 #ifndef EVTDATA_H
 #define EVTDATA_H
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
+#include "EvtEnum.h"
 #include "EvtSubscriber.h"
 
+///----------------------------------------------------------------------------------------------------
+/// EventSubscriberList_t:
+/// 	Immutable snapshot of the subscribers of an event.
+/// 	Only ever replaced as a whole, never modified in place.
+///----------------------------------------------------------------------------------------------------
+typedef std::shared_ptr<const std::vector<EventSubscriber_t>> EventSubscriberList_t;
+
 ///----------------------------------------------------------------------------------------------------
 /// EventData_t Struct
 ///----------------------------------------------------------------------------------------------------
 struct EventData_t
+{
+	std::string                     Identifier;       /* The interned name of the event.                     */
+	EventSubscriberList_t           Subscribers;      /* Access only via std::atomic_load/std::atomic_store. */
+	std::atomic<unsigned long long> AmountRaises = 0;
+
+	/* Coalescing */
+	std::atomic<EEventCoalescing>   Coalescing       = EEventCoalescing::None;
+	std::atomic<unsigned long long> AmountMerged     = 0;     /* Raises folded into another delivery.            */
+	std::atomic<unsigned long long> AmountSuppressed = 0;     /* Raises dropped by the policy.                   */
+
+	std::mutex                      CoalesceMutex;            /* Guards the fields below.                        */
+	unsigned                        Limit            = 0;     /* Deliveries per second or maximum batch size.    */
+	size_t                          PayloadSize      = 0;     /* Size to copy for raises that do not pass one.   */
+	long long                       WindowStart      = 0;
+	unsigned                        WindowCount      = 0;
+	bool                            IsPending        = false; /* A delivery for the pending payload is queued.   */
+	bool                            HasPendingData   = false;
+	uint32_t                        PendingCount     = 0;
+	std::vector<unsigned char>      Pending;
+
+	/* Streaming */
+	std::atomic<bool>               IsStreamed       = false; /* Mirrored into the event stream.                 */
+	std::atomic<size_t>             StreamSize       = 0;     /* Payload size of raises that do not pass one.    */
+};
+
+///----------------------------------------------------------------------------------------------------
+/// EventInfo_t Struct
+/// 	Copyable point-in-time view of an EventData_t.
+///----------------------------------------------------------------------------------------------------
+struct EventInfo_t
 {
 	std::vector<EventSubscriber_t> Subscribers;
-	unsigned long long             AmountRaises = 0;
+	unsigned long long             AmountRaises     = 0;
+	EEventCoalescing               Coalescing       = EEventCoalescing::None;
+	unsigned long long             AmountMerged     = 0;
+	unsigned long long             AmountSuppressed = 0;
+	bool                           IsStreamed       = false;
 };
 
 #endif
@@ -0,0 +1,33 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  EvtDeferred.h
+/// Description  :  Contains the DeferredEvent_t struct definition.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef EVTDEFERRED_H
+#define EVTDEFERRED_H
+
+#include <atomic>
+#include <vector>
+
+#include "EvtData.h"
+#include "EvtEnum.h"
+
+///----------------------------------------------------------------------------------------------------
+/// DeferredEvent_t Struct
+/// 	Node of the deferred event queue. Nodes are pooled and keep their payload capacity.
+///----------------------------------------------------------------------------------------------------
+struct DeferredEvent_t
+{
+	std::atomic<DeferredEvent_t*> Next         = nullptr;
+	EventData_t*                  Event        = nullptr;
+	bool                          IsTargeted   = false;
+	signed int                    Signature    = 0;       /* Only used if IsTargeted.           */
+	bool                          HasPayload   = false;   /* False if raised without a payload. */
+	std::vector<unsigned char>    Payload;
+	EEventCoalescing              Coalescing   = EEventCoalescing::None; /* Delivers the pending payload of the event instead. */
+};
+
+#endif
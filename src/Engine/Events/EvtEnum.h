@@ -0,0 +1,34 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  EvtEnum.h
+/// Description  :  Enumerations for events.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef EVTENUM_H
+#define EVTENUM_H
+
+#include <cstdint>
+
+///----------------------------------------------------------------------------------------------------
+/// EEventDeferMode Enumeration
+///----------------------------------------------------------------------------------------------------
+enum class EEventDeferMode : uint32_t
+{
+	Frame,  /* Deferred events are dispatched on the render thread, before the pre-render callbacks. */
+	Thread  /* Deferred events are dispatched on a dedicated dispatcher thread.                       */
+};
+
+///----------------------------------------------------------------------------------------------------
+/// EEventCoalescing Enumeration
+///----------------------------------------------------------------------------------------------------
+enum class EEventCoalescing : uint32_t
+{
+	None,      /* Every raise is delivered.                                                      */
+	LastValue, /* Raises are deferred, only the latest payload is delivered on the next dispatch. */
+	RateLimit, /* At most Limit raises are delivered per second, the rest is dropped.            */
+	Batch      /* Raises are deferred and delivered as one EventBatch_t on the next dispatch.    */
+};
+
+#endif
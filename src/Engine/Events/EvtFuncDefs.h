@@ -9,11 +9,28 @@
 #ifndef EVTFUNCDEFS_H
 #define EVTFUNCDEFS_H
 
-typedef void (*EVENT_CONSUME)                    (void* aEventArgs);
-typedef void (*EVENTS_RAISE)                     (const char* aIdentifier, void* aEventData);
-typedef void (*EVENTS_RAISENOTIFICATION)         (const char* aIdentifier);
-typedef void (*EVENTS_RAISE_TARGETED)            (signed int aSignature, const char* aIdentifier, void* aEventData);
-typedef void (*EVENTS_RAISENOTIFICATION_TARGETED)(signed int aSignature, const char* aIdentifier);
-typedef void (*EVENTS_SUBSCRIBE)                 (const char* aIdentifier, EVENT_CONSUME aConsumeEventCallback);
+#include <cstddef>
+
+#include "EvtBatch.h"
+#include "EvtEnum.h"
+
+/* Opaque handle to an interned event identifier. Obtained once, valid until Nexus shuts down. */
+typedef void* EventHandle;
+
+typedef void (*EVENT_CONSUME)                           (void* aEventArgs);
+typedef void (*EVENTS_RAISE)                            (const char* aIdentifier, void* aEventData);
+typedef void (*EVENTS_RAISENOTIFICATION)                (const char* aIdentifier);
+typedef void (*EVENTS_RAISE_TARGETED)                   (signed int aSignature, const char* aIdentifier, void* aEventData);
+typedef void (*EVENTS_RAISENOTIFICATION_TARGETED)       (signed int aSignature, const char* aIdentifier);
+typedef void (*EVENTS_SUBSCRIBE)                        (const char* aIdentifier, EVENT_CONSUME aConsumeEventCallback);
+typedef EventHandle (*EVENTS_GETHANDLE)                 (const char* aIdentifier);
+typedef void (*EVENTS_RAISE_HANDLE)                     (EventHandle aHandle, void* aEventData);
+typedef void (*EVENTS_RAISENOTIFICATION_HANDLE)         (EventHandle aHandle);
+typedef void (*EVENTS_RAISE_TARGETED_HANDLE)            (signed int aSignature, EventHandle aHandle, void* aEventData);
+typedef void (*EVENTS_RAISENOTIFICATION_TARGETED_HANDLE)(signed int aSignature, EventHandle aHandle);
+typedef void (*EVENTS_SUBSCRIBE_HANDLE)                 (EventHandle aHandle, EVENT_CONSUME aConsumeEventCallback);
+typedef void (*EVENTS_RAISE_DEFERRED)                   (const char* aIdentifier, const void* aEventData, size_t aSize);
+typedef void (*EVENTS_RAISE_DEFERRED_HANDLE)            (EventHandle aHandle, const void* aEventData, size_t aSize);
+typedef bool (*EVENTS_SETCOALESCING)                    (const char* aIdentifier, EEventCoalescing aPolicy, unsigned aLimit, size_t aPayloadSize);
 
 #endif
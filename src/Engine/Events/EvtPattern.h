@@ -0,0 +1,33 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  EvtPattern.h
+/// Description  :  Contains the EventPatternNode_t struct definition.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef EVTPATTERN_H
+#define EVTPATTERN_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "EvtData.h"
+#include "EvtSubscriber.h"
+
+///----------------------------------------------------------------------------------------------------
+/// EventPatternNode_t Struct
+/// 	Node of the prefix trie resolving pattern subscriptions such as "EV_ARCDPS_*".
+/// 	Nodes are never removed before the CEventApi is destroyed.
+///----------------------------------------------------------------------------------------------------
+struct EventPatternNode_t
+{
+	std::string                                                  Prefix;      /* Identifier prefix this node matches. */
+	std::unordered_map<char, std::unique_ptr<EventPatternNode_t>> Children;
+	std::vector<EventSubscriber_t>                               Subscribers; /* Subscribed to Prefix + "*".          */
+	std::vector<EventData_t*>                                    Events;      /* Events with exactly this identifier. */
+};
+
+#endif
@@ -0,0 +1,132 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  EvtStream.cpp
+/// Description  :  Mirrors events into a shared memory ring buffer for external tools.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include "EvtStream.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <cstring>
+
+#include "EvtApi.h"
+#include "Util/Platform.h"
+
+/* Records are padded to this alignment, so headers never straddle the end of the buffer. */
+constexpr size_t s_RecordAlignment = 8;
+
+CEventStream::CEventStream(CDataLinkApi* aDataLink, CLogApi* aLogger, size_t aCapacity)
+{
+	assert(aDataLink);
+	assert(aLogger);
+
+	this->DataLink = aDataLink;
+	this->Logger   = aLogger;
+	this->Capacity = aCapacity - (aCapacity % s_RecordAlignment);
+}
+
+bool CEventStream::Initialize()
+{
+	if (this->Header)
+	{
+		return true;
+	}
+
+	void* resource = this->DataLink->ShareResource(DL_EVENT_STREAM, sizeof(EventStreamHeader_t) + this->Capacity, "", true);
+
+	if (!resource)
+	{
+		this->Logger->Warning(CH_EVENTS, "Failed to create event stream.");
+		return false;
+	}
+
+	EventStreamHeader_t* header = static_cast<EventStreamHeader_t*>(resource);
+	header->HeaderSize = sizeof(EventStreamHeader_t);
+	header->Capacity   = this->Capacity;
+	header->Frequency  = Platform::GetPerformanceFrequency();
+	header->Dropped.store(0, std::memory_order_relaxed);
+	header->Head.store(0, std::memory_order_relaxed);
+	header->Tail.store(0, std::memory_order_relaxed);
+
+	/* Publish the version last, readers treat 0 as not yet initialized. */
+	std::atomic_thread_fence(std::memory_order_release);
+	header->Version = EVENT_STREAM_VERSION;
+
+	this->Records = static_cast<unsigned char*>(resource) + sizeof(EventStreamHeader_t);
+	this->Header  = header;
+
+	return true;
+}
+
+void CEventStream::Write(const char* aIdentifier, const void* aEventData, size_t aSize)
+{
+	if (!this->Header) { return; }
+
+	if (aEventData == nullptr) { aSize = 0; }
+
+	size_t size = sizeof(EventStreamRecord_t) + aSize;
+	size = (size + s_RecordAlignment - 1) & ~(s_RecordAlignment - 1);
+
+	/* Never let a single record take more than a quarter of the buffer. */
+	if (size > this->Capacity / 4)
+	{
+		this->Header->Dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	int64_t timestamp = Platform::GetPerformanceCounter();
+
+	const std::lock_guard<std::mutex> lock(this->Mutex);
+
+	uint64_t head = this->Header->Head.load(std::memory_order_relaxed);
+	uint64_t tail = this->Header->Tail.load(std::memory_order_relaxed);
+
+	/* Records are never split, skip the remainder of the buffer if it does not fit. */
+	size_t   offset  = head % this->Capacity;
+	uint64_t padding = (this->Capacity - offset) < size ? this->Capacity - offset : 0;
+	uint64_t end     = head + padding + size;
+
+	/* Release the oldest records, before any of their bytes are overwritten. */
+	if (end - tail > this->Capacity)
+	{
+		while (end - tail > this->Capacity)
+		{
+			size_t   tailOffset = tail % this->Capacity;
+			uint32_t recordSize = reinterpret_cast<EventStreamRecord_t*>(this->Records + tailOffset)->Size;
+
+			tail += recordSize != 0 ? recordSize : this->Capacity - tailOffset;
+		}
+
+		this->Header->Tail.store(tail, std::memory_order_release);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+	}
+
+	if (padding > 0)
+	{
+		/* A zero size tells readers to wrap around. */
+		uint32_t wrap = 0;
+		memcpy(this->Records + offset, &wrap, sizeof(uint32_t));
+		offset = 0;
+	}
+
+	EventStreamRecord_t* record = reinterpret_cast<EventStreamRecord_t*>(this->Records + offset);
+	record->Size        = static_cast<uint32_t>(size);
+	record->PayloadSize = static_cast<uint32_t>(aSize);
+	record->Sequence    = this->Sequence++;
+	record->Timestamp   = timestamp;
+
+	/* Truncate, but always terminate. */
+	size_t length = (std::min)(strlen(aIdentifier), sizeof(record->Identifier) - 1);
+	memcpy(record->Identifier, aIdentifier, length);
+	record->Identifier[length] = '\0';
+
+	if (aSize > 0)
+	{
+		memcpy(record + 1, aEventData, aSize);
+	}
+
+	this->Header->Head.store(end, std::memory_order_release);
+}
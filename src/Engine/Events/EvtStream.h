@@ -0,0 +1,58 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  EvtStream.h
+/// Description  :  Mirrors events into a shared memory ring buffer for external tools.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef EVTSTREAM_H
+#define EVTSTREAM_H
+
+#include <mutex>
+
+#include "EvtStreamData.h"
+#include "Engine/DataLink/DlApi.h"
+#include "Engine/Logging/LogApi.h"
+
+///----------------------------------------------------------------------------------------------------
+/// CEventStream Class
+///----------------------------------------------------------------------------------------------------
+class CEventStream
+{
+	public:
+	///----------------------------------------------------------------------------------------------------
+	/// ctor
+	///----------------------------------------------------------------------------------------------------
+	CEventStream(CDataLinkApi* aDataLink, CLogApi* aLogger, size_t aCapacity = 1024 * 1024);
+
+	///----------------------------------------------------------------------------------------------------
+	/// dtor
+	///----------------------------------------------------------------------------------------------------
+	~CEventStream() = default;
+
+	///----------------------------------------------------------------------------------------------------
+	/// Initialize:
+	/// 	Creates the public DL_EVENT_STREAM resource. Returns false on failure.
+	///----------------------------------------------------------------------------------------------------
+	bool Initialize();
+
+	///----------------------------------------------------------------------------------------------------
+	/// Write:
+	/// 	Appends a record for the raise, overwriting the oldest records if the buffer is full.
+	///----------------------------------------------------------------------------------------------------
+	void Write(const char* aIdentifier, const void* aEventData, size_t aSize);
+
+	private:
+	CDataLinkApi*        DataLink = nullptr;
+	CLogApi*             Logger   = nullptr;
+
+	size_t               Capacity;
+	EventStreamHeader_t* Header   = nullptr;
+	unsigned char*       Records  = nullptr;
+
+	std::mutex           Mutex;        /* Serializes raising threads, the ring itself has a single producer. */
+	uint64_t             Sequence = 0;
+};
+
+#endif
@@ -0,0 +1,58 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  EvtStreamData.h
+/// Description  :  Shared memory layout of the event stream.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef EVTSTREAMDATA_H
+#define EVTSTREAMDATA_H
+
+#include <atomic>
+#include <cstdint>
+
+constexpr const char* DL_EVENT_STREAM      = "DL_EVENT_STREAM";
+constexpr uint32_t    EVENT_STREAM_VERSION = 1;
+
+///----------------------------------------------------------------------------------------------------
+/// EventStreamHeader_t Struct
+/// 	Start of the public DL_EVENT_STREAM resource, followed by Capacity bytes of records.
+/// 	Head and Tail are monotonic byte positions, the record offset is (Position % Capacity).
+///
+/// 	Readers keep their own cursor, starting at Tail, and read without any synchronization:
+/// 		1. Load Head (acquire). If the cursor equals Head, there is nothing new.
+/// 		2. Copy the record at the cursor. A Size of 0 means the rest of the buffer is unused,
+/// 		   continue at the next multiple of Capacity.
+/// 		3. Load Tail (acquire). If it passed the cursor, the copy was overwritten while reading,
+/// 		   discard it and continue at Tail.
+///----------------------------------------------------------------------------------------------------
+struct EventStreamHeader_t
+{
+	uint32_t                           Version;
+	uint32_t                           HeaderSize;   /* Offset of the first record from the header.  */
+	uint64_t                           Capacity;     /* Size of the record area in bytes.            */
+	int64_t                            Frequency;    /* Ticks per second of the record timestamps.   */
+	std::atomic<uint64_t>              Dropped;      /* Raises too large to fit into the buffer.     */
+
+	alignas(64) std::atomic<uint64_t>  Head;         /* End of the last completely written record.   */
+	alignas(64) std::atomic<uint64_t>  Tail;         /* Start of the oldest record not overwritten.  */
+};
+
+///----------------------------------------------------------------------------------------------------
+/// EventStreamRecord_t Struct
+/// 	Header of a single mirrored raise, followed by PayloadSize bytes of payload.
+///----------------------------------------------------------------------------------------------------
+struct EventStreamRecord_t
+{
+	uint32_t Size;                                   /* Size including this header, multiple of 8.   */
+	uint32_t PayloadSize;
+	uint64_t Sequence;
+	int64_t  Timestamp;                              /* Ticks of the high resolution counter.        */
+	char     Identifier[48];                         /* Null-terminated, truncated if longer.        */
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Event stream cursors must be lock-free to be shared across processes.");
+static_assert(sizeof(EventStreamRecord_t) % 8 == 0, "Event stream records must stay 8 byte aligned.");
+
+#endif
@@ -11,13 +11,16 @@
 
 #include "EvtFuncDefs.h"
 
+struct EventPatternNode_t;
+
 ///----------------------------------------------------------------------------------------------------
 /// EventSubscriber_t Struct
 ///----------------------------------------------------------------------------------------------------
 struct EventSubscriber_t
 {
-	signed int    Signature;
-	EVENT_CONSUME Callback;
+	signed int                Signature;
+	EVENT_CONSUME             Callback;
+	const EventPatternNode_t* Pattern;   /* Set if subscribed through a pattern, otherwise nullptr. */
 };
 
 inline bool operator==(const EventSubscriber_t& lhs, const EventSubscriber_t& rhs)
@@ -9,15 +9,21 @@
 #ifndef FNENTRY_H
 #define FNENTRY_H
 
+#include <atomic>
 #include <cstdint>
 
+constexpr uint32_t FN_SLOTS_PER_PAGE = 256;
+constexpr uint32_t FN_MAX_PAGES      = 64;
+
 ///----------------------------------------------------------------------------------------------------
 /// FuncEntry_t Struct
+/// 	Slot of the function registry. Read without a lock, a handle is valid while its generation matches.
 ///----------------------------------------------------------------------------------------------------
 struct FuncEntry_t
 {
-	int32_t RefCount;
-	void*   Function;
+	std::atomic<uint32_t> Generation = 0;       /* Incremented, when the function is deregistered. */
+	std::atomic<int32_t>  RefCount   = 0;       /* Callers between Query and Release. */
+	std::atomic<void*>    Function   = nullptr;
 };
 
 #endif
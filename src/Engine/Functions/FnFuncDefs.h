@@ -0,0 +1,23 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  FnFuncDefs.h
+/// Description  :  Contains the function definitions for the function registry.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef FNFUNCDEFS_H
+#define FNFUNCDEFS_H
+
+#include <cstdint>
+
+/* Generation in the upper, slot index + 1 in the lower 32 bits. 0 is invalid, deregistering invalidates the handle. */
+typedef uint64_t FunctionHandle;
+
+typedef FunctionHandle (*FUNCTIONS_REGISTER)  (const char* aIdentifier, void* aFunction);
+typedef void           (*FUNCTIONS_DEREGISTER)(FunctionHandle aHandle);
+typedef FunctionHandle (*FUNCTIONS_GETHANDLE) (const char* aIdentifier);
+typedef void*          (*FUNCTIONS_QUERY)     (FunctionHandle aHandle);
+typedef void           (*FUNCTIONS_RELEASE)   (FunctionHandle aHandle);
+
+#endif
@@ -0,0 +1,43 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  FnProfile.h
+/// Description  :  Contains the call statistics of instrumented functions.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef FNPROFILE_H
+#define FNPROFILE_H
+
+#include <atomic>
+#include <cstdint>
+
+#include "FnEntry.h"
+
+constexpr uint32_t FN_PROFILE_CALLERS = 16; /* Further call sites are counted in the last one. */
+
+///----------------------------------------------------------------------------------------------------
+/// FuncCallerProfile_t Struct
+/// 	Calls of a function from one call site.
+/// 	The owning addon is only resolved when displayed, never on the call path.
+///----------------------------------------------------------------------------------------------------
+struct FuncCallerProfile_t
+{
+	std::atomic<void*>    Address = nullptr; /* Return address of the call site, nullptr if unused. */
+	std::atomic<uint64_t> Calls   = 0;
+	std::atomic<int64_t>  Ticks   = 0;       /* Inclusive, in performance counter ticks. */
+};
+
+///----------------------------------------------------------------------------------------------------
+/// FuncProfile_t Struct
+/// 	Calls of a function through its instrumented thunk.
+///----------------------------------------------------------------------------------------------------
+struct FuncProfile_t
+{
+	FuncEntry_t*          Entry = nullptr;
+	std::atomic<uint64_t> Calls = 0;
+	std::atomic<int64_t>  Ticks = 0;             /* Inclusive, in performance counter ticks. */
+	FuncCallerProfile_t   Callers[FN_PROFILE_CALLERS];
+};
+
+#endif
@@ -9,6 +9,10 @@
 #include "FnRegistry.h"
 
 #include <assert.h>
+#include <chrono>
+#include <thread>
+
+#include "FnThunk.h"
 
 CFuncRegistry::CFuncRegistry(CLogApi* aLogger)
 {
@@ -19,11 +23,26 @@ CFuncRegistry::CFuncRegistry(CLogApi* aLogger)
 
 CFuncRegistry::~CFuncRegistry()
 {
+	for (std::atomic<void*>& thunks : this->Thunks)
+	{
+		FuncThunk::FreePage(thunks.exchange(nullptr), FN_SLOTS_PER_PAGE);
+	}
+
+	for (std::atomic<FuncProfile_t*>& profiles : this->Profiles)
+	{
+		delete[] profiles.exchange(nullptr);
+	}
+
+	for (std::atomic<FuncEntry_t*>& page : this->Pages)
+	{
+		delete[] page.exchange(nullptr);
+	}
 }
 
-void CFuncRegistry::Register(std::string& aIdentifier, void* aFunction)
+FunctionHandle CFuncRegistry::Register(const char* aIdentifier, void* aFunction)
 {
-	if (aFunction == nullptr) { return; }
+	if (aIdentifier == nullptr) { return 0; }
+	if (aFunction == nullptr)   { return 0; }
 
 	const std::lock_guard<std::mutex> lock(this->Mutex);
 
@@ -32,55 +51,333 @@ void CFuncRegistry::Register(std::string& aIdentifier, void* aFunction)
 	if (it != this->Registry.end())
 	{
 		/* Identifier already registered. */
-		return;
+		return 0;
+	}
+
+	uint32_t index = UINT32_MAX;
+
+	if (!this->FreeSlots.empty())
+	{
+		index = this->FreeSlots.back();
+		this->FreeSlots.pop_back();
+	}
+	else if (this->SlotCount < FN_SLOTS_PER_PAGE * FN_MAX_PAGES)
+	{
+		index = this->SlotCount++;
+
+		std::atomic<FuncEntry_t*>& page = this->Pages[index / FN_SLOTS_PER_PAGE];
+
+		if (!page.load(std::memory_order_relaxed))
+		{
+			page.store(new FuncEntry_t[FN_SLOTS_PER_PAGE], std::memory_order_release);
+
+			if (this->Instrumented.load(std::memory_order_relaxed))
+			{
+				this->CreateThunks(index / FN_SLOTS_PER_PAGE);
+			}
+		}
+	}
+	else
+	{
+		this->Logger->Warning(CH_FUNCTIONS, "Function \"%s\" was not registered. All %u slots are in use.", aIdentifier, FN_SLOTS_PER_PAGE * FN_MAX_PAGES);
+		return 0;
+	}
+
+	FuncEntry_t& entry = this->Pages[index / FN_SLOTS_PER_PAGE].load(std::memory_order_relaxed)[index % FN_SLOTS_PER_PAGE];
+	entry.Function.store(aFunction, std::memory_order_release);
+
+	/* A reused slot does not inherit the statistics of the previous function. */
+	if (FuncProfile_t* profiles = this->Profiles[index / FN_SLOTS_PER_PAGE].load(std::memory_order_relaxed))
+	{
+		FuncProfile_t& profile = profiles[index % FN_SLOTS_PER_PAGE];
+		profile.Calls.store(0, std::memory_order_relaxed);
+		profile.Ticks.store(0, std::memory_order_relaxed);
+
+		for (FuncCallerProfile_t& caller : profile.Callers)
+		{
+			caller.Address.store(nullptr, std::memory_order_relaxed);
+			caller.Calls.store(0, std::memory_order_relaxed);
+			caller.Ticks.store(0, std::memory_order_relaxed);
+		}
 	}
 
-	FuncEntry_t entry{};
-	entry.RefCount = 0;
-	entry.Function = aFunction;
+	this->Registry.emplace(aIdentifier, index);
 
-	this->Registry.emplace(aIdentifier, entry);
+	return ((FunctionHandle)entry.Generation.load(std::memory_order_relaxed) << 32) | (index + 1);
 }
 
-void CFuncRegistry::Deregister(std::string& aIdentifier, void* aFunction)
+void CFuncRegistry::Deregister(FunctionHandle aHandle)
 {
-	if (aFunction == nullptr) { return; }
+	std::string identifier;
+	bool isErased = false;
+
+	{
+		const std::lock_guard<std::mutex> lock(this->Mutex);
+
+		FuncEntry_t* entry = this->GetSlot(aHandle);
+
+		if (!entry || entry->Generation.load(std::memory_order_relaxed) != (uint32_t)(aHandle >> 32)) { return; }
+
+		uint32_t index = (uint32_t)aHandle - 1;
+
+		for (auto it = this->Registry.begin(); it != this->Registry.end(); it++)
+		{
+			if (it->second == index)
+			{
+				identifier = it->first;
+				this->Registry.erase(it);
+				isErased = true;
+				break;
+			}
+		}
+	}
 
+	/* A concurrent Deregister or Verify erased it first and removes the slot. */
+	if (!isErased) { return; }
 
+	this->Remove((uint32_t)aHandle - 1, identifier);
 }
 
-void* CFuncRegistry::Query(std::string& aIdentifier)
+FunctionHandle CFuncRegistry::GetHandle(const char* aIdentifier)
 {
+	if (aIdentifier == nullptr) { return 0; }
+
 	const std::lock_guard<std::mutex> lock(this->Mutex);
 
 	auto it = this->Registry.find(aIdentifier);
 
-	if (it != this->Registry.end())
+	if (it == this->Registry.end()) { return 0; }
+
+	const FuncEntry_t& entry = this->Pages[it->second / FN_SLOTS_PER_PAGE].load(std::memory_order_relaxed)[it->second % FN_SLOTS_PER_PAGE];
+
+	return ((FunctionHandle)entry.Generation.load(std::memory_order_relaxed) << 32) | (it->second + 1);
+}
+
+void* CFuncRegistry::Query(FunctionHandle aHandle)
+{
+	FuncEntry_t* entry = this->GetSlot(aHandle);
+
+	if (!entry) { return nullptr; }
+
+	/* Counted before the generation is checked, so Remove either sees the reference or the caller sees the new generation. */
+	entry->RefCount.fetch_add(1, std::memory_order_seq_cst);
+
+	void* function = entry->Function.load(std::memory_order_acquire);
+
+	if (function && entry->Generation.load(std::memory_order_seq_cst) == (uint32_t)(aHandle >> 32))
 	{
-		it->second.RefCount++;
-		return it->second.Function;
+		if (this->Instrumented.load(std::memory_order_relaxed))
+		{
+			uint32_t index = (uint32_t)aHandle - 1;
+			void* thunks = this->Thunks[index / FN_SLOTS_PER_PAGE].load(std::memory_order_acquire);
+
+			if (thunks)
+			{
+				return static_cast<char*>(thunks) + (index % FN_SLOTS_PER_PAGE) * FN_THUNK_SIZE;
+			}
+		}
+
+		return function;
 	}
 
+	entry->RefCount.fetch_sub(1, std::memory_order_release);
+
 	return nullptr;
 }
 
-void CFuncRegistry::Release(std::string& aIdentifier)
+void CFuncRegistry::Release(FunctionHandle aHandle)
+{
+	FuncEntry_t* entry = this->GetSlot(aHandle);
+
+	if (!entry) { return; }
+
+	/* No generation check, a deregistered function still waits for its last callers. */
+	if (entry->RefCount.fetch_sub(1, std::memory_order_release) <= 0)
+	{
+		this->Logger->Critical(
+			CH_FUNCTIONS,
+			"Function handle %llX reference count less than zero. Query/Release mismatch. Function may be freed prematurely.",
+			aHandle
+		);
+	}
+}
+
+int CFuncRegistry::Verify(void* aStartAddress, void* aEndAddress)
+{
+	std::vector<std::pair<uint32_t, std::string>> removed;
+
+	{
+		const std::lock_guard<std::mutex> lock(this->Mutex);
+
+		for (auto it = this->Registry.begin(); it != this->Registry.end();)
+		{
+			const FuncEntry_t& entry = this->Pages[it->second / FN_SLOTS_PER_PAGE].load(std::memory_order_relaxed)[it->second % FN_SLOTS_PER_PAGE];
+			void* function = entry.Function.load(std::memory_order_relaxed);
+
+			if (function >= aStartAddress && function <= aEndAddress)
+			{
+				removed.emplace_back(it->second, it->first);
+				it = this->Registry.erase(it);
+			}
+			else
+			{
+				it++;
+			}
+		}
+	}
+
+	for (auto& [index, identifier] : removed)
+	{
+		this->Remove(index, identifier);
+	}
+
+	return (int)removed.size();
+}
+
+bool CFuncRegistry::SetInstrumented(bool aIsInstrumented)
 {
+	if (aIsInstrumented && !FuncThunk::IsSupported())
+	{
+		this->Logger->Warning(CH_FUNCTIONS, "Instrumented calls are not supported on this platform.");
+		return false;
+	}
+
 	const std::lock_guard<std::mutex> lock(this->Mutex);
 
-	auto it = this->Registry.find(aIdentifier);
+	if (aIsInstrumented)
+	{
+		for (uint32_t i = 0; i < FN_MAX_PAGES; i++)
+		{
+			if (this->Pages[i].load(std::memory_order_relaxed))
+			{
+				this->CreateThunks(i);
+			}
+		}
+	}
 
-	if (it != this->Registry.end())
+	this->Instrumented.store(aIsInstrumented, std::memory_order_relaxed);
+
+	this->Logger->Info(CH_FUNCTIONS, "Instrumented calls %s.", aIsInstrumented ? "enabled" : "disabled");
+
+	return true;
+}
+
+bool CFuncRegistry::IsInstrumented() const
+{
+	return this->Instrumented.load(std::memory_order_relaxed);
+}
+
+void CFuncRegistry::ResetProfiles()
+{
+	const std::lock_guard<std::mutex> lock(this->Mutex);
+
+	for (std::atomic<FuncProfile_t*>& page : this->Profiles)
+	{
+		FuncProfile_t* profiles = page.load(std::memory_order_relaxed);
+
+		if (!profiles) { continue; }
+
+		for (uint32_t i = 0; i < FN_SLOTS_PER_PAGE; i++)
+		{
+			profiles[i].Calls.store(0, std::memory_order_relaxed);
+			profiles[i].Ticks.store(0, std::memory_order_relaxed);
+
+			/* Callers keep their address, so a concurrent call never ends up in a half cleared entry. */
+			for (FuncCallerProfile_t& caller : profiles[i].Callers)
+			{
+				caller.Calls.store(0, std::memory_order_relaxed);
+				caller.Ticks.store(0, std::memory_order_relaxed);
+			}
+		}
+	}
+}
+
+std::vector<std::pair<std::string, const FuncProfile_t*>> CFuncRegistry::GetProfiles()
+{
+	std::vector<std::pair<std::string, const FuncProfile_t*>> result;
+
+	const std::lock_guard<std::mutex> lock(this->Mutex);
+
+	for (auto& [identifier, index] : this->Registry)
 	{
-		it->second.RefCount--;
+		const FuncProfile_t* profiles = this->Profiles[index / FN_SLOTS_PER_PAGE].load(std::memory_order_relaxed);
 
-		if (it->second.RefCount < 0)
+		if (profiles)
 		{
+			result.emplace_back(identifier, &profiles[index % FN_SLOTS_PER_PAGE]);
+		}
+	}
+
+	return result;
+}
+
+FuncEntry_t* CFuncRegistry::GetSlot(FunctionHandle aHandle) const
+{
+	uint32_t index = (uint32_t)aHandle;
+
+	if (index == 0 || index > FN_SLOTS_PER_PAGE * FN_MAX_PAGES) { return nullptr; }
+
+	index--;
+
+	FuncEntry_t* page = this->Pages[index / FN_SLOTS_PER_PAGE].load(std::memory_order_acquire);
+
+	return page ? &page[index % FN_SLOTS_PER_PAGE] : nullptr;
+}
+
+void CFuncRegistry::Remove(uint32_t aIndex, const std::string& aIdentifier)
+{
+	FuncEntry_t& entry = this->Pages[aIndex / FN_SLOTS_PER_PAGE].load(std::memory_order_relaxed)[aIndex % FN_SLOTS_PER_PAGE];
+
+	/* Queries from here on fail the generation check. */
+	entry.Generation.fetch_add(1, std::memory_order_seq_cst);
+
+	auto start = std::chrono::steady_clock::now();
+
+	while (entry.RefCount.load(std::memory_order_seq_cst) > 0)
+	{
+		if (std::chrono::steady_clock::now() - start > std::chrono::milliseconds(FN_DRAIN_TIMEOUT_MS))
+		{
+			/* The slot is not reused, a late Release must not affect another function. */
 			this->Logger->Critical(
 				CH_FUNCTIONS,
-				"%s reference count less than zero. Query/Release mismatch. Function may be freed prematurely.",
-				aIdentifier.c_str()
+				"Function \"%s\" was deregistered with %d references left. Query/Release mismatch.",
+				aIdentifier.c_str(),
+				entry.RefCount.load(std::memory_order_relaxed)
 			);
+			return;
 		}
+
+		std::this_thread::yield();
+	}
+
+	entry.Function.store(nullptr, std::memory_order_relaxed);
+
+	const std::lock_guard<std::mutex> lock(this->Mutex);
+	this->FreeSlots.push_back(aIndex);
+}
+
+void CFuncRegistry::CreateThunks(uint32_t aPage)
+{
+	if (this->Thunks[aPage].load(std::memory_order_relaxed)) { return; }
+
+	FuncEntry_t* entries = this->Pages[aPage].load(std::memory_order_relaxed);
+
+	FuncProfile_t* profiles = new FuncProfile_t[FN_SLOTS_PER_PAGE];
+
+	for (uint32_t i = 0; i < FN_SLOTS_PER_PAGE; i++)
+	{
+		profiles[i].Entry = &entries[i];
 	}
+
+	void* thunks = FuncThunk::CreatePage(profiles, FN_SLOTS_PER_PAGE);
+
+	if (!thunks)
+	{
+		delete[] profiles;
+		this->Logger->Warning(CH_FUNCTIONS, "Failed to generate thunks. Calls are not instrumented.");
+		return;
+	}
+
+	this->Profiles[aPage].store(profiles, std::memory_order_release);
+	this->Thunks[aPage].store(thunks, std::memory_order_release);
 }
@@ -9,14 +9,19 @@
 #ifndef FNREGISTRY_H
 #define FNREGISTRY_H
 
+#include <atomic>
 #include <mutex>
 #include <unordered_map>
 #include <string>
+#include <vector>
 
 #include "FnEntry.h"
+#include "FnFuncDefs.h"
+#include "FnProfile.h"
 #include "Engine/Logging/LogApi.h"
 
-constexpr const char* CH_FUNCTIONS = "Functions";
+constexpr const char* CH_FUNCTIONS        = "Functions";
+constexpr uint32_t    FN_DRAIN_TIMEOUT_MS = 5000; /* Deregister gives up on callers that never release. */
 
 ///----------------------------------------------------------------------------------------------------
 /// CFuncRegistry Class
@@ -36,34 +41,101 @@ class CFuncRegistry
 
 	///----------------------------------------------------------------------------------------------------
 	/// Register:
-	/// 	Registers a function with the given identifier.
+	/// 	Registers a function with the given identifier and returns its handle.
+	/// 	Returns 0, if the identifier is already registered.
 	///----------------------------------------------------------------------------------------------------
-	void Register(std::string& aIdentifier, void* aFunction);
+	FunctionHandle Register(const char* aIdentifier, void* aFunction);
 
 	///----------------------------------------------------------------------------------------------------
 	/// Deregister:
-	/// 	Deregisters a function with the given identifier.
+	/// 	Deregisters the function of the given handle.
+	/// 	Returns once no caller between Query and Release is left.
 	///----------------------------------------------------------------------------------------------------
-	void Deregister(std::string& aIdentifier, void* aFunction);
+	void Deregister(FunctionHandle aHandle);
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetHandle:
+	/// 	Returns the handle of the function with the given identifier or 0.
+	///----------------------------------------------------------------------------------------------------
+	FunctionHandle GetHandle(const char* aIdentifier);
 
 	///----------------------------------------------------------------------------------------------------
 	/// Query:
-	/// 	Queries for a function with the given identifier and returns it or nullptr.
-	/// 	If a function is returned, the refcount is incremented.
+	/// 	Returns the function of the given handle or nullptr, without a lock or a lookup.
+	/// 	If a function is returned, the refcount is incremented and the function stays registered until Release.
+	/// 	While instrumented, returns a thunk that counts and times the calls instead.
 	///----------------------------------------------------------------------------------------------------
-	void* Query(std::string& aIdentifier);
+	void* Query(FunctionHandle aHandle);
 
 	///----------------------------------------------------------------------------------------------------
 	/// Release:
-	/// 	Decrements the refcount of the function with the given identifier.
+	/// 	Decrements the refcount of the function of the given handle.
+	///----------------------------------------------------------------------------------------------------
+	void Release(FunctionHandle aHandle);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Verify:
+	/// 	Deregisters any functions within the provided address space.
+	///----------------------------------------------------------------------------------------------------
+	int Verify(void* aStartAddress, void* aEndAddress);
+
+	///----------------------------------------------------------------------------------------------------
+	/// SetInstrumented:
+	/// 	Enables or disables returning thunks from Query. Thunks already handed out keep counting.
+	/// 	Returns false, if thunks are not supported on this platform.
+	///----------------------------------------------------------------------------------------------------
+	bool SetInstrumented(bool aIsInstrumented);
+
+	///----------------------------------------------------------------------------------------------------
+	/// IsInstrumented:
+	/// 	Returns true, if Query returns thunks.
+	///----------------------------------------------------------------------------------------------------
+	bool IsInstrumented() const;
+
+	///----------------------------------------------------------------------------------------------------
+	/// ResetProfiles:
+	/// 	Clears the call statistics.
 	///----------------------------------------------------------------------------------------------------
-	void Release(std::string& aIdentifier);
+	void ResetProfiles();
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetProfiles:
+	/// 	Returns the call statistics of the registered functions. They stay valid until the registry is destroyed.
+	///----------------------------------------------------------------------------------------------------
+	std::vector<std::pair<std::string, const FuncProfile_t*>> GetProfiles();
 
 	private:
-	CLogApi*                                     Logger;
+	CLogApi*                                  Logger;
+
+	std::mutex                                Mutex;
+	std::unordered_map<std::string, uint32_t> Registry;                   /* Identifier to slot index. */
+
+	std::atomic<FuncEntry_t*>                 Pages[FN_MAX_PAGES] = {};   /* Pages are allocated on demand and never moved. */
+	uint32_t                                  SlotCount = 0;
+	std::vector<uint32_t>                     FreeSlots;
+
+	std::atomic<bool>                         Instrumented = false;
+	std::atomic<FuncProfile_t*>               Profiles[FN_MAX_PAGES] = {}; /* Allocated with the thunks, once instrumented. */
+	std::atomic<void*>                        Thunks[FN_MAX_PAGES] = {};
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetSlot:
+	/// 	Returns the slot of a handle or nullptr, if the index is out of range.
+	///----------------------------------------------------------------------------------------------------
+	FuncEntry_t* GetSlot(FunctionHandle aHandle) const;
 
-	std::mutex                                   Mutex;
-	std::unordered_map<std::string, FuncEntry_t> Registry;
+	///----------------------------------------------------------------------------------------------------
+	/// Remove:
+	/// 	Invalidates the handles of a slot, waits for its refcount to drain and frees it.
+	/// 	Must be called without the Mutex held.
+	///----------------------------------------------------------------------------------------------------
+	void Remove(uint32_t aIndex, const std::string& aIdentifier);
+
+	///----------------------------------------------------------------------------------------------------
+	/// CreateThunks:
+	/// 	Generates the thunks and profiles of a page, if it has none yet. Must be called with the Mutex held.
+	///----------------------------------------------------------------------------------------------------
+	void CreateThunks(uint32_t aPage);
 };
 
 #endif
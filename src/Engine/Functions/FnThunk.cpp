@@ -0,0 +1,314 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  FnThunk.cpp
+/// Description  :  Generates the call-through thunks of instrumented functions.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include "FnThunk.h"
+
+#include <cassert>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include "Util/Platform.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define FN_THUNK_X64
+#endif
+
+/* The stubs call Enter/Exit with the x64 Windows calling convention, also when measured outside the game. */
+#if defined(FN_THUNK_X64) && !defined(_WIN32)
+#define FN_THUNK_ABI __attribute__((ms_abi))
+#else
+#define FN_THUNK_ABI
+#endif
+
+namespace FuncThunk
+{
+	///----------------------------------------------------------------------------------------------------
+	/// Frame_t Struct
+	/// 	A call in progress. The thunk replaced its return address, Exit returns there.
+	///----------------------------------------------------------------------------------------------------
+	struct Frame_t
+	{
+		FuncProfile_t* Profile;
+		void*          ReturnAddress;
+		void**         Slot;          /* Stack slot of the return address, identifies the call. */
+		int64_t        Start;
+	};
+
+	static thread_local std::vector<Frame_t> s_Frames;
+
+	static std::once_flag                    s_StubsFlag;
+	static void*                             s_EnterStub = nullptr;
+	static void*                             s_ExitStub  = nullptr;
+
+	///----------------------------------------------------------------------------------------------------
+	/// Emitter_t Struct
+	///----------------------------------------------------------------------------------------------------
+	struct Emitter_t
+	{
+		unsigned char* Code;
+
+		void Bytes(std::initializer_list<unsigned char> aBytes)
+		{
+			for (unsigned char b : aBytes)
+			{
+				*this->Code++ = b;
+			}
+		}
+
+		void Imm64(const void* aValue)
+		{
+			uint64_t value = (uint64_t)(uintptr_t)aValue;
+			memcpy(this->Code, &value, sizeof(value));
+			this->Code += sizeof(value);
+		}
+	};
+
+	///----------------------------------------------------------------------------------------------------
+	/// FindCaller:
+	/// 	Returns the statistics of the call site the return address belongs to.
+	///----------------------------------------------------------------------------------------------------
+	static FuncCallerProfile_t* FindCaller(FuncProfile_t* aProfile, void* aReturnAddress)
+	{
+		for (uint32_t i = 0; i < FN_PROFILE_CALLERS - 1; i++)
+		{
+			FuncCallerProfile_t& caller = aProfile->Callers[i];
+			void* current = caller.Address.load(std::memory_order_acquire);
+
+			if (current == nullptr)
+			{
+				if (caller.Address.compare_exchange_strong(current, aReturnAddress, std::memory_order_acq_rel))
+				{
+					return &caller;
+				}
+			}
+
+			if (current == aReturnAddress)
+			{
+				return &caller;
+			}
+		}
+
+		return &aProfile->Callers[FN_PROFILE_CALLERS - 1];
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// DropStale:
+	/// 	Drops frames of calls that never reached Exit, because something unwound past the thunk.
+	/// 	The stack grows down, so a live frame's slot is above aSlot.
+	///----------------------------------------------------------------------------------------------------
+	static void DropStale(void** aSlot, bool aIsInclusive)
+	{
+		while (!s_Frames.empty() && (s_Frames.back().Slot < aSlot || (aIsInclusive && s_Frames.back().Slot == aSlot)))
+		{
+			s_Frames.pop_back();
+		}
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// Enter:
+	/// 	Called by the enter stub. Returns the function to jump to.
+	///----------------------------------------------------------------------------------------------------
+	static void* FN_THUNK_ABI Enter(FuncProfile_t* aProfile, void* aReturnAddress, void** aSlot)
+	{
+		DropStale(aSlot, true);
+
+		s_Frames.push_back(Frame_t{ aProfile, aReturnAddress, aSlot, Platform::GetPerformanceCounter() });
+
+		/* The caller holds a reference from Query, the function cannot be deregistered meanwhile. */
+		return aProfile->Entry->Function.load(std::memory_order_acquire);
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// Exit:
+	/// 	Called by the exit stub, once the function returned.
+	/// 	Restores the original return address to aSlot, the exit stub returns through it.
+	///----------------------------------------------------------------------------------------------------
+	static void FN_THUNK_ABI Exit(void** aSlot)
+	{
+		int64_t end = Platform::GetPerformanceCounter();
+
+		DropStale(aSlot, false);
+
+		Frame_t frame = s_Frames.back();
+		s_Frames.pop_back();
+
+		/* First, so stack walks from here on see the caller. */
+		*aSlot = frame.ReturnAddress;
+
+		int64_t ticks = end - frame.Start;
+
+		frame.Profile->Calls.fetch_add(1, std::memory_order_relaxed);
+		frame.Profile->Ticks.fetch_add(ticks, std::memory_order_relaxed);
+
+		FuncCallerProfile_t* caller = FindCaller(frame.Profile, frame.ReturnAddress);
+		caller->Calls.fetch_add(1, std::memory_order_relaxed);
+		caller->Ticks.fetch_add(ticks, std::memory_order_relaxed);
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// CreateStubs:
+	/// 	Generates the enter and exit stubs shared by all thunks, with their unwind data.
+	/// 	The thunks themselves don't touch the stack and need none.
+	///----------------------------------------------------------------------------------------------------
+	static void CreateStubs()
+	{
+#ifdef FN_THUNK_X64
+		const size_t size = 512;
+		unsigned char* code = static_cast<unsigned char*>(Platform::AllocateCode(size));
+
+		if (!code) { return; }
+
+		memset(code, 0xCC, size);
+
+		/* Exit: the function returned here. Reserves the slot of the original return address, then keeps
+		 * the return values, rax/rdx and xmm0-3, while Exit writes it. Returns through the restored slot. */
+		Emitter_t exit{ code };
+		exit.Bytes({ 0x48, 0x83, 0xEC, 0x08 });                   /* sub rsp, 0x08            */
+		unsigned char* exitBegin = exit.Code;
+		exit.Bytes({ 0x50 });                                     /* push rax                 */
+		exit.Bytes({ 0x52 });                                     /* push rdx                 */
+		exit.Bytes({ 0x48, 0x83, 0xEC, 0x68 });                   /* sub rsp, 0x68            */
+		exit.Bytes({ 0xF3, 0x0F, 0x7F, 0x44, 0x24, 0x20 });       /* movdqu [rsp+0x20], xmm0  */
+		exit.Bytes({ 0xF3, 0x0F, 0x7F, 0x4C, 0x24, 0x30 });       /* movdqu [rsp+0x30], xmm1  */
+		exit.Bytes({ 0xF3, 0x0F, 0x7F, 0x54, 0x24, 0x40 });       /* movdqu [rsp+0x40], xmm2  */
+		exit.Bytes({ 0xF3, 0x0F, 0x7F, 0x5C, 0x24, 0x50 });       /* movdqu [rsp+0x50], xmm3  */
+		exit.Bytes({ 0x48, 0x8D, 0x4C, 0x24, 0x78 });             /* lea rcx, [rsp+0x78]      */
+		exit.Bytes({ 0x48, 0xB8 }); exit.Imm64((void*)&Exit);     /* mov rax, Exit            */
+		exit.Bytes({ 0xFF, 0xD0 });                               /* call rax                 */
+		exit.Bytes({ 0xF3, 0x0F, 0x6F, 0x44, 0x24, 0x20 });       /* movdqu xmm0, [rsp+0x20]  */
+		exit.Bytes({ 0xF3, 0x0F, 0x6F, 0x4C, 0x24, 0x30 });       /* movdqu xmm1, [rsp+0x30]  */
+		exit.Bytes({ 0xF3, 0x0F, 0x6F, 0x54, 0x24, 0x40 });       /* movdqu xmm2, [rsp+0x40]  */
+		exit.Bytes({ 0xF3, 0x0F, 0x6F, 0x5C, 0x24, 0x50 });       /* movdqu xmm3, [rsp+0x50]  */
+		exit.Bytes({ 0x48, 0x83, 0xC4, 0x68 });                   /* add rsp, 0x68            */
+		exit.Bytes({ 0x5A });                                     /* pop rdx                  */
+		exit.Bytes({ 0x58 });                                     /* pop rax                  */
+		exit.Bytes({ 0xC3 });                                     /* ret                      */
+		unsigned char* exitEnd = exit.Code;
+
+		/* Enter: r10 holds the profile. Keeps the arguments, rcx/rdx/r8/r9 and xmm0-5, while calling Enter.
+		 * Then swaps the return address for the exit stub and jumps, so arguments on the stack stay in place. */
+		unsigned char* enterBegin = code + 128;
+		Emitter_t enter{ enterBegin };
+		enter.Bytes({ 0x51 });                                    /* push rcx                 */
+		enter.Bytes({ 0x52 });                                    /* push rdx                 */
+		enter.Bytes({ 0x41, 0x50 });                              /* push r8                  */
+		enter.Bytes({ 0x41, 0x51 });                              /* push r9                  */
+		enter.Bytes({ 0x48, 0x81, 0xEC, 0x88, 0x00, 0x00, 0x00 });/* sub rsp, 0x88            */
+		enter.Bytes({ 0xF3, 0x0F, 0x7F, 0x44, 0x24, 0x20 });      /* movdqu [rsp+0x20], xmm0  */
+		enter.Bytes({ 0xF3, 0x0F, 0x7F, 0x4C, 0x24, 0x30 });      /* movdqu [rsp+0x30], xmm1  */
+		enter.Bytes({ 0xF3, 0x0F, 0x7F, 0x54, 0x24, 0x40 });      /* movdqu [rsp+0x40], xmm2  */
+		enter.Bytes({ 0xF3, 0x0F, 0x7F, 0x5C, 0x24, 0x50 });      /* movdqu [rsp+0x50], xmm3  */
+		enter.Bytes({ 0xF3, 0x0F, 0x7F, 0x64, 0x24, 0x60 });      /* movdqu [rsp+0x60], xmm4  */
+		enter.Bytes({ 0xF3, 0x0F, 0x7F, 0x6C, 0x24, 0x70 });      /* movdqu [rsp+0x70], xmm5  */
+		enter.Bytes({ 0x4C, 0x89, 0xD1 });                        /* mov rcx, r10             */
+		enter.Bytes({ 0x48, 0x8B, 0x94, 0x24, 0xA8, 0x00, 0x00, 0x00 }); /* mov rdx, [rsp+0xA8] */
+		enter.Bytes({ 0x4C, 0x8D, 0x84, 0x24, 0xA8, 0x00, 0x00, 0x00 }); /* lea r8, [rsp+0xA8]  */
+		enter.Bytes({ 0x48, 0xB8 }); enter.Imm64((void*)&Enter);  /* mov rax, Enter           */
+		enter.Bytes({ 0xFF, 0xD0 });                              /* call rax                 */
+		enter.Bytes({ 0x49, 0x89, 0xC3 });                        /* mov r11, rax             */
+		enter.Bytes({ 0xF3, 0x0F, 0x6F, 0x44, 0x24, 0x20 });      /* movdqu xmm0, [rsp+0x20]  */
+		enter.Bytes({ 0xF3, 0x0F, 0x6F, 0x4C, 0x24, 0x30 });      /* movdqu xmm1, [rsp+0x30]  */
+		enter.Bytes({ 0xF3, 0x0F, 0x6F, 0x54, 0x24, 0x40 });      /* movdqu xmm2, [rsp+0x40]  */
+		enter.Bytes({ 0xF3, 0x0F, 0x6F, 0x5C, 0x24, 0x50 });      /* movdqu xmm3, [rsp+0x50]  */
+		enter.Bytes({ 0xF3, 0x0F, 0x6F, 0x64, 0x24, 0x60 });      /* movdqu xmm4, [rsp+0x60]  */
+		enter.Bytes({ 0xF3, 0x0F, 0x6F, 0x6C, 0x24, 0x70 });      /* movdqu xmm5, [rsp+0x70]  */
+		unsigned char* enterEnd = enter.Code;                     /* Not a canonical epilog, past here it unwinds as a leaf. */
+		enter.Bytes({ 0x48, 0x81, 0xC4, 0x88, 0x00, 0x00, 0x00 });/* add rsp, 0x88            */
+		enter.Bytes({ 0x41, 0x59 });                              /* pop r9                   */
+		enter.Bytes({ 0x41, 0x58 });                              /* pop r8                   */
+		enter.Bytes({ 0x5A });                                    /* pop rdx                  */
+		enter.Bytes({ 0x59 });                                    /* pop rcx                  */
+		enter.Bytes({ 0x48, 0xB8 }); enter.Imm64(code);           /* mov rax, exit stub       */
+		enter.Bytes({ 0x48, 0x89, 0x04, 0x24 });                  /* mov [rsp], rax           */
+		enter.Bytes({ 0x41, 0xFF, 0xE3 });                        /* jmp r11                  */
+
+		/* UNWIND_INFO: version 1, prolog size, code count, no frame register.
+		 * Codes are in reverse order: prolog offset, then op | info << 4. Op 0 pushes a register, 1 and 2 allocate. */
+		unsigned char* exitUnwind = code + 320;
+		Emitter_t unwind{ exitUnwind };
+		unwind.Bytes({ 0x01, 0x06, 0x03, 0x00 });
+		unwind.Bytes({ 0x06, 0x02 | (0x68 / 8 - 1) << 4 });     /* sub rsp, 0x68            */
+		unwind.Bytes({ 0x02, 0x00 | 2 << 4 });                    /* push rdx                 */
+		unwind.Bytes({ 0x01, 0x00 | 0 << 4 });                    /* push rax                 */
+		unwind.Bytes({ 0x00, 0x00 });                             /* Padding to an even count. */
+
+		unsigned char* enterUnwind = unwind.Code;
+		unwind.Bytes({ 0x01, 0x0D, 0x06, 0x00 });
+		unwind.Bytes({ 0x0D, 0x01, 0x88 / 8, 0x00 });             /* sub rsp, 0x88            */
+		unwind.Bytes({ 0x06, 0x00 | 9 << 4 });                    /* push r9                  */
+		unwind.Bytes({ 0x04, 0x00 | 8 << 4 });                    /* push r8                  */
+		unwind.Bytes({ 0x02, 0x00 | 2 << 4 });                    /* push rdx                 */
+		unwind.Bytes({ 0x01, 0x00 | 1 << 4 });                    /* push rcx                 */
+
+		/* The exit stub begins after reserving the slot, so the unwinder reads the restored return address there. */
+		uint32_t* table = reinterpret_cast<uint32_t*>(code + 384);
+
+		/* Each part has to stay within its region of the allocation. */
+		assert(exit.Code <= enterBegin && enter.Code <= exitUnwind && unwind.Code <= (unsigned char*)table);
+		table[0] = (uint32_t)(exitBegin - code);
+		table[1] = (uint32_t)(exitEnd - code);
+		table[2] = (uint32_t)(exitUnwind - code);
+		table[3] = (uint32_t)(enterBegin - code);
+		table[4] = (uint32_t)(enterEnd - code);
+		table[5] = (uint32_t)(enterUnwind - code);
+
+		if (!Platform::ProtectCode(code, size))
+		{
+			Platform::FreeCode(code, size);
+			return;
+		}
+
+		/* Without it, stack walks stop at the stubs, measuring still works. */
+		Platform::AddUnwindTable(table, 2, code);
+
+		s_ExitStub = code;
+		s_EnterStub = enterBegin;
+#endif
+	}
+
+	bool IsSupported()
+	{
+		std::call_once(s_StubsFlag, CreateStubs);
+
+		return s_EnterStub != nullptr;
+	}
+
+	void* CreatePage(FuncProfile_t* aProfiles, uint32_t aCount)
+	{
+		if (!aProfiles || aCount == 0 || !IsSupported()) { return nullptr; }
+
+		size_t size = aCount * FN_THUNK_SIZE;
+		unsigned char* code = static_cast<unsigned char*>(Platform::AllocateCode(size));
+
+		if (!code) { return nullptr; }
+
+		memset(code, 0xCC, size);
+
+		for (uint32_t i = 0; i < aCount; i++)
+		{
+			Emitter_t thunk{ code + i * FN_THUNK_SIZE };
+			thunk.Bytes({ 0x49, 0xBA }); thunk.Imm64(&aProfiles[i]); /* mov r10, profile */
+			thunk.Bytes({ 0x49, 0xBB }); thunk.Imm64(s_EnterStub);   /* mov r11, enter stub */
+			thunk.Bytes({ 0x41, 0xFF, 0xE3 });                       /* jmp r11 */
+		}
+
+		if (!Platform::ProtectCode(code, size))
+		{
+			Platform::FreeCode(code, size);
+			return nullptr;
+		}
+
+		return code;
+	}
+
+	void FreePage(void* aPage, uint32_t aCount)
+	{
+		Platform::FreeCode(aPage, aCount * FN_THUNK_SIZE);
+	}
+}
@@ -0,0 +1,47 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  FnThunk.h
+/// Description  :  Generates the call-through thunks of instrumented functions.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef FNTHUNK_H
+#define FNTHUNK_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "FnProfile.h"
+
+constexpr size_t FN_THUNK_SIZE = 32;
+
+///----------------------------------------------------------------------------------------------------
+/// FuncThunk Namespace
+/// 	A thunk counts and times the call, then jumps to the function with the arguments untouched.
+/// 	Only for the x64 Windows calling convention. The stubs register unwind data, but the thunk
+/// 	replaces the return address while the function runs, so exceptions must not propagate through it.
+/// 	Calls left without returning, e.g. by longjmp, are dropped from the thread's frames on the next call.
+///----------------------------------------------------------------------------------------------------
+namespace FuncThunk
+{
+	///----------------------------------------------------------------------------------------------------
+	/// IsSupported:
+	/// 	Returns true, if thunks can be generated on this platform.
+	///----------------------------------------------------------------------------------------------------
+	bool IsSupported();
+
+	///----------------------------------------------------------------------------------------------------
+	/// CreatePage:
+	/// 	Generates one thunk per profile. Returns the first thunk or nullptr.
+	///----------------------------------------------------------------------------------------------------
+	void* CreatePage(FuncProfile_t* aProfiles, uint32_t aCount);
+
+	///----------------------------------------------------------------------------------------------------
+	/// FreePage:
+	/// 	Frees thunks from CreatePage.
+	///----------------------------------------------------------------------------------------------------
+	void FreePage(void* aPage, uint32_t aCount);
+}
+
+#endif
@@ -9,11 +9,13 @@
 #include "ApiFunctionMapper.h"
 
 #include <assert.h>
+#include <intrin.h>
 
 #include "Core/Context.h"
 #include "Core/Index/Index.h"
 #include "Engine/DataLink/DlApi.h"
 #include "Engine/Events/EvtApi.h"
+#include "Engine/Functions/FnRegistry.h"
 #include "Engine/Inputs/InputBinds/IbApi.h"
 #include "Engine/Inputs/RawInput/RiApi.h"
 #include "Engine/Loader/ArcDPS.h"
@@ -35,6 +37,7 @@ namespace ADDONAPI
 
 	static CDataLinkApi*    s_DataLinkApi   = nullptr;
 	static CEventApi*       s_EventApi      = nullptr;
+	static CFuncRegistry*   s_FuncRegistry  = nullptr;
 	static CGameBindsApi*   s_GameBindsApi  = nullptr;
 	static CInputBindApi*   s_InputBindApi  = nullptr;
 	static CRawInputApi*    s_RawInputApi   = nullptr;
@@ -56,25 +59,52 @@ namespace ADDONAPI
 		void* GetResource(const char* aIdentifier)
 		{
 			assert(s_DataLinkApi);
-			return s_DataLinkApi->GetResource(aIdentifier);
+			return s_DataLinkApi->GetResource(aIdentifier, _ReturnAddress());
 		}
 
 		void* ShareResource(const char* aIdentifier, size_t aResourceSize)
 		{
 			assert(s_DataLinkApi);
-			return s_DataLinkApi->ShareResource(aIdentifier, aResourceSize, "", true);
+			return s_DataLinkApi->ShareResource(aIdentifier, aResourceSize, "", true, _ReturnAddress());
+		}
+
+		void* ShareVersioned(const char* aIdentifier, size_t aResourceSize)
+		{
+			assert(s_DataLinkApi);
+			return s_DataLinkApi->ShareVersionedResource(aIdentifier, aResourceSize, "", true, _ReturnAddress());
+		}
+
+		void* ShareTripleBuffer(const char* aIdentifier, size_t aResourceSize)
+		{
+			assert(s_DataLinkApi);
+			return s_DataLinkApi->ShareTripleBuffer(aIdentifier, aResourceSize, "", true, _ReturnAddress());
+		}
+
+		DataLinkHandle GetHandle(const char* aIdentifier)
+		{
+			assert(s_DataLinkApi);
+			return s_DataLinkApi->GetHandle(aIdentifier, _ReturnAddress());
+		}
+
+		void* GetResourceByHandle(DataLinkHandle aHandle)
+		{
+			assert(s_DataLinkApi);
+			return s_DataLinkApi->GetResource(aHandle);
+		}
+
+		void ReleaseResource(const char* aIdentifier)
+		{
+			assert(s_DataLinkApi);
+			s_DataLinkApi->ReleaseResource(aIdentifier, _ReturnAddress());
 		}
 	}
 
 	namespace Events
 	{
-		void Subscribe(const char* aIdentifier, EVENT_CONSUME aConsumeEventCallback)
+		static void DetectArcDPS(const char* aIdentifier)
 		{
-			assert(s_EventApi);
-			s_EventApi->Subscribe(aIdentifier, aConsumeEventCallback);
-
 			// FIXME: Dirty hack to detect ArcDPS below. Do this cleaner later.
-			if (ArcDPS::IsLoaded)
+			if (ArcDPS::IsLoaded || aIdentifier == nullptr)
 			{
 				return;
 			}
@@ -87,6 +117,14 @@ namespace ADDONAPI
 			ArcDPS::Detect();
 		}
 
+		void Subscribe(const char* aIdentifier, EVENT_CONSUME aConsumeEventCallback)
+		{
+			assert(s_EventApi);
+			s_EventApi->Subscribe(aIdentifier, aConsumeEventCallback);
+
+			DetectArcDPS(aIdentifier);
+		}
+
 		void Unsubscribe(const char* aIdentifier, EVENT_CONSUME aConsumeEventCallback)
 		{
 			assert(s_EventApi);
@@ -116,6 +154,101 @@ namespace ADDONAPI
 			assert(s_EventApi);
 			s_EventApi->Raise(aSignature, aIdentifier, nullptr);
 		}
+
+		EventHandle GetHandle(const char* aIdentifier)
+		{
+			assert(s_EventApi);
+			return s_EventApi->GetHandle(aIdentifier);
+		}
+
+		void SubscribeByHandle(EventHandle aHandle, EVENT_CONSUME aConsumeEventCallback)
+		{
+			assert(s_EventApi);
+			s_EventApi->SubscribeByHandle(aHandle, aConsumeEventCallback);
+
+			DetectArcDPS(s_EventApi->GetIdentifier(aHandle));
+		}
+
+		void UnsubscribeByHandle(EventHandle aHandle, EVENT_CONSUME aConsumeEventCallback)
+		{
+			assert(s_EventApi);
+			s_EventApi->UnsubscribeByHandle(aHandle, aConsumeEventCallback);
+		}
+
+		void RaiseEventByHandle(EventHandle aHandle, void* aEventData)
+		{
+			assert(s_EventApi);
+			s_EventApi->RaiseByHandle(aHandle, aEventData);
+		}
+
+		void RaiseNotificationByHandle(EventHandle aHandle)
+		{
+			assert(s_EventApi);
+			s_EventApi->RaiseByHandle(aHandle, nullptr);
+		}
+
+		void RaiseEventTargetedByHandle(signed int aSignature, EventHandle aHandle, void* aEventData)
+		{
+			assert(s_EventApi);
+			s_EventApi->RaiseByHandle(aSignature, aHandle, aEventData);
+		}
+
+		void RaiseNotificationTargetedByHandle(signed int aSignature, EventHandle aHandle)
+		{
+			assert(s_EventApi);
+			s_EventApi->RaiseByHandle(aSignature, aHandle, nullptr);
+		}
+
+		void RaiseEventDeferred(const char* aIdentifier, const void* aEventData, size_t aSize)
+		{
+			assert(s_EventApi);
+			s_EventApi->RaiseDeferred(aIdentifier, aEventData, aSize);
+		}
+
+		void RaiseEventDeferredByHandle(EventHandle aHandle, const void* aEventData, size_t aSize)
+		{
+			assert(s_EventApi);
+			s_EventApi->RaiseDeferredByHandle(aHandle, aEventData, aSize);
+		}
+
+		bool SetCoalescing(const char* aIdentifier, EEventCoalescing aPolicy, unsigned aLimit, size_t aPayloadSize)
+		{
+			assert(s_EventApi);
+			return s_EventApi->SetCoalescing(aIdentifier, aPolicy, aLimit, aPayloadSize);
+		}
+	}
+
+	namespace Functions
+	{
+		FunctionHandle Register(const char* aIdentifier, void* aFunction)
+		{
+			assert(s_FuncRegistry);
+			return s_FuncRegistry->Register(aIdentifier, aFunction);
+		}
+
+		void Deregister(FunctionHandle aHandle)
+		{
+			assert(s_FuncRegistry);
+			s_FuncRegistry->Deregister(aHandle);
+		}
+
+		FunctionHandle GetHandle(const char* aIdentifier)
+		{
+			assert(s_FuncRegistry);
+			return s_FuncRegistry->GetHandle(aIdentifier);
+		}
+
+		void* Query(FunctionHandle aHandle)
+		{
+			assert(s_FuncRegistry);
+			return s_FuncRegistry->Query(aHandle);
+		}
+
+		void Release(FunctionHandle aHandle)
+		{
+			assert(s_FuncRegistry);
+			s_FuncRegistry->Release(aHandle);
+		}
 	}
 
 	namespace GameBinds
@@ -287,13 +420,26 @@ namespace ADDONAPI
 		void LogMessage(ELogLevel aLogLevel, const char* aStr)
 		{
 			assert(s_Logger);
-			s_Logger->LogUnformatted(aLogLevel, "Addon", aStr);
+			/* The return address attributes the message to the addon for its rate limit. */
+			s_Logger->LogUnformatted(aLogLevel, "Addon", aStr, _ReturnAddress());
 		}
 
 		void LogMessage2(ELogLevel aLogLevel, const char* aChannel, const char* aStr)
 		{
 			assert(s_Logger);
-			s_Logger->LogUnformatted(aLogLevel, aChannel, aStr);
+			s_Logger->LogUnformatted(aLogLevel, aChannel, aStr, _ReturnAddress());
+		}
+
+		bool ShouldLog(ELogLevel aLogLevel)
+		{
+			assert(s_Logger);
+			return s_Logger->ShouldLog(aLogLevel);
+		}
+
+		void LogStructured(ELogLevel aLogLevel, const char* aChannel, const char* aEvent, const LogField_t* aFields, uint32_t aFieldCount)
+		{
+			assert(s_Logger);
+			s_Logger->LogStructured(aLogLevel, aChannel, aEvent, aFields, aFieldCount, _ReturnAddress());
 		}
 	}
 
@@ -558,6 +704,7 @@ namespace ADDONAPI
 
 			s_DataLinkApi   = ctx->GetDataLink();
 			s_EventApi      = ctx->GetEventApi();
+			s_FuncRegistry  = ctx->GetFunctionRegistry();
 			s_GameBindsApi  = ctx->GetGameBindsApi();
 			s_InputBindApi  = ctx->GetInputBindApi();
 			s_RawInputApi   = ctx->GetRawInputApi();
@@ -997,6 +1144,121 @@ namespace ADDONAPI
 				api->Fonts.AddFromMemory = UIRoot::Fonts::AddFontFromMemory;
 				api->Fonts.Resize = UIRoot::Fonts::ResizeFont;
 
+				defs = api;
+				break;
+			}
+			case 7:
+			{
+				AddonAPI7_t* api = (AddonAPI7_t*)s_DataLinkApi->ShareResource(dlName.c_str(), GetSize(aVersion));
+				assert(api);
+
+				api->SwapChain = s_RenderCtx->SwapChain;
+				api->ImguiContext = ImGui::GetCurrentContext();
+				api->ImguiMalloc = ImGui::MemAlloc;
+				api->ImguiFree = ImGui::MemFree;
+
+				api->Renderer.Register = UIRoot::GUI::Register;
+				api->Renderer.Deregister = UIRoot::GUI::Deregister;
+
+				api->RequestUpdate = Updater::RequestUpdate;
+
+				api->Log = Logger::LogMessage2;
+				api->ShouldLog = Logger::ShouldLog;
+				api->LogStructured = Logger::LogStructured;
+
+				api->UI.SendAlert = UIRoot::Alerts::Notify;
+				api->UI.RegisterCloseOnEscape = UIRoot::EscapeClosing::Register;
+				api->UI.DeregisterCloseOnEscape = UIRoot::EscapeClosing::Deregister;
+
+				api->Paths.GetGameDirectory = Paths::GetGameDirectory;
+				api->Paths.GetAddonDirectory = Paths::GetAddonDirectory;
+				api->Paths.GetCommonDirectory = Paths::GetCommonDirectory;
+
+				api->MinHook.Create = MH_CreateHook;
+				api->MinHook.Remove = MH_RemoveHook;
+				api->MinHook.Enable = MH_EnableHook;
+				api->MinHook.Disable = MH_DisableHook;
+
+				api->Events.Raise = Events::RaiseEvent;
+				api->Events.RaiseNotification = Events::RaiseNotification;
+				api->Events.RaiseTargeted = Events::RaiseEventTargeted;
+				api->Events.RaiseNotificationTargeted = Events::RaiseNotificationTargeted;
+				api->Events.Subscribe = Events::Subscribe;
+				api->Events.Unsubscribe = Events::Unsubscribe;
+				api->Events.GetHandle = Events::GetHandle;
+				api->Events.RaiseByHandle = Events::RaiseEventByHandle;
+				api->Events.RaiseNotificationByHandle = Events::RaiseNotificationByHandle;
+				api->Events.RaiseTargetedByHandle = Events::RaiseEventTargetedByHandle;
+				api->Events.RaiseNotificationTargetedByHandle = Events::RaiseNotificationTargetedByHandle;
+				api->Events.SubscribeByHandle = Events::SubscribeByHandle;
+				api->Events.UnsubscribeByHandle = Events::UnsubscribeByHandle;
+				api->Events.RaiseDeferred = Events::RaiseEventDeferred;
+				api->Events.RaiseDeferredByHandle = Events::RaiseEventDeferredByHandle;
+				api->Events.SetCoalescing = Events::SetCoalescing;
+
+				api->WndProc.Register = RawInput::Register;
+				api->WndProc.Deregister = RawInput::Deregister;
+				api->WndProc.SendToGameOnly = RawInput::SendWndProcToGame;
+
+				api->InputBinds.Invoke = InputBinds::InvokeInputBind;
+				api->InputBinds.RegisterWithString = InputBinds::RegisterWithString2;
+				api->InputBinds.RegisterWithStruct = InputBinds::RegisterWithStruct2;
+				api->InputBinds.Deregister = InputBinds::Deregister;
+
+				api->GameBinds.PressAsync = GameBinds::PressAsync;
+				api->GameBinds.ReleaseAsync = GameBinds::ReleaseAsync;
+				api->GameBinds.InvokeAsync = GameBinds::InvokeAsync;
+				api->GameBinds.Press = GameBinds::Press;
+				api->GameBinds.Release = GameBinds::Release;
+				api->GameBinds.IsBound = GameBinds::IsBound;
+
+				api->DataLink.Get = DataLink::GetResource;
+				api->DataLink.Share = DataLink::ShareResource;
+				api->DataLink.ShareVersioned = DataLink::ShareVersioned;
+				api->DataLink.BeginWrite = CDataLinkApi::BeginWrite;
+				api->DataLink.EndWrite = CDataLinkApi::EndWrite;
+				api->DataLink.ReadSnapshot = CDataLinkApi::ReadSnapshot;
+				api->DataLink.GetHandle = DataLink::GetHandle;
+				api->DataLink.GetByHandle = DataLink::GetResourceByHandle;
+				api->DataLink.Release = DataLink::ReleaseResource;
+				api->DataLink.ShareTripleBuffer = DataLink::ShareTripleBuffer;
+				api->DataLink.BeginPublish = CDataLinkApi::BeginPublish;
+				api->DataLink.EndPublish = CDataLinkApi::EndPublish;
+				api->DataLink.ReadLatest = CDataLinkApi::ReadLatest;
+
+				api->Textures.Get = TextureLoader::Get;
+				api->Textures.GetOrCreateFromFile = TextureLoader::GetOrCreateFromFile;
+				api->Textures.GetOrCreateFromResource = TextureLoader::GetOrCreateFromResource;
+				api->Textures.GetOrCreateFromURL = TextureLoader::GetOrCreateFromURL;
+				api->Textures.GetOrCreateFromMemory = TextureLoader::GetOrCreateFromMemory;
+				api->Textures.LoadFromFile = TextureLoader::LoadFromFile;
+				api->Textures.LoadFromResource = TextureLoader::LoadFromResource;
+				api->Textures.LoadFromURL = TextureLoader::LoadFromURL;
+				api->Textures.LoadFromMemory = TextureLoader::LoadFromMemory;
+
+				api->QuickAccess.Add = UIRoot::QuickAccess::AddShortcut;
+				api->QuickAccess.Remove = UIRoot::QuickAccess::RemoveShortcut;
+				api->QuickAccess.Notify = UIRoot::QuickAccess::NotifyShortcut;
+				api->QuickAccess.AddContextMenu = UIRoot::QuickAccess::AddContextItem2;
+				api->QuickAccess.RemoveContextMenu = UIRoot::QuickAccess::RemoveContextItem;
+
+				api->Localization.Translate = Localization::Translate;
+				api->Localization.TranslateTo = Localization::TranslateTo;
+				api->Localization.SetTranslatedString = Localization::Set;
+
+				api->Fonts.Get = UIRoot::Fonts::Get;
+				api->Fonts.Release = UIRoot::Fonts::Release;
+				api->Fonts.AddFromFile = UIRoot::Fonts::AddFontFromFile;
+				api->Fonts.AddFromResource = UIRoot::Fonts::AddFontFromResource;
+				api->Fonts.AddFromMemory = UIRoot::Fonts::AddFontFromMemory;
+				api->Fonts.Resize = UIRoot::Fonts::ResizeFont;
+
+				api->Functions.Register = Functions::Register;
+				api->Functions.Deregister = Functions::Deregister;
+				api->Functions.GetHandle = Functions::GetHandle;
+				api->Functions.Query = Functions::Query;
+				api->Functions.Release = Functions::Release;
+
 				defs = api;
 				break;
 			}
@@ -1021,6 +1283,8 @@ namespace ADDONAPI
 				return sizeof(AddonAPI5_t);
 			case 6:
 				return sizeof(AddonAPI6_t);
+			case 7:
+				return sizeof(AddonAPI7_t);
 		}
 
 		return 0;
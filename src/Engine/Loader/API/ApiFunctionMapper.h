@@ -12,11 +12,14 @@
 #include <Windows.h>
 
 #include "AddonAPI.h"
+#include "Engine/DataLink/DlFuncDefs.h"
 #include "Engine/Events/EvtFuncDefs.h"
+#include "Engine/Functions/FnFuncDefs.h"
 #include "GW2/Inputs/GameBinds/GbEnum.h"
 #include "Engine/Inputs/InputBinds/IbFuncDefs.h"
 #include "Engine/Inputs/RawInput/RiFuncDefs.h"
 #include "Engine/Logging/LogEnum.h"
+#include "Engine/Logging/LogField.h"
 #include "Engine/Textures/TxFuncDefs.h"
 #include "UI/FuncDefs.h"
 #include "UI/Services/Fonts/FuncDefs.h"
@@ -42,6 +45,36 @@ namespace ADDONAPI
 		/// 	Addon_t API wrapper function for ShareResource.
 		///----------------------------------------------------------------------------------------------------
 		void* ShareResource(const char* aIdentifier, size_t aResourceSize);
+
+		///----------------------------------------------------------------------------------------------------
+		/// ShareVersioned:
+		/// 	[Revision 7] Addon_t API wrapper function for ShareVersionedResource.
+		///----------------------------------------------------------------------------------------------------
+		void* ShareVersioned(const char* aIdentifier, size_t aResourceSize);
+
+		///----------------------------------------------------------------------------------------------------
+		/// ShareTripleBuffer:
+		/// 	[Revision 7] Addon_t API wrapper function for ShareTripleBuffer.
+		///----------------------------------------------------------------------------------------------------
+		void* ShareTripleBuffer(const char* aIdentifier, size_t aResourceSize);
+
+		///----------------------------------------------------------------------------------------------------
+		/// GetHandle:
+		/// 	[Revision 7] Addon_t API wrapper function for GetHandle.
+		///----------------------------------------------------------------------------------------------------
+		DataLinkHandle GetHandle(const char* aIdentifier);
+
+		///----------------------------------------------------------------------------------------------------
+		/// GetResourceByHandle:
+		/// 	[Revision 7] Addon_t API wrapper function for GetResource by handle.
+		///----------------------------------------------------------------------------------------------------
+		void* GetResourceByHandle(DataLinkHandle aHandle);
+
+		///----------------------------------------------------------------------------------------------------
+		/// ReleaseResource:
+		/// 	[Revision 7] Addon_t API wrapper function for ReleaseResource.
+		///----------------------------------------------------------------------------------------------------
+		void ReleaseResource(const char* aIdentifier);
 	}
 
 	///----------------------------------------------------------------------------------------------------
@@ -84,6 +117,102 @@ namespace ADDONAPI
 		/// 	Addon_t API wrapper function for raising notifications targeted at a specific subscriber.
 		///----------------------------------------------------------------------------------------------------
 		void RaiseNotificationTargeted(signed int aSignature, const char* aIdentifier);
+
+		///----------------------------------------------------------------------------------------------------
+		/// GetHandle:
+		/// 	Addon_t API wrapper function for interning an event identifier.
+		///----------------------------------------------------------------------------------------------------
+		EventHandle GetHandle(const char* aIdentifier);
+
+		///----------------------------------------------------------------------------------------------------
+		/// SubscribeByHandle:
+		/// 	Addon_t API wrapper function for subscribing to events by handle.
+		///----------------------------------------------------------------------------------------------------
+		void SubscribeByHandle(EventHandle aHandle, EVENT_CONSUME aConsumeEventCallback);
+
+		///----------------------------------------------------------------------------------------------------
+		/// UnsubscribeByHandle:
+		/// 	Addon_t API wrapper function for unsubscribing from events by handle.
+		///----------------------------------------------------------------------------------------------------
+		void UnsubscribeByHandle(EventHandle aHandle, EVENT_CONSUME aConsumeEventCallback);
+
+		///----------------------------------------------------------------------------------------------------
+		/// RaiseEventByHandle:
+		/// 	Addon_t API wrapper function for raising events by handle.
+		///----------------------------------------------------------------------------------------------------
+		void RaiseEventByHandle(EventHandle aHandle, void* aEventData);
+
+		///----------------------------------------------------------------------------------------------------
+		/// RaiseNotificationByHandle:
+		/// 	Addon_t API wrapper function for raising events without payloads by handle.
+		///----------------------------------------------------------------------------------------------------
+		void RaiseNotificationByHandle(EventHandle aHandle);
+
+		///----------------------------------------------------------------------------------------------------
+		/// RaiseEventTargetedByHandle:
+		/// 	Addon_t API wrapper function for raising events targeted at a specific subscriber by handle.
+		///----------------------------------------------------------------------------------------------------
+		void RaiseEventTargetedByHandle(signed int aSignature, EventHandle aHandle, void* aEventData);
+
+		///----------------------------------------------------------------------------------------------------
+		/// RaiseNotificationTargetedByHandle:
+		/// 	Addon_t API wrapper function for raising notifications targeted at a specific subscriber by handle.
+		///----------------------------------------------------------------------------------------------------
+		void RaiseNotificationTargetedByHandle(signed int aSignature, EventHandle aHandle);
+
+		///----------------------------------------------------------------------------------------------------
+		/// RaiseEventDeferred:
+		/// 	Addon_t API wrapper function for raising events dispatched at the next frame.
+		///----------------------------------------------------------------------------------------------------
+		void RaiseEventDeferred(const char* aIdentifier, const void* aEventData, size_t aSize);
+
+		///----------------------------------------------------------------------------------------------------
+		/// RaiseEventDeferredByHandle:
+		/// 	Addon_t API wrapper function for raising events dispatched at the next frame by handle.
+		///----------------------------------------------------------------------------------------------------
+		void RaiseEventDeferredByHandle(EventHandle aHandle, const void* aEventData, size_t aSize);
+
+		///----------------------------------------------------------------------------------------------------
+		/// SetCoalescing:
+		/// 	Addon_t API wrapper function for setting the coalescing policy of an event.
+		///----------------------------------------------------------------------------------------------------
+		bool SetCoalescing(const char* aIdentifier, EEventCoalescing aPolicy, unsigned aLimit, size_t aPayloadSize);
+	}
+
+	///----------------------------------------------------------------------------------------------------
+	/// Functions Namespace
+	///----------------------------------------------------------------------------------------------------
+	namespace Functions
+	{
+		///----------------------------------------------------------------------------------------------------
+		/// Register:
+		/// 	[Revision 7] Addon_t API wrapper function for registering a function.
+		///----------------------------------------------------------------------------------------------------
+		FunctionHandle Register(const char* aIdentifier, void* aFunction);
+
+		///----------------------------------------------------------------------------------------------------
+		/// Deregister:
+		/// 	[Revision 7] Addon_t API wrapper function for deregistering a function.
+		///----------------------------------------------------------------------------------------------------
+		void Deregister(FunctionHandle aHandle);
+
+		///----------------------------------------------------------------------------------------------------
+		/// GetHandle:
+		/// 	[Revision 7] Addon_t API wrapper function for looking up the handle of a function.
+		///----------------------------------------------------------------------------------------------------
+		FunctionHandle GetHandle(const char* aIdentifier);
+
+		///----------------------------------------------------------------------------------------------------
+		/// Query:
+		/// 	[Revision 7] Addon_t API wrapper function for acquiring a function.
+		///----------------------------------------------------------------------------------------------------
+		void* Query(FunctionHandle aHandle);
+
+		///----------------------------------------------------------------------------------------------------
+		/// Release:
+		/// 	[Revision 7] Addon_t API wrapper function for releasing a function.
+		///----------------------------------------------------------------------------------------------------
+		void Release(FunctionHandle aHandle);
 	}
 
 	///----------------------------------------------------------------------------------------------------
@@ -259,6 +388,19 @@ namespace ADDONAPI
 		/// 	[Revision 2] Logs a message with a custom channel.
 		///----------------------------------------------------------------------------------------------------
 		void LogMessage2(ELogLevel aLogLevel, const char* aChannel, const char* aStr);
+
+		///----------------------------------------------------------------------------------------------------
+		/// ShouldLog:
+		/// 	[Revision 7] Returns true, if a message of the given level would be logged at all.
+		/// 	Allows skipping the formatting and argument evaluation of discarded messages.
+		///----------------------------------------------------------------------------------------------------
+		bool ShouldLog(ELogLevel aLogLevel);
+
+		///----------------------------------------------------------------------------------------------------
+		/// LogStructured:
+		/// 	[Revision 7] Logs an event with typed key/value fields.
+		///----------------------------------------------------------------------------------------------------
+		void LogStructured(ELogLevel aLogLevel, const char* aChannel, const char* aEvent, const LogField_t* aFields, uint32_t aFieldCount);
 	}
 
 	///----------------------------------------------------------------------------------------------------
@@ -0,0 +1,23 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  AddonRange.h
+/// Description  :  Contains the AddonRange_t struct definition.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef ADDONRANGE_H
+#define ADDONRANGE_H
+
+///----------------------------------------------------------------------------------------------------
+/// AddonRange_t Struct
+/// 	Address space of a loaded addon, copied out of its Addon_t.
+///----------------------------------------------------------------------------------------------------
+struct AddonRange_t
+{
+	void*      Start;
+	void*      End;       /* Inclusive, like the Verify ranges. */
+	signed int Signature;
+};
+
+#endif
@@ -8,6 +8,7 @@
 
 #include "Loader.h"
 
+#include <algorithm>
 #include <chrono>
 #include <Psapi.h>
 #include <regex>
@@ -71,6 +72,9 @@ namespace Loader
 		ELoaderAction
 	>                       QueuedAddons;
 	std::vector<Addon_t*>     Addons;
+	std::shared_ptr<
+		const std::vector<AddonRange_t>
+	>                       AddonRanges;
 	bool                    HasCustomConfig;
 	std::filesystem::path   ConfigPath;
 	std::vector<signed int> RequestedAddons;
@@ -113,6 +117,40 @@ namespace Loader
 		NexusLink = (NexusLinkData_t*)DataLink->ShareResource(DL_NEXUS_LINK, sizeof(NexusLinkData_t), "", true);
 		MumbleIdentity = (Mumble::Identity*)DataLink->ShareResource(DL_MUMBLE_LINK_IDENTITY, sizeof(Mumble::Identity), "", false);
 
+		/* Mirror the configured events into the public event stream. Entries are "Identifier" or "Identifier:PayloadSize". */
+		std::vector<std::string> streamedEvents = ctx->GetSettingsCtx()->Get<std::vector<std::string>>(OPT_EVENTSTREAM);
+
+		if (!streamedEvents.empty() && ctx->GetEventStream()->Initialize())
+		{
+			EventApi->SetStream(ctx->GetEventStream());
+
+			for (const std::string& entry : streamedEvents)
+			{
+				std::vector<std::string> parts = String::Split(entry, ":");
+
+				if (parts.empty() || parts[0].empty())
+				{
+					continue;
+				}
+
+				size_t payloadSize = 0;
+
+				if (parts.size() > 1)
+				{
+					try
+					{
+						payloadSize = std::stoul(parts[1]);
+					}
+					catch (...)
+					{
+						Logger->Warning(CH_LOADER, "Invalid payload size for streamed event \"%s\".", entry.c_str());
+					}
+				}
+
+				EventApi->SetStreamed(parts[0].c_str(), true, payloadSize);
+			}
+		}
+
 		ConfigPath = Index(EPath::AddonConfigDefault);
 
 		if (CmdLine::HasArgument("-ggaddons"))
@@ -901,6 +939,9 @@ namespace Loader
 		GetModuleInformation(GetCurrentProcess(), addon->Module, &moduleInfo, sizeof(moduleInfo));
 		addon->ModuleSize = moduleInfo.SizeOfImage;
 
+		/* Before Load, so the addon is already attributed while it loads. */
+		PublishAddonRanges();
+
 		auto start_time = std::chrono::high_resolution_clock::now();
 		addon->Definitions->Load(api);
 		auto end_time = std::chrono::high_resolution_clock::now();
@@ -973,7 +1014,16 @@ namespace Loader
 			int kbRefs = ctx->GetInputBindApi()->Verify(startAddress, endAddress);
 			int riRefs = ctx->GetRawInputApi()->Verify(startAddress, endAddress);
 			int txRefs = ctx->GetTextureService()->Verify(startAddress, endAddress);
-			int leftoverRefs = evRefs + uiRefs + qaRefs + kbRefs + riRefs + txRefs;
+			int frRefs = ctx->GetFunctionRegistry()->Verify(startAddress, endAddress);
+
+			/* Not a leak, DataLink references are held until unload. Freed with the module, see FreeAddon. */
+			int dlRefs = DataLink->Verify(startAddress, endAddress);
+
+			if (dlRefs > 0)
+			{
+				Logger->Debug(CH_LOADER, "Dropped %d DataLink references of \"%s\".", dlRefs, aPath.filename().string().c_str());
+			}
+			int leftoverRefs = evRefs + uiRefs + qaRefs + kbRefs + riRefs + txRefs + frRefs;
 
 			if (leftoverRefs > 0)
 			{
@@ -987,7 +1037,8 @@ namespace Loader
 				if (qaRefs) { str.append(String::Format("QuickAccess: %d\n", qaRefs)); }
 				if (kbRefs) { str.append(String::Format("InputBinds: %d\n", kbRefs)); }
 				if (riRefs) { str.append(String::Format("WndProc: %d\n", riRefs)); }
-				if (txRefs) { str.append(String::Format("Textures: %d", txRefs)); }
+				if (txRefs) { str.append(String::Format("Textures: %d\n", txRefs)); }
+				if (frRefs) { str.append(String::Format("Functions: %d", frRefs)); }
 				Logger->Warning(CH_LOADER, str.c_str());
 			}
 		}
@@ -1082,8 +1133,13 @@ namespace Loader
 		addon->Module = nullptr;
 		addon->ModuleSize = 0;
 
+		PublishAddonRanges();
+
 		addon->State = EAddonState::NotLoaded;
 
+		/* The module is gone, nothing of it can still touch resources only it referenced. */
+		DataLink->Reclaim();
+
 		SaveAddonConfig(); // no need to check if this is a shutdown, SaveAddonConfig checks that and prevents saving
 
 		if (!std::filesystem::exists(aPath))
@@ -1232,6 +1288,49 @@ namespace Loader
 		return "(null)";
 	}
 
+	signed int GetOwnerSignature(void* aAddress)
+	{
+		/* Called from any thread, e.g. by addons logging while another addon loads. */
+		std::shared_ptr<const std::vector<AddonRange_t>> ranges = std::atomic_load(&AddonRanges);
+
+		if (!ranges) { return 0; }
+
+		/* Last range starting at or below the address. */
+		auto it = std::upper_bound(ranges->begin(), ranges->end(), aAddress, [](void* aValue, const AddonRange_t& aRange) {
+			return aValue < aRange.Start;
+		});
+
+		if (it == ranges->begin()) { return 0; }
+
+		it--;
+
+		return aAddress <= it->End ? it->Signature : 0;
+	}
+
+	void PublishAddonRanges()
+	{
+		std::vector<AddonRange_t> ranges;
+
+		for (Addon_t* addon : Addons)
+		{
+			if (addon->Module == nullptr ||
+				addon->ModuleSize == 0 ||
+				addon->Definitions == nullptr ||
+				addon->Definitions->Signature == 0)
+			{
+				continue;
+			}
+
+			ranges.push_back(AddonRange_t{ addon->Module, ((PBYTE)addon->Module) + addon->ModuleSize, addon->Definitions->Signature });
+		}
+
+		std::sort(ranges.begin(), ranges.end(), [](const AddonRange_t& aLeft, const AddonRange_t& aRight) {
+			return aLeft.Start < aRight.Start;
+		});
+
+		std::atomic_store(&AddonRanges, std::shared_ptr<const std::vector<AddonRange_t>>(std::make_shared<std::vector<AddonRange_t>>(std::move(ranges))));
+	}
+
 	Addon_t* FindAddonBySig(signed int aSignature)
 	{
 		auto it = std::find_if(Addons.begin(), Addons.end(), [aSignature](Addon_t* addon) { return addon->Definitions && addon->Definitions->Signature == aSignature; });
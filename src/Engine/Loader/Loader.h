@@ -9,6 +9,7 @@
 #ifndef LOADER_H
 #define LOADER_H
 
+#include <memory>
 #include <mutex>
 #include <map>
 #include <vector>
@@ -20,6 +21,7 @@
 
 #include "ELoaderAction.h"
 #include "Addon.h"
+#include "AddonRange.h"
 #include "API/AddonAPI.h"
 
 #include "Engine/Loader/NexusLinkData.h"
@@ -37,6 +39,9 @@ namespace Loader
 		ELoaderAction
 	>                              QueuedAddons; /* To be loaded or unloaded addons */
 	extern std::vector<Addon_t*>     Addons;
+	extern std::shared_ptr<
+		const std::vector<AddonRange_t>
+	>                              AddonRanges;  /* Sorted by Start. Replaced, never modified, read with std::atomic_load. */
 	extern bool                    HasCustomConfig;
 	extern std::filesystem::path   ConfigPath;
 
@@ -144,6 +149,20 @@ namespace Loader
 	///----------------------------------------------------------------------------------------------------
 	std::string GetOwner(void* aAddress);
 
+	///----------------------------------------------------------------------------------------------------
+	/// GetOwnerSignature:
+	/// 	Returns the signature of the addon owning the provided address or 0.
+	/// 	Safe from any thread, also while an addon loads. Looks up the AddonRanges, not the Addons.
+	///----------------------------------------------------------------------------------------------------
+	signed int GetOwnerSignature(void* aAddress);
+
+	///----------------------------------------------------------------------------------------------------
+	/// PublishAddonRanges:
+	/// 	Rebuilds the AddonRanges from the loaded addons. Must be called with the Mutex held,
+	/// 	whenever a module is loaded or freed.
+	///----------------------------------------------------------------------------------------------------
+	void PublishAddonRanges();
+
 	///----------------------------------------------------------------------------------------------------
 	/// FindAddonBySig:
 	/// 	Returns the addon with a matching signature or nullptr.
@@ -9,7 +9,8 @@
 #ifndef NEXUSLINKDATA_H
 #define NEXUSLINKDATA_H
 
-constexpr const char* DL_NEXUS_LINK = "DL_NEXUS_LINK";
+constexpr const char* DL_NEXUS_LINK           = "DL_NEXUS_LINK";
+constexpr const char* DL_NEXUS_LINK_VERSIONED = "DL_NEXUS_LINK_VERSIONED"; /* Copy published once per frame. Read with CDataLinkApi::ReadSnapshot. */
 
 ///----------------------------------------------------------------------------------------------------
 /// NexusLinkData_t Struct
@@ -8,21 +8,94 @@
 
 #include "LogApi.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 
 #include "Util/Time.h"
 
-CLogApi::~CLogApi()
+/* Amount of loggers currently processing a message on this thread. Used to avoid waiting on ourselves. */
+static thread_local int s_DispatchDepth = 0;
+
+///----------------------------------------------------------------------------------------------------
+/// GetTickMs:
+/// 	Returns the milliseconds of the steady clock.
+///----------------------------------------------------------------------------------------------------
+static long long GetTickMs()
 {
-	const std::lock_guard<std::mutex> lock(this->Mutex);
+	return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+///----------------------------------------------------------------------------------------------------
+/// Refill:
+/// 	Refills the bucket for the time passed since the last refill. Returns true, if a token is available.
+///----------------------------------------------------------------------------------------------------
+static bool Refill(LogBucket_t& aBucket, const LogRateLimit_t& aLimit, long long aNow)
+{
+	double burst = (double)(std::max)(aLimit.Burst, aLimit.Rate);
+
+	/* New buckets start full. */
+	if (aBucket.LastRefill == 0)
+	{
+		aBucket.Tokens = burst;
+	}
+	else
+	{
+		aBucket.Tokens = (std::min)(burst, aBucket.Tokens + (double)(aNow - aBucket.LastRefill) * aLimit.Rate / 1000.0);
+	}
+
+	aBucket.LastRefill = aNow;
+
+	return aBucket.Tokens >= 1.0;
+}
 
-	for (auto it = this->Messages.begin(); it != this->Messages.end();)
+///----------------------------------------------------------------------------------------------------
+/// IsIdle:
+/// 	Returns true, if the bucket would be full again and has nothing to summarize.
+///----------------------------------------------------------------------------------------------------
+static bool IsIdle(const LogBucket_t& aBucket, const LogRateLimit_t& aLimit, long long aNow)
+{
+	double burst = (double)(std::max)(aLimit.Burst, aLimit.Rate);
+
+	return aBucket.Suppressed == 0 && aBucket.Tokens + (double)(aNow - aBucket.LastRefill) * aLimit.Rate / 1000.0 >= burst;
+}
+
+CLogApi::CLogApi(size_t aQueueCapacity, size_t aRetentionBytes, size_t aRetentionCount, LOGGER_RESOLVEOWNER aResolveOwner)
+{
+	this->ResolveOwner = aResolveOwner;
+
+	this->MaxChunks  = (std::max)(aRetentionBytes / LOG_ARENA_CHUNK_SIZE, (size_t)1);
+	this->MaxRecords = (std::max)(aRetentionCount, (size_t)1);
+
+	size_t capacity = 2;
+	while (capacity < aQueueCapacity) { capacity <<= 1; }
+
+	this->Queue = std::make_unique<LogQueueSlot_t[]>(capacity);
+	this->QueueMask = capacity - 1;
+
+	for (size_t i = 0; i < capacity; i++)
 	{
-		LogMsg_t* msg = *it;
+		this->Queue[i].Sequence.store(i, std::memory_order_relaxed);
+	}
 
-		delete msg;
-		it = this->Messages.erase(it);
+	this->IsRunning = true;
+	this->ProcessorThread = std::thread(&CLogApi::Process, this);
+}
+
+CLogApi::~CLogApi()
+{
+	if (this->ProcessorThread.joinable())
+	{
+		this->IsRunning = false;
+		this->ProcessorConVar.notify_one();
+		this->ProcessorThread.join();
 	}
+
+	/* Store whatever was logged after the processor stopped. */
+	this->Flush();
 }
 
 void CLogApi::Register(ILogger* aLogger)
@@ -32,16 +105,23 @@ void CLogApi::Register(ILogger* aLogger)
 	const std::lock_guard<std::mutex> lock(this->Mutex);
 
 	this->Registry.push_back(aLogger);
+	this->UpdateMaxLevel();
+
+	/* Replay all retained log messages. */
+	s_DispatchDepth++;
 
-	/* Replay all log messages. */
-	for (LogMsg_t* msg : this->Messages)
+	for (size_t i = 0; i < this->RecordCount; i++)
 	{
+		const LogRecord_t& record = this->Records[(this->RecordHead + i) % this->MaxRecords];
+
 		/* Must match logger filter. */
-		if (msg->Level <= aLogger->GetLogLevel())
+		if (record.Level <= aLogger->GetLogLevel())
 		{
-			aLogger->MsgProc(msg);
+			aLogger->MsgProc(this->Materialize(record));
 		}
 	}
+
+	s_DispatchDepth--;
 }
 
 void CLogApi::Deregister(ILogger* aLogger)
@@ -52,50 +132,63 @@ void CLogApi::Deregister(ILogger* aLogger)
 
 	auto it = std::find(this->Registry.begin(), this->Registry.end(), aLogger);
 
+	if (it == this->Registry.end()) { return; }
+
 	this->Registry.erase(it);
+	this->UpdateMaxLevel();
 }
 
-void CLogApi::Trace(const std::string& aChannel, const char* aFmt, ...)
+void CLogApi::Trace(const char* aChannel, const char* aFmt, ...)
 {
+	if (!this->ShouldLog(ELogLevel::TRACE)) { return; }
+
 	va_list args;
 	va_start(args, aFmt);
 	this->LogV(ELogLevel::TRACE, aChannel, aFmt, args);
 	va_end(args);
 }
 
-void CLogApi::Critical(const std::string& aChannel, const char* aFmt, ...)
+void CLogApi::Critical(const char* aChannel, const char* aFmt, ...)
 {
+	if (!this->ShouldLog(ELogLevel::CRITICAL)) { return; }
+
 	va_list args;
 	va_start(args, aFmt);
 	this->LogV(ELogLevel::CRITICAL, aChannel, aFmt, args);
 	va_end(args);
 }
 
-void CLogApi::Warning(const std::string& aChannel, const char* aFmt, ...)
+void CLogApi::Warning(const char* aChannel, const char* aFmt, ...)
 {
+	if (!this->ShouldLog(ELogLevel::WARNING)) { return; }
+
 	va_list args;
 	va_start(args, aFmt);
 	this->LogV(ELogLevel::WARNING, aChannel, aFmt, args);
 	va_end(args);
 }
 
-void CLogApi::Info(const std::string& aChannel, const char* aFmt, ...)
+void CLogApi::Info(const char* aChannel, const char* aFmt, ...)
 {
+	if (!this->ShouldLog(ELogLevel::INFO)) { return; }
+
 	va_list args;
 	va_start(args, aFmt);
 	this->LogV(ELogLevel::INFO, aChannel, aFmt, args);
 	va_end(args);
 }
 
-void CLogApi::Debug(const std::string& aChannel, const char* aFmt, ...)
+void CLogApi::Debug(const char* aChannel, const char* aFmt, ...)
 {
+	if (!this->ShouldLog(ELogLevel::DEBUG)) { return; }
+
 	va_list args;
 	va_start(args, aFmt);
 	this->LogV(ELogLevel::DEBUG, aChannel, aFmt, args);
 	va_end(args);
 }
 
-void CLogApi::Log(ELogLevel aLogLevel, std::string aChannel, const char* aFmt, ...)
+void CLogApi::Log(ELogLevel aLogLevel, const char* aChannel, const char* aFmt, ...)
 {
 	/* Clean log level. */
 	if (aLogLevel == ELogLevel::OFF || aLogLevel == ELogLevel::ALL)
@@ -103,47 +196,460 @@ void CLogApi::Log(ELogLevel aLogLevel, std::string aChannel, const char* aFmt, .
 		aLogLevel = ELogLevel::TRACE;
 	}
 
+	if (!this->ShouldLog(aLogLevel)) { return; }
+
 	va_list args;
 	va_start(args, aFmt);
 	this->LogV(aLogLevel, aChannel, aFmt, args);
 	va_end(args);
 }
 
-void CLogApi::LogV(ELogLevel aLogLevel, std::string aChannel, const char* aFmt, va_list aArgs)
+void CLogApi::LogV(ELogLevel aLogLevel, const char* aChannel, const char* aFmt, va_list aArgs)
 {
+	if (!this->ShouldLog(aLogLevel) || !aFmt) { return; }
+
+	if (!aChannel) { aChannel = ""; }
+
+	if (!this->Admit(aLogLevel, aChannel, nullptr)) { return; }
+
+	/* Capture the arguments, formatting happens on the processor thread. */
+	uint32_t formatId = this->IsDeferredFormatting ? this->InternFormat(aFmt) : 0;
+
+	if (formatId != 0)
+	{
+		static thread_local std::string s_Args;
+		s_Args.clear();
+
+		{
+			std::shared_lock<std::shared_mutex> lock(this->FormatMutex);
+			LogBinary::Capture(*this->Formats[formatId - 1], aArgs, s_Args);
+		}
+
+		this->Push(aLogLevel, aChannel, s_Args.data(), s_Args.size(), formatId);
+		return;
+	}
+
 	char buffer[4096]{};
-	vsprintf_s(buffer, 4095, aFmt, aArgs); // 4096-1 for guaranteed null terminator
+	vsnprintf(buffer, 4095, aFmt, aArgs); // 4096-1 for guaranteed null terminator
+
+	this->Push(aLogLevel, aChannel, &buffer[0], strlen(buffer), 0);
+}
+
+void CLogApi::LogUnformatted(ELogLevel aLogLevel, const char* aChannel, const char* aMsg, void* aCaller)
+{
+	if (!aMsg || !this->ShouldLog(aLogLevel)) { return; }
+
+	if (!aChannel) { aChannel = ""; }
+
+	if (!this->Admit(aLogLevel, aChannel, aCaller)) { return; }
+
+	this->Push(aLogLevel, aChannel, aMsg, strlen(aMsg), 0);
+}
+
+void CLogApi::LogStructured(ELogLevel aLogLevel, const char* aChannel, const char* aEvent, const LogField_t* aFields, uint32_t aFieldCount, void* aCaller)
+{
+	if (!aEvent || !this->ShouldLog(aLogLevel)) { return; }
+
+	if (!aChannel) { aChannel = ""; }
+
+	if (!this->Admit(aLogLevel, aChannel, aCaller)) { return; }
+
+	static thread_local std::string s_Fields;
+	s_Fields.clear();
+
+	LogBinary::CaptureFields(aEvent, aFields, aFieldCount, s_Fields);
+
+	this->Push(aLogLevel, aChannel, s_Fields.data(), s_Fields.size(), LOG_FORMAT_STRUCTURED);
+}
+
+void CLogApi::SetDeferredFormatting(bool aEnabled)
+{
+	this->IsDeferredFormatting = aEnabled;
+}
+
+bool CLogApi::Admit(ELogLevel aLogLevel, const char* aChannel, void* aCaller)
+{
+	if (!this->IsRateLimited || aLogLevel == ELogLevel::CRITICAL) { return true; }
+
+	/* Resolved outside of the lock. */
+	signed int owner = (aCaller && this->ResolveOwner) ? this->ResolveOwner(aCaller) : 0;
+
+	long long now = GetTickMs();
+
+	const std::lock_guard<std::mutex> lock(this->LimiterMutex);
+
+	LogBucket_t* channel    = nullptr;
+	LogBucket_t* addon      = nullptr;
+	bool         isAdmitted = true;
+
+	if (this->ChannelLimit.Rate > 0)
+	{
+		channel = &this->ChannelBuckets[aChannel];
+		isAdmitted &= Refill(*channel, this->ChannelLimit, now);
+	}
+
+	if (owner != 0 && this->AddonLimit.Rate > 0)
+	{
+		addon = &this->AddonBuckets[owner];
+		isAdmitted &= Refill(*addon, this->AddonLimit, now);
+	}
+
+	if (!isAdmitted)
+	{
+		/* Counted against whichever bucket ran dry. */
+		if (channel && channel->Tokens < 1.0) { channel->Suppressed++; }
+		if (addon && addon->Tokens < 1.0) { addon->Suppressed++; }
+		return false;
+	}
+
+	if (channel) { channel->Tokens -= 1.0; }
+	if (addon) { addon->Tokens -= 1.0; }
+
+	return true;
+}
+
+void CLogApi::Push(ELogLevel aLogLevel, const char* aChannel, const char* aData, size_t aSize, uint32_t aFormatID)
+{
+	while (!this->Enqueue(aLogLevel, aChannel, aData, aSize, aFormatID))
+	{
+		/* Only critical messages and warnings are worth stalling the caller. */
+		if (aLogLevel != ELogLevel::CRITICAL && aLogLevel != ELogLevel::WARNING)
+		{
+			this->AmountDropped++;
+			return;
+		}
+
+		/* No processor to wait for, make room on this thread. Drop, if this is a logger logging from within its MsgProc. */
+		if (!this->IsRunning)
+		{
+			std::unique_lock<std::timed_mutex> lock(this->ConsumerMutex, std::try_to_lock);
+
+			if (!lock.owns_lock())
+			{
+				this->AmountDropped++;
+				return;
+			}
+
+			this->ProcessQueue();
+			continue;
+		}
+
+		/* A logger logging from within its MsgProc would wait for itself, the queue only drains once it returns. */
+		if (s_DispatchDepth > 0)
+		{
+			this->AmountDropped++;
+			return;
+		}
+
+		std::this_thread::yield();
+	}
+
+	if (!this->IsRunning)
+	{
+		/* Shutting down, don't leave the message queued. */
+		std::unique_lock<std::timed_mutex> lock(this->ConsumerMutex, std::try_to_lock);
+
+		if (lock.owns_lock())
+		{
+			this->ProcessQueue();
+		}
+	}
+	else if (this->IsWaiting)
+	{
+		this->ProcessorConVar.notify_one();
+	}
+}
+
+bool CLogApi::Flush()
+{
+	/* Bounded wait, the thread holding the lock might be the one that crashed. */
+	std::unique_lock<std::timed_mutex> lock(this->ConsumerMutex, std::chrono::seconds(1));
+
+	if (!lock.owns_lock())
+	{
+		return false;
+	}
+
+	this->ProcessQueue();
+
+	return true;
+}
+
+uint32_t CLogApi::InternFormat(const char* aFmt)
+{
+	{
+		std::shared_lock<std::shared_mutex> lock(this->FormatMutex);
+
+		auto it = this->FormatLookup.find(aFmt);
+
+		/* The address could be reused by a different string, after an addon was unloaded. */
+		if (it != this->FormatLookup.end() && strcmp(this->Formats[it->second - 1]->Format.c_str(), aFmt) == 0)
+		{
+			return this->Formats[it->second - 1]->IsCapturable ? it->second : 0;
+		}
+	}
+
+	std::unique_lock<std::shared_mutex> lock(this->FormatMutex);
+
+	if (this->Formats.size() >= LOG_MAX_FORMATS)
+	{
+		return 0;
+	}
+
+	this->Formats.push_back(std::make_unique<LogFormat_t>(LogBinary::Parse(aFmt)));
+
+	uint32_t id = (uint32_t)this->Formats.size();
+	this->FormatLookup[aFmt] = id;
+
+	return this->Formats[id - 1]->IsCapturable ? id : 0;
+}
+
+bool CLogApi::Enqueue(ELogLevel aLogLevel, const char* aChannel, const char* aData, size_t aSize, uint32_t aFormatID)
+{
+	LogQueueSlot_t* slot = nullptr;
+	size_t pos = this->EnqueuePos.load(std::memory_order_relaxed);
+
+	for (;;)
+	{
+		slot = &this->Queue[pos & this->QueueMask];
+		size_t seq = slot->Sequence.load(std::memory_order_acquire);
+		intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+		if (diff == 0)
+		{
+			if (this->EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (diff < 0)
+		{
+			/* Full. */
+			return false;
+		}
+		else
+		{
+			pos = this->EnqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+
+	slot->Level           = aLogLevel;
+	slot->Time            = Time::GetTimestamp();
+	slot->TimeMsPrecision = Time::GetMilliseconds();
+	slot->Channel.assign(aChannel);
+	slot->Message.assign(aData, aSize);
+	slot->FormatID        = aFormatID;
+
+	slot->Sequence.store(pos + 1, std::memory_order_release);
+
+	this->QueueSize++;
+
+	return true;
+}
+
+void CLogApi::ProcessQueue()
+{
+	for (;;)
+	{
+		LogQueueSlot_t& slot = this->Queue[this->DequeuePos & this->QueueMask];
+
+		if (slot.Sequence.load(std::memory_order_acquire) != this->DequeuePos + 1)
+		{
+			break;
+		}
+
+		if (slot.FormatID == LOG_FORMAT_STRUCTURED)
+		{
+			this->Store(slot.Level, slot.Time, slot.TimeMsPrecision, slot.Channel, slot.Message, nullptr, 0, nullptr, true);
+		}
+		else if (slot.FormatID != 0)
+		{
+			const LogFormat_t* format = nullptr;
+
+			{
+				std::shared_lock<std::shared_mutex> lock(this->FormatMutex);
+				format = this->Formats[slot.FormatID - 1].get();
+			}
+
+			this->FormatBuffer.clear();
+			LogBinary::Format(*format, slot.Message.data(), slot.Message.size(), this->FormatBuffer);
+
+			this->Store(slot.Level, slot.Time, slot.TimeMsPrecision, slot.Channel, this->FormatBuffer, format, slot.FormatID, &slot.Message);
+		}
+		else
+		{
+			this->Store(slot.Level, slot.Time, slot.TimeMsPrecision, slot.Channel, slot.Message);
+		}
+
+		slot.Sequence.store(this->DequeuePos + this->QueueMask + 1, std::memory_order_release);
+		this->DequeuePos++;
+		this->QueueSize--;
+	}
+
+	size_t dropped = this->AmountDropped.exchange(0);
+
+	if (dropped > 0)
+	{
+		this->Store(ELogLevel::WARNING, Time::GetTimestamp(), Time::GetMilliseconds(), "Logger",
+			std::to_string(dropped) + " log message(s) dropped. The queue was full.");
+	}
+
+	this->SummarizeSuppressed();
+}
+
+void CLogApi::SummarizeSuppressed()
+{
+	if (!this->IsRateLimited) { return; }
+
+	long long now = GetTickMs();
+
+	if (now - this->LastSummary < LOG_SUPPRESSION_INTERVAL_MS) { return; }
+
+	this->LastSummary = now;
+
+	std::vector<std::string> summaries;
 
-	this->LogUnformatted(aLogLevel, aChannel, &buffer[0]);
+	{
+		const std::lock_guard<std::mutex> lock(this->LimiterMutex);
+
+		for (auto it = this->ChannelBuckets.begin(); it != this->ChannelBuckets.end();)
+		{
+			if (it->second.Suppressed > 0)
+			{
+				summaries.push_back(std::to_string(it->second.Suppressed) + " log message(s) on channel \"" + it->first + "\" suppressed. The channel exceeds its rate limit.");
+				it->second.Suppressed = 0;
+			}
+			/* Full buckets are the same as new ones, so channels with generated names do not pile up. */
+			else if (IsIdle(it->second, this->ChannelLimit, now))
+			{
+				it = this->ChannelBuckets.erase(it);
+				continue;
+			}
+
+			it++;
+		}
+
+		for (auto it = this->AddonBuckets.begin(); it != this->AddonBuckets.end();)
+		{
+			if (it->second.Suppressed > 0)
+			{
+				summaries.push_back(std::to_string(it->second.Suppressed) + " log message(s) of addon " + std::to_string(it->first) + " suppressed. The addon exceeds its rate limit.");
+				it->second.Suppressed = 0;
+			}
+			else if (IsIdle(it->second, this->AddonLimit, now))
+			{
+				it = this->AddonBuckets.erase(it);
+				continue;
+			}
+
+			it++;
+		}
+	}
+
+	for (const std::string& summary : summaries)
+	{
+		this->Store(ELogLevel::WARNING, Time::GetTimestamp(), Time::GetMilliseconds(), "Logger", summary);
+	}
+}
+
+void CLogApi::SetRetention(size_t aMaxBytes, size_t aMaxCount, ELogLevel aLogLevel)
+{
+	const std::lock_guard<std::mutex> lock(this->Mutex);
+
+	this->RetentionLevel = aLogLevel;
+	this->UpdateMaxLevel();
+
+	/* Keep the newest messages, that still fit into the new budget. */
+	std::vector<LogMsg_t> retained;
+	retained.reserve(this->RecordCount);
+
+	for (size_t i = 0; i < this->RecordCount; i++)
+	{
+		retained.push_back(*this->Materialize(this->Records[(this->RecordHead + i) % this->MaxRecords]));
+	}
+
+	this->Records.clear();
+	this->Records.shrink_to_fit();
+	this->RecordHead  = 0;
+	this->RecordCount = 0;
+	this->Chunks.clear();
+	this->ChunkIndex  = 0;
+	this->ChunkOffset = LOG_ARENA_CHUNK_SIZE;
+
+	this->MaxChunks  = (std::max)(aMaxBytes / LOG_ARENA_CHUNK_SIZE, (size_t)1);
+	this->MaxRecords = (std::max)(aMaxCount, (size_t)1);
+
+	for (const LogMsg_t& msg : retained)
+	{
+		if (msg.Level > this->RetentionLevel) { continue; }
+
+		bool isStructured = !msg.Fields.empty();
+
+		LogRecord_t& record = this->Retain(msg.Level, msg.Time, msg.TimeMsPrecision, msg.Channel, isStructured ? msg.Fields : msg.Message, isStructured);
+		record.RepeatCount = (uint32_t)msg.RepeatCount;
+	}
 }
 
-void CLogApi::LogUnformatted(ELogLevel aLogLevel, std::string aChannel, const char* aMsg)
+void CLogApi::SetRateLimits(LogRateLimit_t aChannelLimit, LogRateLimit_t aAddonLimit)
 {
-	LogMsg_t* msg = nullptr;
+	const std::lock_guard<std::mutex> lock(this->LimiterMutex);
 
+	this->ChannelLimit = aChannelLimit;
+	this->AddonLimit   = aAddonLimit;
+	this->ChannelBuckets.clear();
+	this->AddonBuckets.clear();
+
+	this->IsRateLimited = aChannelLimit.Rate > 0 || aAddonLimit.Rate > 0;
+}
+
+void CLogApi::Store(ELogLevel aLogLevel, long long aTime, int aTimeMsPrecision, const std::string& aChannel, const std::string& aMsg, const LogFormat_t* aFormat, uint32_t aFormatID, const std::string* aArgs, bool aIsStructured)
+{
 	const std::lock_guard<std::mutex> lock(this->Mutex);
 
-	LogMsg_t* lastMsg = this->Messages.size() > 0 ? this->Messages.back() : nullptr;
+	const LogMsg_t* msg = nullptr;
 
-	if (lastMsg && aMsg == lastMsg->Message && aLogLevel == lastMsg->Level)
+	if (aLogLevel <= this->RetentionLevel)
 	{
-		msg = lastMsg;
-		lastMsg->RepeatCount++;
+		msg = this->Materialize(this->Retain(aLogLevel, aTime, aTimeMsPrecision, aChannel, aMsg, aIsStructured));
 	}
 	else
 	{
-		msg = new LogMsg_t();
-		msg->Level           = aLogLevel;
-		msg->Time            = Time::GetTimestamp();
-		msg->TimeMsPrecision = Time::GetMilliseconds();
-		msg->Channel         = aChannel;
-		msg->Message         = aMsg;
+		/* Not retained, only passed through to the loggers. */
+		this->DispatchMsg.Level           = aLogLevel;
+		this->DispatchMsg.Time            = aTime;
+		this->DispatchMsg.TimeMsPrecision = aTimeMsPrecision;
+		this->DispatchMsg.Channel.assign(aChannel);
+		this->DispatchMsg.RepeatCount     = 1;
+		this->DispatchMsg.FormatID        = 0;
+		this->DispatchMsg.Format          = nullptr;
+		this->DispatchMsg.Args.clear();
+
+		if (aIsStructured)
+		{
+			this->DispatchMsg.Fields.assign(aMsg);
+			this->DispatchMsg.Message.clear();
+			LogBinary::FormatFields(aMsg.data(), aMsg.size(), this->DispatchMsg.Message);
+		}
+		else
+		{
+			this->DispatchMsg.Fields.clear();
+			this->DispatchMsg.Message.assign(aMsg);
+		}
 
-		/* store new log entry */
-		this->Messages.push_back(msg);
+		msg = &this->DispatchMsg;
+	}
+
+	/* Pass the deferred form along, binary sinks store it instead of the text. */
+	if (aFormat)
+	{
+		this->DispatchMsg.FormatID = aFormatID;
+		this->DispatchMsg.Format   = aFormat->Format.c_str();
+		this->DispatchMsg.Args.assign(*aArgs);
 	}
 
 	/* Dispatch message. */
+	s_DispatchDepth++;
+
 	for (ILogger* logger : this->Registry)
 	{
 		/* Must match logger filter. */
@@ -152,4 +658,161 @@ void CLogApi::LogUnformatted(ELogLevel aLogLevel, std::string aChannel, const ch
 			logger->MsgProc(msg);
 		}
 	}
+
+	s_DispatchDepth--;
+}
+
+void CLogApi::UpdateMaxLevel()
+{
+	ELogLevel maxLevel = this->RetentionLevel;
+
+	for (ILogger* logger : this->Registry)
+	{
+		maxLevel = (std::max)(maxLevel, logger->GetLogLevel());
+	}
+
+	this->MaxLevel.store(maxLevel, std::memory_order_relaxed);
+}
+
+LogRecord_t& CLogApi::Retain(ELogLevel aLogLevel, long long aTime, int aTimeMsPrecision, const std::string& aChannel, const std::string& aMsg, bool aIsStructured)
+{
+	/* Messages are capped at the chunk size. */
+	uint32_t length = (uint32_t)(std::min)(aMsg.size(), LOG_ARENA_CHUNK_SIZE);
+
+	if (this->RecordCount > 0)
+	{
+		LogRecord_t& lastRecord = this->Records[(this->RecordHead + this->RecordCount - 1) % this->MaxRecords];
+
+		if (aLogLevel == lastRecord.Level &&
+			aIsStructured == lastRecord.IsStructured &&
+			length == lastRecord.Length &&
+			memcmp(this->Chunks[lastRecord.Chunk].get() + lastRecord.Offset, aMsg.data(), length) == 0)
+		{
+			lastRecord.RepeatCount++;
+			return lastRecord;
+		}
+	}
+
+	/* Intern the channel. */
+	uint32_t channelId = 0;
+	auto it = this->ChannelLookup.find(aChannel);
+
+	if (it != this->ChannelLookup.end())
+	{
+		channelId = it->second;
+	}
+	else
+	{
+		channelId = (uint32_t)this->Channels.size();
+		this->Channels.push_back(aChannel);
+		this->ChannelLookup.emplace(aChannel, channelId);
+	}
+
+	/* Allocate the text. Moving on to the next chunk discards the records still stored in it, those are the oldest ones. */
+	if (this->Chunks.empty() || this->ChunkOffset + length > LOG_ARENA_CHUNK_SIZE)
+	{
+		this->ChunkIndex  = this->Chunks.empty() ? 0 : (this->ChunkIndex + 1) % this->MaxChunks;
+		this->ChunkOffset = 0;
+
+		if (this->ChunkIndex == this->Chunks.size())
+		{
+			this->Chunks.push_back(std::make_unique<char[]>(LOG_ARENA_CHUNK_SIZE));
+		}
+		else
+		{
+			while (this->RecordCount > 0 && this->Records[this->RecordHead].Chunk == this->ChunkIndex)
+			{
+				this->Evict();
+			}
+		}
+	}
+
+	if (this->RecordCount == this->MaxRecords)
+	{
+		this->Evict();
+	}
+
+	memcpy(this->Chunks[this->ChunkIndex].get() + this->ChunkOffset, aMsg.data(), length);
+
+	LogRecord_t record{};
+	record.Level           = aLogLevel;
+	record.Time            = aTime;
+	record.TimeMsPrecision = aTimeMsPrecision;
+	record.ChannelID       = channelId;
+	record.RepeatCount     = 1;
+	record.Chunk           = (uint32_t)this->ChunkIndex;
+	record.Offset          = (uint32_t)this->ChunkOffset;
+	record.Length          = length;
+	record.IsStructured    = aIsStructured;
+
+	this->ChunkOffset += length;
+
+	size_t idx = (this->RecordHead + this->RecordCount) % this->MaxRecords;
+
+	if (idx == this->Records.size())
+	{
+		this->Records.push_back(record);
+	}
+	else
+	{
+		this->Records[idx] = record;
+	}
+
+	this->RecordCount++;
+
+	return this->Records[idx];
+}
+
+void CLogApi::Evict()
+{
+	this->RecordHead = (this->RecordHead + 1) % this->MaxRecords;
+	this->RecordCount--;
+}
+
+const LogMsg_t* CLogApi::Materialize(const LogRecord_t& aRecord)
+{
+	this->DispatchMsg.Level           = aRecord.Level;
+	this->DispatchMsg.Time            = aRecord.Time;
+	this->DispatchMsg.TimeMsPrecision = aRecord.TimeMsPrecision;
+	this->DispatchMsg.Channel.assign(this->Channels[aRecord.ChannelID]);
+	this->DispatchMsg.RepeatCount     = (int)aRecord.RepeatCount;
+	this->DispatchMsg.FormatID        = 0;
+	this->DispatchMsg.Format          = nullptr;
+	this->DispatchMsg.Args.clear();
+
+	const char* data = this->Chunks[aRecord.Chunk].get() + aRecord.Offset;
+
+	if (aRecord.IsStructured)
+	{
+		this->DispatchMsg.Fields.assign(data, aRecord.Length);
+		this->DispatchMsg.Message.clear();
+		LogBinary::FormatFields(data, aRecord.Length, this->DispatchMsg.Message);
+	}
+	else
+	{
+		this->DispatchMsg.Fields.clear();
+		this->DispatchMsg.Message.assign(data, aRecord.Length);
+	}
+
+	return &this->DispatchMsg;
+}
+
+void CLogApi::Process()
+{
+	while (this->IsRunning)
+	{
+		{
+			const std::lock_guard<std::timed_mutex> lock(this->ConsumerMutex);
+			this->ProcessQueue();
+		}
+
+		std::unique_lock<std::mutex> lock(this->ProcessorMutex);
+
+		this->IsWaiting = true;
+		this->ProcessorConVar.wait_for(lock, std::chrono::milliseconds(10), [this]
+		{
+			return !this->IsRunning || this->QueueSize > 0;
+		});
+		this->IsWaiting = false;
+	}
 }
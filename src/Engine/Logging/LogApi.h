@@ -9,13 +9,31 @@
 #ifndef LOGAPI_H
 #define LOGAPI_H
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
 #include "LogBase.h"
+#include "LogBinary.h"
+#include "LogBucket.h"
 #include "LogMsg.h"
 #include "LogEnum.h"
+#include "LogField.h"
+#include "LogQueue.h"
+#include "LogRateLimit.h"
+#include "LogRecord.h"
+
+constexpr size_t    LOG_MAX_FORMATS             = 65536;
+constexpr long long LOG_SUPPRESSION_INTERVAL_MS = 1000;
+
+/* Returns the signature of the addon owning the address or 0. Called by any logging thread, must not block. */
+typedef signed int (*LOGGER_RESOLVEOWNER)(void* aAddress);
 
 ///----------------------------------------------------------------------------------------------------
 /// CLogApi Class
@@ -23,6 +41,14 @@
 class CLogApi
 {
 	public:
+	///----------------------------------------------------------------------------------------------------
+	/// ctor
+	/// 	aQueueCapacity is rounded up to the next power of two.
+	/// 	aRetentionBytes and aRetentionCount limit the messages kept in memory, see SetRetention.
+	/// 	aResolveOwner attributes messages to addons by caller address, see SetRateLimits.
+	///----------------------------------------------------------------------------------------------------
+	CLogApi(size_t aQueueCapacity = 4096, size_t aRetentionBytes = 8 * 1024 * 1024, size_t aRetentionCount = 65536, LOGGER_RESOLVEOWNER aResolveOwner = nullptr);
+
 	///----------------------------------------------------------------------------------------------------
 	/// dtor
 	///----------------------------------------------------------------------------------------------------
@@ -40,58 +66,228 @@ class CLogApi
 	///----------------------------------------------------------------------------------------------------
 	void Deregister(ILogger* aLogger);
 
+	///----------------------------------------------------------------------------------------------------
+	/// ShouldLog:
+	/// 	Returns true, if a message of the given level would be received by any logger or retained.
+	/// 	Messages that would not are discarded before formatting.
+	///----------------------------------------------------------------------------------------------------
+	inline bool ShouldLog(ELogLevel aLogLevel) const
+	{
+		return aLogLevel <= this->MaxLevel.load(std::memory_order_relaxed);
+	}
+
 	///----------------------------------------------------------------------------------------------------
 	/// Critical:
 	/// 	Logs a message with level Critical.
 	///----------------------------------------------------------------------------------------------------
-	void Critical(const std::string& aChannel, const char* aFmt, ...);
+	void Critical(const char* aChannel, const char* aFmt, ...);
 
 	///----------------------------------------------------------------------------------------------------
 	/// Warning:
 	/// 	Logs a message with level Warning.
 	///----------------------------------------------------------------------------------------------------
-	void Warning(const std::string& aChannel, const char* aFmt, ...);
+	void Warning(const char* aChannel, const char* aFmt, ...);
 
 	///----------------------------------------------------------------------------------------------------
 	/// Info:
 	/// 	Logs a message with level Info.
 	///----------------------------------------------------------------------------------------------------
-	void Info(const std::string& aChannel, const char* aFmt, ...);
+	void Info(const char* aChannel, const char* aFmt, ...);
 
 	///----------------------------------------------------------------------------------------------------
 	/// Debug:
 	/// 	Logs a message with level Debug.
 	///----------------------------------------------------------------------------------------------------
-	void Debug(const std::string& aChannel, const char* aFmt, ...);
+	void Debug(const char* aChannel, const char* aFmt, ...);
 
 	///----------------------------------------------------------------------------------------------------
 	/// Trace:
 	/// 	Logs a message with level Trace.
 	///----------------------------------------------------------------------------------------------------
-	void Trace(const std::string& aChannel, const char* aFmt, ...);
+	void Trace(const char* aChannel, const char* aFmt, ...);
 
 	///----------------------------------------------------------------------------------------------------
 	/// Log:
 	/// 	Logs a message to a specific channel.
 	///----------------------------------------------------------------------------------------------------
-	void Log(ELogLevel aLogLevel, std::string aChannel, const char* aFmt, ...);
+	void Log(ELogLevel aLogLevel, const char* aChannel, const char* aFmt, ...);
 
 	///----------------------------------------------------------------------------------------------------
 	/// LogV:
 	/// 	Logs a message to a specific channel with printf-style formatting.
 	///----------------------------------------------------------------------------------------------------
-	void LogV(ELogLevel aLogLevel, std::string aChannel, const char* aFmt, va_list aArgs);
+	void LogV(ELogLevel aLogLevel, const char* aChannel, const char* aFmt, va_list aArgs);
 
 	///----------------------------------------------------------------------------------------------------
 	/// LogUnformatted:
 	/// 	Logs an unformatted message to a specific channel.
+	/// 	Only queues the message, it is stored and dispatched to the loggers on the processor thread.
+	/// 	aCaller is the return address of the addon, its messages count against the addon's rate limit.
+	///----------------------------------------------------------------------------------------------------
+	void LogUnformatted(ELogLevel aLogLevel, const char* aChannel, const char* aMsg, void* aCaller = nullptr);
+
+	///----------------------------------------------------------------------------------------------------
+	/// LogStructured:
+	/// 	Logs an event with typed key/value fields to a specific channel.
+	/// 	The fields are captured as is and retained unformatted, loggers receive them in LogMsg_t::Fields.
+	///----------------------------------------------------------------------------------------------------
+	void LogStructured(ELogLevel aLogLevel, const char* aChannel, const char* aEvent, const LogField_t* aFields, uint32_t aFieldCount, void* aCaller = nullptr);
+
+	///----------------------------------------------------------------------------------------------------
+	/// SetDeferredFormatting:
+	/// 	If enabled, LogV only captures the format string and the raw arguments.
+	/// 	The text is formatted on the processor thread and binary loggers receive the captured form.
+	///----------------------------------------------------------------------------------------------------
+	void SetDeferredFormatting(bool aEnabled);
+
 	///----------------------------------------------------------------------------------------------------
-	void LogUnformatted(ELogLevel aLogLevel, std::string aChannel, const char* aMsg);
+	/// Flush:
+	/// 	Stores and dispatches all queued messages on the calling thread.
+	/// 	Used on shutdown and when crashing, when the processor thread might not run anymore.
+	/// 	Returns false, if the queue could not be locked within a second.
+	///----------------------------------------------------------------------------------------------------
+	bool Flush();
+
+	///----------------------------------------------------------------------------------------------------
+	/// SetRetention:
+	/// 	Sets the budget of the messages kept in memory and replayed to newly registered loggers.
+	/// 	aMaxBytes is the size of the message text arena, aMaxCount the maximum amount of messages.
+	/// 	The oldest messages are discarded once either limit is reached.
+	/// 	Messages above aLogLevel are dispatched, but not retained.
+	///----------------------------------------------------------------------------------------------------
+	void SetRetention(size_t aMaxBytes, size_t aMaxCount, ELogLevel aLogLevel = ELogLevel::ALL);
+
+	///----------------------------------------------------------------------------------------------------
+	/// SetRateLimits:
+	/// 	Sets the token buckets applied to every channel and to every addon.
+	/// 	Messages over the limit are discarded before formatting and summarized once per interval.
+	/// 	Critical messages are never suppressed.
+	///----------------------------------------------------------------------------------------------------
+	void SetRateLimits(LogRateLimit_t aChannelLimit, LogRateLimit_t aAddonLimit);
 
 	private:
-	std::mutex             Mutex;
-	std::vector<ILogger*>  Registry;
-	std::vector<LogMsg_t*> Messages;
+	std::mutex                                Mutex;          /* Guards the Registry and the retention store. */
+	std::vector<ILogger*>                     Registry;
+	std::atomic<ELogLevel>                    MaxLevel       = ELogLevel::ALL; /* Highest level accepted by any logger or the retention store. */
+	ELogLevel                                 RetentionLevel = ELogLevel::ALL;
+
+	std::vector<std::string>                  Channels;       /* Interned channel names, indexed by LogRecord_t::ChannelID. */
+	std::unordered_map<std::string, uint32_t> ChannelLookup;
+	std::vector<LogRecord_t>                  Records;        /* Ring of retained messages, grows up to MaxRecords. */
+	size_t                                    RecordHead  = 0; /* Index of the oldest record. */
+	size_t                                    RecordCount = 0;
+	size_t                                    MaxRecords  = 0;
+	std::vector<std::unique_ptr<char[]>>      Chunks;         /* Message text arena, chunks are allocated up to MaxChunks and then reused. */
+	size_t                                    ChunkIndex  = 0;
+	size_t                                    ChunkOffset = LOG_ARENA_CHUNK_SIZE;
+	size_t                                    MaxChunks   = 0;
+	LogMsg_t                                  DispatchMsg;    /* Record materialized for the loggers. Only valid during MsgProc. */
+
+	std::atomic<bool>                         IsDeferredFormatting = false;
+	std::shared_mutex                         FormatMutex;
+	std::unordered_map<const char*, uint32_t> FormatLookup;   /* Format string address to FormatID. */
+	std::vector<std::unique_ptr<LogFormat_t>> Formats;        /* Interned formats, indexed by FormatID - 1. Never released. */
+	std::string                               FormatBuffer;   /* Guarded by the ConsumerMutex. */
+
+	LOGGER_RESOLVEOWNER                       ResolveOwner = nullptr;
+	std::atomic<bool>                         IsRateLimited = false;
+	std::mutex                                LimiterMutex;
+	LogRateLimit_t                            ChannelLimit;
+	LogRateLimit_t                            AddonLimit;
+	std::unordered_map<std::string, LogBucket_t> ChannelBuckets;
+	std::unordered_map<signed int, LogBucket_t>  AddonBuckets;
+	long long                                 LastSummary  = 0; /* Guarded by the ConsumerMutex. */
+
+	std::unique_ptr<LogQueueSlot_t[]> Queue;
+	size_t                            QueueMask;
+	alignas(64) std::atomic<size_t>   EnqueuePos    = 0;
+	alignas(64) size_t                DequeuePos    = 0; /* Guarded by the ConsumerMutex. */
+	std::timed_mutex                  ConsumerMutex;
+	std::atomic<size_t>               QueueSize     = 0;
+	std::atomic<size_t>               AmountDropped = 0;
+
+	std::thread                       ProcessorThread;
+	std::atomic<bool>                 IsRunning     = false;
+	std::atomic<bool>                 IsWaiting     = false;
+	std::mutex                        ProcessorMutex;
+	std::condition_variable           ProcessorConVar;
+
+	///----------------------------------------------------------------------------------------------------
+	/// Admit:
+	/// 	Takes a token from the buckets of the channel and the calling addon.
+	/// 	Returns false and counts the message as suppressed, if either is empty.
+	///----------------------------------------------------------------------------------------------------
+	bool Admit(ELogLevel aLogLevel, const char* aChannel, void* aCaller);
+
+	///----------------------------------------------------------------------------------------------------
+	/// SummarizeSuppressed:
+	/// 	Stores a warning per channel and addon with suppressed messages. Must be called with the ConsumerMutex held.
+	///----------------------------------------------------------------------------------------------------
+	void SummarizeSuppressed();
+
+	///----------------------------------------------------------------------------------------------------
+	/// Push:
+	/// 	Queues a message, applying the overflow policy if the queue is full.
+	///----------------------------------------------------------------------------------------------------
+	void Push(ELogLevel aLogLevel, const char* aChannel, const char* aData, size_t aSize, uint32_t aFormatID);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Enqueue:
+	/// 	Pushes a message into the queue. Returns false if the queue is full.
+	///----------------------------------------------------------------------------------------------------
+	bool Enqueue(ELogLevel aLogLevel, const char* aChannel, const char* aData, size_t aSize, uint32_t aFormatID);
+
+	///----------------------------------------------------------------------------------------------------
+	/// InternFormat:
+	/// 	Returns the FormatID of a format string or 0, if it cannot be formatted deferred.
+	///----------------------------------------------------------------------------------------------------
+	uint32_t InternFormat(const char* aFmt);
+
+	///----------------------------------------------------------------------------------------------------
+	/// ProcessQueue:
+	/// 	Stores and dispatches all queued messages. Must be called with the ConsumerMutex held.
+	///----------------------------------------------------------------------------------------------------
+	void ProcessQueue();
+
+	///----------------------------------------------------------------------------------------------------
+	/// Store:
+	/// 	Stores a message, collapsing repeats, and dispatches it to the loggers.
+	/// 	aFormat, aFormatID and aArgs are passed on to the loggers, if the message was formatted deferred.
+	/// 	If aIsStructured is set, aMsg holds the captured fields instead of the text.
+	///----------------------------------------------------------------------------------------------------
+	void Store(ELogLevel aLogLevel, long long aTime, int aTimeMsPrecision, const std::string& aChannel, const std::string& aMsg, const LogFormat_t* aFormat = nullptr, uint32_t aFormatID = 0, const std::string* aArgs = nullptr, bool aIsStructured = false);
+
+	///----------------------------------------------------------------------------------------------------
+	/// UpdateMaxLevel:
+	/// 	Recalculates the highest accepted level. Must be called with the Mutex held.
+	///----------------------------------------------------------------------------------------------------
+	void UpdateMaxLevel();
+
+	///----------------------------------------------------------------------------------------------------
+	/// Retain:
+	/// 	Adds a message to the retention store, evicting the oldest records as needed.
+	/// 	Returns the record, which is the previous one if the message is a repeat.
+	/// 	Must be called with the Mutex held.
+	///----------------------------------------------------------------------------------------------------
+	LogRecord_t& Retain(ELogLevel aLogLevel, long long aTime, int aTimeMsPrecision, const std::string& aChannel, const std::string& aMsg, bool aIsStructured = false);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Evict:
+	/// 	Discards the oldest record. Must be called with the Mutex held.
+	///----------------------------------------------------------------------------------------------------
+	void Evict();
+
+	///----------------------------------------------------------------------------------------------------
+	/// Materialize:
+	/// 	Copies a record into the DispatchMsg, formatting the text of structured ones. Must be called with the Mutex held.
+	///----------------------------------------------------------------------------------------------------
+	const LogMsg_t* Materialize(const LogRecord_t& aRecord);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Process:
+	/// 	Thread function of the processor thread.
+	///----------------------------------------------------------------------------------------------------
+	void Process();
 };
 
 #endif
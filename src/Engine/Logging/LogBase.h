@@ -34,6 +34,7 @@ class ILogger
 	///----------------------------------------------------------------------------------------------------
 	/// SetLogLevel:
 	/// 	Sets the log level. Controls which messages should be received.
+	/// 	Must be set before the logger is registered, CLogApi discards levels no logger accepts.
 	///----------------------------------------------------------------------------------------------------
 	void SetLogLevel(ELogLevel aLogLevel);
 
@@ -0,0 +1,699 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  LogBinary.cpp
+/// Description  :  Deferred formatting of log messages and the binary log file format.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include "LogBinary.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+
+#include "LogConst.h"
+#include "LogMsg.h"
+
+///----------------------------------------------------------------------------------------------------
+/// Reader_t Struct
+/// 	Bounds checked reading of captured arguments.
+///----------------------------------------------------------------------------------------------------
+struct Reader_t
+{
+	const char* Data;
+	size_t      Size;
+	size_t      Position = 0;
+
+	template <typename T>
+	T Read()
+	{
+		T value{};
+
+		if (this->Position + sizeof(T) <= this->Size)
+		{
+			memcpy(&value, this->Data + this->Position, sizeof(T));
+			this->Position += sizeof(T);
+		}
+		else
+		{
+			this->Position = this->Size;
+		}
+
+		return value;
+	}
+
+	uint64_t ReadVarint()
+	{
+		uint64_t value = 0;
+
+		for (int shift = 0; shift < 64 && this->Position < this->Size; shift += 7)
+		{
+			uint8_t byte = (uint8_t)this->Data[this->Position++];
+			value |= (uint64_t)(byte & 0x7F) << shift;
+
+			if (!(byte & 0x80)) { break; }
+		}
+
+		return value;
+	}
+
+	int64_t ReadSigned()
+	{
+		return LogBinary::UnZigZag(this->ReadVarint());
+	}
+
+	/* Reads a string written including its terminator. Returns nullptr, if it is truncated. */
+	const char* ReadTerminated()
+	{
+		uint64_t length = this->ReadVarint();
+
+		if (length == 0 || length > this->Size - this->Position || this->Data[this->Position + length - 1] != '\0')
+		{
+			this->Position = this->Size;
+			return nullptr;
+		}
+
+		const char* str = this->Data + this->Position;
+		this->Position += length;
+
+		return str;
+	}
+};
+
+template <typename T>
+static void Append(std::string& aOut, T aValue)
+{
+	aOut.append(reinterpret_cast<const char*>(&aValue), sizeof(T));
+}
+
+///----------------------------------------------------------------------------------------------------
+/// AppendFormatted:
+/// 	Formats a single conversion specification and appends it.
+///----------------------------------------------------------------------------------------------------
+template <typename T>
+static void AppendFormatted(std::string& aOut, const char* aSpec, const LogFormatSpec_t& aInfo, int aWidth, int aPrecision, T aValue)
+{
+	auto print = [&](char* aBuffer, size_t aBufferSize) -> int
+	{
+		if (aInfo.HasWidthArg && aInfo.HasPrecisionArg)
+		{
+			return snprintf(aBuffer, aBufferSize, aSpec, aWidth, aPrecision, aValue);
+		}
+		else if (aInfo.HasWidthArg)
+		{
+			return snprintf(aBuffer, aBufferSize, aSpec, aWidth, aValue);
+		}
+		else if (aInfo.HasPrecisionArg)
+		{
+			return snprintf(aBuffer, aBufferSize, aSpec, aPrecision, aValue);
+		}
+
+		return snprintf(aBuffer, aBufferSize, aSpec, aValue);
+	};
+
+	char buffer[256];
+	int length = print(buffer, sizeof(buffer));
+
+	if (length < 0) { return; }
+
+	if ((size_t)length < sizeof(buffer))
+	{
+		aOut.append(buffer, length);
+		return;
+	}
+
+	size_t offset = aOut.size();
+	aOut.resize(offset + length + 1);
+	print(&aOut[offset], length + 1);
+	aOut.resize(offset + length);
+}
+
+namespace LogBinary
+{
+	LogFormat_t Parse(const char* aFormat)
+	{
+		LogFormat_t result{};
+		result.Format       = aFormat ? aFormat : "";
+		result.IsCapturable = true;
+
+		const std::string& fmt = result.Format;
+		const size_t size = fmt.size();
+
+		auto at = [&](size_t aIndex) { return aIndex < size ? fmt[aIndex] : '\0'; };
+
+		for (size_t i = 0; i < size; i++)
+		{
+			if (fmt[i] != '%') { continue; }
+
+			LogFormatSpec_t spec{};
+			spec.Offset    = (uint32_t)i;
+			spec.Precision = -1;
+
+			size_t j = i + 1;
+
+			if (at(j) == '%')
+			{
+				spec.Type   = ELogArgType::None;
+				spec.Length = 2;
+				result.Specs.push_back(spec);
+				i = j;
+				continue;
+			}
+
+			/* Flags. */
+			while (at(j) != '\0' && strchr("-+ #0'", at(j))) { j++; }
+
+			/* Width. */
+			if (at(j) == '*')
+			{
+				spec.HasWidthArg = true;
+				j++;
+			}
+			else
+			{
+				while (at(j) >= '0' && at(j) <= '9') { j++; }
+			}
+
+			/* Positional arguments cannot be captured in order. */
+			if (at(j) == '$')
+			{
+				result.IsCapturable = false;
+				return result;
+			}
+
+			/* Precision. */
+			if (at(j) == '.')
+			{
+				j++;
+
+				if (at(j) == '*')
+				{
+					spec.HasPrecisionArg = true;
+					j++;
+				}
+				else
+				{
+					spec.Precision = 0;
+
+					while (at(j) >= '0' && at(j) <= '9')
+					{
+						spec.Precision = (std::min)(spec.Precision * 10 + (at(j) - '0'), INT_MAX / 10);
+						j++;
+					}
+				}
+			}
+
+			/* Length modifier. */
+			ELogArgType intType = ELogArgType::Int;
+			bool isWide       = false;
+			bool isLongDouble = false;
+
+			switch (at(j))
+			{
+				case 'h': { j += at(j + 1) == 'h' ? 2 : 1; break; }
+				case 'l':
+				{
+					if (at(j + 1) == 'l')
+					{
+						intType = ELogArgType::LongLong;
+						j += 2;
+					}
+					else
+					{
+						intType = ELogArgType::Long;
+						isWide = true;
+						j++;
+					}
+					break;
+				}
+				case 'j': { intType = ELogArgType::IntMax;  j++; break; }
+				case 'z': { intType = ELogArgType::SizeT;   j++; break; }
+				case 't': { intType = ELogArgType::PtrDiff; j++; break; }
+				case 'L': { isLongDouble = true;            j++; break; }
+				case 'w': { isWide = true;                  j++; break; }
+				case 'I':
+				{
+					if (at(j + 1) == '6' && at(j + 2) == '4')
+					{
+						intType = ELogArgType::LongLong;
+						j += 3;
+					}
+					else if (at(j + 1) == '3' && at(j + 2) == '2')
+					{
+						j += 3;
+					}
+					else
+					{
+						intType = ELogArgType::SizeT;
+						j++;
+					}
+					break;
+				}
+			}
+
+			/* Conversion. */
+			switch (at(j))
+			{
+				case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+				{
+					spec.Type = intType;
+					break;
+				}
+				case 'c':
+				{
+					if (isWide) { result.IsCapturable = false; return result; }
+					spec.Type = ELogArgType::Int;
+					break;
+				}
+				case 's':
+				{
+					if (isWide) { result.IsCapturable = false; return result; }
+					spec.Type = ELogArgType::String;
+					break;
+				}
+				case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+				{
+					spec.Type = isLongDouble ? ELogArgType::LongDouble : ELogArgType::Double;
+					break;
+				}
+				case 'p':
+				{
+					spec.Type = ELogArgType::Pointer;
+					break;
+				}
+				default:
+				{
+					/* %n, wide %C/%S/%Z and malformed specifications. */
+					result.IsCapturable = false;
+					return result;
+				}
+			}
+
+			spec.Length = (uint32_t)(j - i + 1);
+			result.Specs.push_back(spec);
+			i = j;
+		}
+
+		return result;
+	}
+
+	void Capture(const LogFormat_t& aFormat, va_list aArgs, std::string& aOut)
+	{
+		for (const LogFormatSpec_t& spec : aFormat.Specs)
+		{
+			int precision = spec.Precision;
+
+			if (spec.HasWidthArg)     { WriteVarint(aOut, ZigZag(va_arg(aArgs, int))); }
+			if (spec.HasPrecisionArg) { precision = va_arg(aArgs, int); WriteVarint(aOut, ZigZag(precision)); }
+
+			switch (spec.Type)
+			{
+				case ELogArgType::None:       { break; }
+				case ELogArgType::Int:        { WriteVarint(aOut, ZigZag(va_arg(aArgs, int))); break; }
+				case ELogArgType::Long:       { WriteVarint(aOut, ZigZag(va_arg(aArgs, long))); break; }
+				case ELogArgType::LongLong:   { WriteVarint(aOut, ZigZag(va_arg(aArgs, long long))); break; }
+				case ELogArgType::SizeT:      { WriteVarint(aOut, va_arg(aArgs, size_t)); break; }
+				case ELogArgType::IntMax:     { WriteVarint(aOut, ZigZag(va_arg(aArgs, intmax_t))); break; }
+				case ELogArgType::PtrDiff:    { WriteVarint(aOut, ZigZag(va_arg(aArgs, ptrdiff_t))); break; }
+				case ELogArgType::Double:     { Append<double>(aOut, va_arg(aArgs, double)); break; }
+				case ELogArgType::LongDouble: { Append<double>(aOut, (double)va_arg(aArgs, long double)); break; }
+				case ELogArgType::Pointer:    { WriteVarint(aOut, (uint64_t)(uintptr_t)va_arg(aArgs, void*)); break; }
+				case ELogArgType::String:
+				{
+					const char* str = va_arg(aArgs, const char*);
+
+					/* Length + 1, 0 is a null pointer. */
+					if (!str)
+					{
+						WriteVarint(aOut, 0);
+						break;
+					}
+
+					/* A precision bounds the read, the string does not have to be terminated. Negative means none. */
+					size_t length = precision >= 0 ? strnlen(str, (size_t)precision) : strlen(str);
+					WriteVarint(aOut, length + 1);
+					aOut.append(str, length);
+					break;
+				}
+			}
+		}
+	}
+
+	void Format(const LogFormat_t& aFormat, const char* aData, size_t aSize, std::string& aOut)
+	{
+		Reader_t reader{ aData, aSize };
+		std::string spec;
+		std::string str;
+		size_t last = 0;
+
+		for (const LogFormatSpec_t& info : aFormat.Specs)
+		{
+			aOut.append(aFormat.Format, last, info.Offset - last);
+			last = info.Offset + info.Length;
+
+			if (info.Type == ELogArgType::None)
+			{
+				aOut.push_back('%');
+				continue;
+			}
+
+			spec.assign(aFormat.Format, info.Offset, info.Length);
+
+			int width     = info.HasWidthArg     ? (int)reader.ReadSigned() : 0;
+			int precision = info.HasPrecisionArg ? (int)reader.ReadSigned() : 0;
+
+			switch (info.Type)
+			{
+				case ELogArgType::Int:        { AppendFormatted(aOut, spec.c_str(), info, width, precision, (int)reader.ReadSigned()); break; }
+				case ELogArgType::Long:       { AppendFormatted(aOut, spec.c_str(), info, width, precision, (long)reader.ReadSigned()); break; }
+				case ELogArgType::LongLong:   { AppendFormatted(aOut, spec.c_str(), info, width, precision, (long long)reader.ReadSigned()); break; }
+				case ELogArgType::SizeT:      { AppendFormatted(aOut, spec.c_str(), info, width, precision, (size_t)reader.ReadVarint()); break; }
+				case ELogArgType::IntMax:     { AppendFormatted(aOut, spec.c_str(), info, width, precision, (intmax_t)reader.ReadSigned()); break; }
+				case ELogArgType::PtrDiff:    { AppendFormatted(aOut, spec.c_str(), info, width, precision, (ptrdiff_t)reader.ReadSigned()); break; }
+				case ELogArgType::Double:     { AppendFormatted(aOut, spec.c_str(), info, width, precision, reader.Read<double>()); break; }
+				case ELogArgType::LongDouble: { AppendFormatted(aOut, spec.c_str(), info, width, precision, (long double)reader.Read<double>()); break; }
+				case ELogArgType::Pointer:    { AppendFormatted(aOut, spec.c_str(), info, width, precision, (void*)(uintptr_t)reader.ReadVarint()); break; }
+				case ELogArgType::String:
+				{
+					uint64_t length = reader.ReadVarint();
+
+					if (length == 0)
+					{
+						str = "(null)";
+					}
+					else
+					{
+						length = (std::min)((size_t)length - 1, reader.Size - reader.Position);
+						str.assign(reader.Data + reader.Position, length);
+						reader.Position += length;
+					}
+
+					AppendFormatted(aOut, spec.c_str(), info, width, precision, str.c_str());
+					break;
+				}
+				default: { break; }
+			}
+		}
+
+		aOut.append(aFormat.Format, last, std::string::npos);
+	}
+
+	void CaptureFields(const char* aEvent, const LogField_t* aFields, uint32_t aFieldCount, std::string& aOut)
+	{
+		auto writeTerminated = [&aOut](const char* aStr)
+		{
+			if (!aStr) { aStr = ""; }
+			WriteString(aOut, aStr, strlen(aStr) + 1);
+		};
+
+		writeTerminated(aEvent);
+		WriteVarint(aOut, aFields ? aFieldCount : 0);
+
+		for (uint32_t i = 0; aFields && i < aFieldCount; i++)
+		{
+			const LogField_t& field = aFields[i];
+
+			writeTerminated(field.Key);
+			aOut.push_back((char)field.Type);
+
+			switch (field.Type)
+			{
+				case ELogFieldType::Int:    { WriteVarint(aOut, ZigZag(field.Int)); break; }
+				case ELogFieldType::UInt:   { WriteVarint(aOut, field.UInt); break; }
+				case ELogFieldType::Double: { Append<double>(aOut, field.Double); break; }
+				case ELogFieldType::Bool:   { aOut.push_back(field.Bool ? 1 : 0); break; }
+				case ELogFieldType::String: { writeTerminated(field.String); break; }
+				default:
+				{
+					/* Unknown types are kept as empty strings, the type byte is already written. */
+					aOut.back() = (char)ELogFieldType::String;
+					writeTerminated("");
+					break;
+				}
+			}
+		}
+	}
+
+	bool ReadFields(const char* aData, size_t aSize, const char*& aEvent, std::vector<LogField_t>& aFields)
+	{
+		Reader_t reader{ aData, aSize };
+
+		aFields.clear();
+		aEvent = reader.ReadTerminated();
+
+		if (!aEvent || reader.Position >= reader.Size) { return false; }
+
+		uint64_t count = reader.ReadVarint();
+
+		for (uint64_t i = 0; i < count; i++)
+		{
+			LogField_t field{};
+			field.Key = reader.ReadTerminated();
+
+			if (!field.Key || reader.Position >= reader.Size) { return false; }
+
+			field.Type = (ELogFieldType)(uint8_t)reader.Data[reader.Position++];
+
+			size_t remaining = reader.Size - reader.Position;
+
+			switch (field.Type)
+			{
+				case ELogFieldType::Int:
+				case ELogFieldType::UInt:
+				{
+					if (remaining == 0) { return false; }
+
+					field.UInt = reader.ReadVarint();
+
+					/* The last byte of a complete varint has no continuation bit. */
+					if ((uint8_t)reader.Data[reader.Position - 1] & 0x80) { return false; }
+
+					if (field.Type == ELogFieldType::Int) { field.Int = UnZigZag(field.UInt); }
+					break;
+				}
+				case ELogFieldType::Double:
+				{
+					if (remaining < sizeof(double)) { return false; }
+
+					field.Double = reader.Read<double>();
+					break;
+				}
+				case ELogFieldType::Bool:
+				{
+					if (remaining < 1) { return false; }
+
+					field.Bool = reader.Read<uint8_t>() != 0;
+					break;
+				}
+				case ELogFieldType::String:
+				{
+					field.String = reader.ReadTerminated();
+
+					if (!field.String) { return false; }
+					break;
+				}
+				default:
+				{
+					return false;
+				}
+			}
+
+			aFields.push_back(field);
+		}
+
+		return true;
+	}
+
+	void FormatFields(const char* aData, size_t aSize, std::string& aOut)
+	{
+		static thread_local std::vector<LogField_t> s_Fields;
+
+		const char* evt = nullptr;
+		ReadFields(aData, aSize, evt, s_Fields);
+
+		if (evt) { aOut.append(evt); }
+
+		char buffer[32];
+
+		for (const LogField_t& field : s_Fields)
+		{
+			if (!aOut.empty()) { aOut.push_back(' '); }
+
+			aOut.append(field.Key);
+			aOut.push_back('=');
+
+			switch (field.Type)
+			{
+				case ELogFieldType::Int:    { aOut.append(std::to_string(field.Int)); break; }
+				case ELogFieldType::UInt:   { aOut.append(std::to_string(field.UInt)); break; }
+				case ELogFieldType::Double:
+				{
+					snprintf(buffer, sizeof(buffer), "%g", field.Double);
+					aOut.append(buffer);
+					break;
+				}
+				case ELogFieldType::Bool:   { aOut.append(field.Bool ? "true" : "false"); break; }
+				case ELogFieldType::String:
+				{
+					aOut.push_back('"');
+					aOut.append(field.String);
+					aOut.push_back('"');
+					break;
+				}
+				default: { break; }
+			}
+		}
+	}
+
+	bool Decode(std::istream& aIn, std::ostream& aOut)
+	{
+		auto read = [&aIn](auto& aValue) -> bool
+		{
+			return (bool)aIn.read(reinterpret_cast<char*>(&aValue), sizeof(aValue));
+		};
+
+		auto readVarint = [&aIn](uint64_t& aValue) -> bool
+		{
+			aValue = 0;
+
+			for (int shift = 0; shift < 64; shift += 7)
+			{
+				int byte = aIn.get();
+				if (byte == std::char_traits<char>::eof()) { return false; }
+
+				aValue |= (uint64_t)(byte & 0x7F) << shift;
+
+				if (!(byte & 0x80)) { return true; }
+			}
+
+			return false;
+		};
+
+		auto readString = [&aIn, &readVarint](std::string& aValue) -> bool
+		{
+			uint64_t length = 0;
+			if (!readVarint(length)) { return false; }
+
+			aValue.resize((size_t)length);
+			return length == 0 || (bool)aIn.read(&aValue[0], length);
+		};
+
+		uint32_t magic = 0;
+		uint32_t version = 0;
+
+		if (!read(magic) || !read(version) || magic != NLOG_MAGIC || version != NLOG_VERSION)
+		{
+			return false;
+		}
+
+		std::unordered_map<uint64_t, LogFormat_t> formats;
+		std::unordered_map<uint64_t, std::string> channels;
+		LogMsg_t msg{};
+		bool hasMsg = false;
+		long long lastTimeMs = 0;
+		std::string data;
+
+		for (;;)
+		{
+			int type = aIn.get();
+
+			if (type == std::char_traits<char>::eof())
+			{
+				/* Clean end of file. */
+				return true;
+			}
+
+			uint64_t id = 0;
+
+			switch ((ENLogRecord)type)
+			{
+				case ENLogRecord::Format:
+				{
+					if (!readVarint(id) || !readString(data)) { return false; }
+
+					formats[id] = Parse(data.c_str());
+					break;
+				}
+				case ENLogRecord::Channel:
+				{
+					if (!readVarint(id) || !readString(data)) { return false; }
+
+					channels[id] = data;
+					break;
+				}
+				case ENLogRecord::Message:
+				{
+					uint8_t  level     = 0;
+					uint64_t timeDelta = 0;
+					uint64_t channelId = 0;
+					uint64_t formatId  = 0;
+
+					if (!read(level) || !readVarint(timeDelta) || !readVarint(channelId) || !readVarint(formatId) || !readString(data))
+					{
+						return false;
+					}
+
+					lastTimeMs += UnZigZag(timeDelta);
+
+					msg.Level           = (ELogLevel)level;
+					msg.Time            = lastTimeMs / 1000;
+					msg.TimeMsPrecision = (int)(lastTimeMs % 1000);
+					msg.Channel         = channels[channelId];
+					msg.RepeatCount     = 1;
+					msg.Message.clear();
+
+					auto it = formats.find(formatId);
+
+					if (formatId != 0 && it != formats.end())
+					{
+						Format(it->second, data.data(), data.size(), msg.Message);
+					}
+					else
+					{
+						msg.Message = data;
+					}
+
+					hasMsg = true;
+					aOut << ToString(&msg);
+					break;
+				}
+				case ENLogRecord::Repeat:
+				{
+					if (!readVarint(id)) { return false; }
+
+					if (hasMsg)
+					{
+						msg.RepeatCount = (int)id;
+						aOut << ToString(&msg);
+					}
+					break;
+				}
+				default:
+				{
+					return false;
+				}
+			}
+		}
+	}
+
+	void WriteVarint(std::string& aOut, uint64_t aValue)
+	{
+		while (aValue >= 0x80)
+		{
+			aOut.push_back((char)((aValue & 0x7F) | 0x80));
+			aValue >>= 7;
+		}
+
+		aOut.push_back((char)aValue);
+	}
+
+	void WriteString(std::string& aOut, const char* aData, size_t aSize)
+	{
+		WriteVarint(aOut, aSize);
+		aOut.append(aData, aSize);
+	}
+}
@@ -0,0 +1,128 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  LogBinary.h
+/// Description  :  Deferred formatting of log messages and the binary log file format.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef LOGBINARY_H
+#define LOGBINARY_H
+
+#include <cstdarg>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "LogEnum.h"
+#include "LogField.h"
+
+constexpr uint32_t NLOG_MAGIC   = 0x474F4C4E; /* "NLOG" */
+constexpr uint32_t NLOG_VERSION = 1;
+
+///----------------------------------------------------------------------------------------------------
+/// LogFormatSpec_t Struct
+/// 	A single conversion specification of a format string.
+///----------------------------------------------------------------------------------------------------
+struct LogFormatSpec_t
+{
+	uint32_t    Offset;          /* Offset of the '%' in the format string. */
+	uint32_t    Length;          /* Length including the '%' and the conversion character. */
+	ELogArgType Type;
+	bool        HasWidthArg;     /* Width given as '*'. */
+	bool        HasPrecisionArg; /* Precision given as '.*'. */
+	int         Precision;       /* Precision given as '.N', -1 if none. */
+};
+
+///----------------------------------------------------------------------------------------------------
+/// LogFormat_t Struct
+/// 	A parsed format string.
+///----------------------------------------------------------------------------------------------------
+struct LogFormat_t
+{
+	std::string                  Format;
+	std::vector<LogFormatSpec_t> Specs;
+	bool                         IsCapturable; /* False, if it contains conversions that cannot be deferred (%n, wide strings, positional arguments). */
+};
+
+///----------------------------------------------------------------------------------------------------
+/// LogBinary Namespace
+///----------------------------------------------------------------------------------------------------
+namespace LogBinary
+{
+	///----------------------------------------------------------------------------------------------------
+	/// Parse:
+	/// 	Parses a printf-style format string.
+	///----------------------------------------------------------------------------------------------------
+	LogFormat_t Parse(const char* aFormat);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Capture:
+	/// 	Appends the raw bytes of the arguments to aOut. Integers are varint encoded, strings are copied.
+	/// 	The format must be capturable.
+	///----------------------------------------------------------------------------------------------------
+	void Capture(const LogFormat_t& aFormat, va_list aArgs, std::string& aOut);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Format:
+	/// 	Formats captured arguments into aOut. Missing argument bytes are formatted as zero.
+	///----------------------------------------------------------------------------------------------------
+	void Format(const LogFormat_t& aFormat, const char* aData, size_t aSize, std::string& aOut);
+
+	///----------------------------------------------------------------------------------------------------
+	/// CaptureFields:
+	/// 	Appends the event name and the fields of a structured message to aOut.
+	/// 	Strings are copied including their terminator, null strings are stored as empty.
+	///----------------------------------------------------------------------------------------------------
+	void CaptureFields(const char* aEvent, const LogField_t* aFields, uint32_t aFieldCount, std::string& aOut);
+
+	///----------------------------------------------------------------------------------------------------
+	/// ReadFields:
+	/// 	Reads captured fields. The event, keys and strings point into aData.
+	/// 	Returns false, if the data is truncated. The fields read until then are kept.
+	///----------------------------------------------------------------------------------------------------
+	bool ReadFields(const char* aData, size_t aSize, const char*& aEvent, std::vector<LogField_t>& aFields);
+
+	///----------------------------------------------------------------------------------------------------
+	/// FormatFields:
+	/// 	Formats captured fields into aOut as the text of the message: event key=value key="string"
+	///----------------------------------------------------------------------------------------------------
+	void FormatFields(const char* aData, size_t aSize, std::string& aOut);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Decode:
+	/// 	Decodes a binary log file into the same text the text log would contain.
+	/// 	Returns false, if the file is not a binary log or is truncated.
+	///----------------------------------------------------------------------------------------------------
+	bool Decode(std::istream& aIn, std::ostream& aOut);
+
+	///----------------------------------------------------------------------------------------------------
+	/// WriteVarint:
+	/// 	Appends a LEB128 encoded integer.
+	///----------------------------------------------------------------------------------------------------
+	void WriteVarint(std::string& aOut, uint64_t aValue);
+
+	///----------------------------------------------------------------------------------------------------
+	/// WriteString:
+	/// 	Appends a varint length followed by the bytes.
+	///----------------------------------------------------------------------------------------------------
+	void WriteString(std::string& aOut, const char* aData, size_t aSize);
+
+	///----------------------------------------------------------------------------------------------------
+	/// ZigZag:
+	/// 	Maps signed integers to unsigned ones, so small magnitudes encode small.
+	///----------------------------------------------------------------------------------------------------
+	inline uint64_t ZigZag(int64_t aValue)
+	{
+		return ((uint64_t)aValue << 1) ^ (uint64_t)(aValue >> 63);
+	}
+
+	inline int64_t UnZigZag(uint64_t aValue)
+	{
+		return (int64_t)(aValue >> 1) ^ -(int64_t)(aValue & 1);
+	}
+}
+
+#endif
@@ -0,0 +1,25 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  LogBucket.h
+/// Description  :  Contains the LogBucket_t struct definition.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef LOGBUCKET_H
+#define LOGBUCKET_H
+
+#include <cstdint>
+
+///----------------------------------------------------------------------------------------------------
+/// LogBucket_t Struct
+/// 	Token bucket state of a channel or an addon.
+///----------------------------------------------------------------------------------------------------
+struct LogBucket_t
+{
+	double    Tokens     = 0;
+	long long LastRefill = 0; /* Milliseconds, steady clock. */
+	uint64_t  Suppressed = 0; /* Messages refused since the last summary. */
+};
+
+#endif
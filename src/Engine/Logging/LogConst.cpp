@@ -8,11 +8,15 @@
 
 #include "LogConst.h"
 
+#include <algorithm>
 #include <assert.h>
+#include <atomic>
+#include <cstdio>
+#include <ctime>
 #include <iomanip>
 #include <sstream>
 
-#include "Util/Strings.h"
+#include "Util/Time.h"
 
 std::string StringFrom(ELogLevel aLevel)
 {
@@ -25,6 +29,8 @@ std::string StringFrom(ELogLevel aLevel)
 		case ELogLevel::INFO:     { return "[INFO]";     }
 		case ELogLevel::DEBUG:    { return "[DEBUG]";    }
 		case ELogLevel::TRACE:    { return "[TRACE]";    }
+		case ELogLevel::OFF:
+		case ELogLevel::ALL:      { break;               }
 	}
 
 	return "(null)";
@@ -32,8 +38,7 @@ std::string StringFrom(ELogLevel aLevel)
 
 std::string TimestampStr(const LogMsg_t* aLogMessage, bool aIncludeDate, bool aMsPrecision)
 {
-	struct tm timeinfo;
-	localtime_s(&timeinfo, (time_t*)&aLogMessage->Time);
+	struct tm timeinfo = Time::ToLocalTime(aLogMessage->Time);
 
 	std::stringstream oss;
 
@@ -55,38 +60,85 @@ std::string TimestampStr(const LogMsg_t* aLogMessage, bool aIncludeDate, bool aM
 }
 
 std::string ToString(const LogMsg_t* aLogMessage)
+{
+	std::string result;
+	ToString(aLogMessage, result);
+	return result;
+}
+
+void ToString(const LogMsg_t* aLogMessage, std::string& aOut)
 {
 	/* The null terminator is factored in, so it's effectively 2 spaces padded at the end. */
-	static size_t s_TimestampLength  = sizeof("9999-99-99 00:00:00.000 ");
-	static size_t s_MaxChannelLength = 12; // Initial value.
-	static size_t s_ChannelPadLength = sizeof("[] ");
-	static size_t s_LevelLength      = sizeof("[CRITICAL] ");
+	static size_t              s_TimestampLength  = sizeof("9999-99-99 00:00:00.000 ");
+	static std::atomic<size_t> s_MaxChannelLength = 12; // Initial value.
+	static size_t              s_ChannelPadLength = sizeof("[] ");
+	static size_t              s_LevelLength      = sizeof("[CRITICAL] ");
 
 	/* Push width for all future messages. Does not factor in square brackets and space separator. */
-	if (aLogMessage->Channel.length() > s_MaxChannelLength)
+	/* Shared by every thread formatting messages, so it only ever grows. */
+	size_t maxChannelLength = s_MaxChannelLength.load(std::memory_order_relaxed);
+
+	while (aLogMessage->Channel.length() > maxChannelLength &&
+		!s_MaxChannelLength.compare_exchange_weak(maxChannelLength, aLogMessage->Channel.length(), std::memory_order_relaxed))
 	{
-		s_MaxChannelLength = aLogMessage->Channel.length();
 	}
 
-	std::stringstream oss;
-	oss << std::left << std::setw(s_TimestampLength)                       << TimestampStr(aLogMessage, true, true);
-	oss << std::left << std::setw(s_MaxChannelLength + s_ChannelPadLength) << + "[" + aLogMessage->Channel + "]  ";
-	oss << std::left << std::setw(s_LevelLength)                           << StringFrom(aLogMessage->Level) + "  ";
+	maxChannelLength = (std::max)(maxChannelLength, aLogMessage->Channel.length());
+
+	auto pad = [&aOut](size_t aStart, size_t aWidth)
+	{
+		size_t written = aOut.size() - aStart;
+
+		if (written < aWidth)
+		{
+			aOut.append(aWidth - written, ' ');
+		}
+	};
 
-	std::vector<std::string> parts = String::Split(aLogMessage->Message, "\n");
+	/* Timestamp, same as TimestampStr(aLogMessage, true, true). */
+	struct tm timeinfo = Time::ToLocalTime(aLogMessage->Time);
 
-	for (size_t i = 0; i < parts.size(); i++)
+	char timestamp[64];
+	size_t length = strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", &timeinfo);
+	length += snprintf(timestamp + length, sizeof(timestamp) - length, ".%d", aLogMessage->TimeMsPrecision);
+
+	size_t start = aOut.size();
+	aOut.append(timestamp, length);
+	pad(start, s_TimestampLength);
+
+	start = aOut.size();
+	aOut.push_back('[');
+	aOut.append(aLogMessage->Channel);
+	aOut.append("]  ");
+	pad(start, maxChannelLength + s_ChannelPadLength);
+
+	start = aOut.size();
+	aOut.append(StringFrom(aLogMessage->Level));
+	aOut.append("  ");
+	pad(start, s_LevelLength);
+
+	/* Continuation lines are indented to the message column. */
+	const std::string& msg = aLogMessage->Message;
+	size_t lineStart = 0;
+
+	for (;;)
 	{
-		if (i == 0)
+		size_t lineEnd = msg.find('\n', lineStart);
+
+		if (lineStart > 0)
 		{
-			oss << parts[i] << "\n";
+			aOut.append(s_TimestampLength + maxChannelLength + s_ChannelPadLength + s_LevelLength, ' ');
 		}
-		else
+
+		if (lineEnd == std::string::npos)
 		{
-			oss << std::right << std::setw(s_TimestampLength + s_MaxChannelLength + s_ChannelPadLength + s_LevelLength) << " ";
-			oss << parts[i] << "\n";
+			aOut.append(msg, lineStart, std::string::npos);
+			aOut.push_back('\n');
+			break;
 		}
-	}
 
-	return oss.str();
+		aOut.append(msg, lineStart, lineEnd - lineStart);
+		aOut.push_back('\n');
+		lineStart = lineEnd + 1;
+	}
 }
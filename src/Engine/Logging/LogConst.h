@@ -34,5 +34,11 @@ std::string TimestampStr(const LogMsg_t* aLogMessage, bool aIncludeDate, bool aM
 ///----------------------------------------------------------------------------------------------------
 std::string ToString(const LogMsg_t* aLogMessage);
 
+///----------------------------------------------------------------------------------------------------
+/// ToString:
+/// 	Appends the fixed-width printable string of the log message to aOut.
+///----------------------------------------------------------------------------------------------------
+void ToString(const LogMsg_t* aLogMessage, std::string& aOut);
+
 
 #endif
@@ -25,4 +25,57 @@ enum class ELogLevel : uint32_t
 	ALL
 };
 
+///----------------------------------------------------------------------------------------------------
+/// ELogFileFormat Enumeration
+///----------------------------------------------------------------------------------------------------
+enum class ELogFileFormat : uint32_t
+{
+	Text,
+	Binary  /* Compact .nlog, arguments are stored unformatted. Decoded with LogBinary::Decode. */
+};
+
+///----------------------------------------------------------------------------------------------------
+/// ELogArgType Enumeration
+/// 	Type of a captured printf argument.
+///----------------------------------------------------------------------------------------------------
+enum class ELogArgType : uint32_t
+{
+	None,       /* "%%", no argument. */
+	Int,
+	Long,
+	LongLong,
+	SizeT,
+	IntMax,
+	PtrDiff,
+	Double,
+	LongDouble,
+	String,
+	Pointer
+};
+
+///----------------------------------------------------------------------------------------------------
+/// ELogFieldType Enumeration
+/// 	Type of a structured log field.
+///----------------------------------------------------------------------------------------------------
+enum class ELogFieldType : uint32_t
+{
+	Int,
+	UInt,
+	Double,
+	Bool,
+	String
+};
+
+///----------------------------------------------------------------------------------------------------
+/// ENLogRecord Enumeration
+/// 	Record types of the binary log file.
+///----------------------------------------------------------------------------------------------------
+enum class ENLogRecord : uint32_t
+{
+	Format  = 1, /* Format string definition. */
+	Channel = 2, /* Channel name definition. */
+	Message = 3,
+	Repeat  = 4  /* Previous message repeated. */
+};
+
 #endif
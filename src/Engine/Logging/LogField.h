@@ -0,0 +1,34 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  LogField.h
+/// Description  :  Contains the LogField_t struct definition.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef LOGFIELD_H
+#define LOGFIELD_H
+
+#include <cstdint>
+
+#include "LogEnum.h"
+
+///----------------------------------------------------------------------------------------------------
+/// LogField_t Struct
+/// 	Typed key/value pair of a structured log message. Type selects the member of the union.
+///----------------------------------------------------------------------------------------------------
+struct LogField_t
+{
+	const char*   Key;
+	ELogFieldType Type;
+	union
+	{
+		int64_t     Int;
+		uint64_t    UInt;
+		double      Double;
+		bool        Bool;
+		const char* String;
+	};
+};
+
+#endif
@@ -10,8 +10,11 @@
 #define LOGFUNCDEFS_H
 
 #include "LogEnum.h"
+#include "LogField.h"
 
 typedef void (*LOGGER_LOG) (ELogLevel aLogLevel, const char* aStr);
 typedef void (*LOGGER_LOG2)(ELogLevel aLogLevel, const char* aChannel, const char* aStr);
+typedef bool (*LOGGER_SHOULDLOG)(ELogLevel aLogLevel);
+typedef void (*LOGGER_LOGSTRUCTURED)(ELogLevel aLogLevel, const char* aChannel, const char* aEvent, const LogField_t* aFields, uint32_t aFieldCount);
 
 #endif
@@ -0,0 +1,434 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  LogIndex.cpp
+/// Description  :  Incremental search index over a store of log messages.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include "LogIndex.h"
+
+#include <algorithm>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+///----------------------------------------------------------------------------------------------------
+/// HighestBit:
+/// 	Returns the index of the highest set bit. aBits must not be 0.
+///----------------------------------------------------------------------------------------------------
+static uint32_t HighestBit(uint64_t aBits)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanReverse64(&index, aBits);
+	return (uint32_t)index;
+#else
+	return 63 - (uint32_t)__builtin_clzll(aBits);
+#endif
+}
+
+///----------------------------------------------------------------------------------------------------
+/// ToLower:
+/// 	Lowercases ASCII letters. Cheaper than tolower, which consults the locale.
+///----------------------------------------------------------------------------------------------------
+static inline char ToLower(char aChar)
+{
+	return (aChar >= 'A' && aChar <= 'Z') ? aChar + ('a' - 'A') : aChar;
+}
+
+///----------------------------------------------------------------------------------------------------
+/// CountBits:
+/// 	Returns the amount of set bits.
+///----------------------------------------------------------------------------------------------------
+static uint32_t CountBits(uint64_t aBits)
+{
+#ifdef _MSC_VER
+	return (uint32_t)__popcnt64(aBits);
+#else
+	return (uint32_t)__builtin_popcountll(aBits);
+#endif
+}
+
+///----------------------------------------------------------------------------------------------------
+/// SetBit:
+/// 	Sets a bit, growing the bitmap as needed.
+///----------------------------------------------------------------------------------------------------
+static void SetBit(std::vector<uint64_t>& aBits, uint32_t aIndex)
+{
+	if (aBits.size() <= aIndex / 64)
+	{
+		aBits.resize(aIndex / 64 + 1, 0);
+	}
+
+	aBits[aIndex / 64] |= 1ull << (aIndex % 64);
+}
+
+///----------------------------------------------------------------------------------------------------
+/// GetWord:
+/// 	Returns a word of the bitmap, words past its end are 0.
+///----------------------------------------------------------------------------------------------------
+static uint64_t GetWord(const std::vector<uint64_t>& aBits, size_t aWord)
+{
+	return aWord < aBits.size() ? aBits[aWord] : 0;
+}
+
+///----------------------------------------------------------------------------------------------------
+/// GetTrigrams:
+/// 	Writes the distinct lowercase trigrams of aText to aOut.
+///----------------------------------------------------------------------------------------------------
+static void GetTrigrams(const std::string& aText, std::vector<uint32_t>& aOut)
+{
+	aOut.clear();
+
+	for (size_t i = 0; i + 2 < aText.size(); i++)
+	{
+		aOut.push_back(
+			(uint32_t)(unsigned char)ToLower(aText[i]) << 16 |
+			(uint32_t)(unsigned char)ToLower(aText[i + 1]) << 8 |
+			(uint32_t)(unsigned char)ToLower(aText[i + 2])
+		);
+	}
+
+	std::sort(aOut.begin(), aOut.end());
+	aOut.erase(std::unique(aOut.begin(), aOut.end()), aOut.end());
+}
+
+///----------------------------------------------------------------------------------------------------
+/// ContainsNoCase:
+/// 	Returns true, if aText contains aSearch, ignoring the case.
+///----------------------------------------------------------------------------------------------------
+static bool ContainsNoCase(const std::string& aText, const std::string& aSearch)
+{
+	return std::search(aText.begin(), aText.end(), aSearch.begin(), aSearch.end(), [](char aLeft, char aRight)
+	{
+		return ToLower(aLeft) == ToLower(aRight);
+	}) != aText.end();
+}
+
+uint32_t CLogIndex::Add(const LogMsg_t* aLogEntry)
+{
+	uint32_t id = this->GetNextID();
+
+	this->Entries.push_back(aLogEntry);
+
+	uint32_t bit = id - this->BaseID;
+
+	if (aLogEntry->Level > ELogLevel::OFF && aLogEntry->Level < ELogLevel::ALL)
+	{
+		SetBit(this->LevelBits[(uint32_t)aLogEntry->Level], bit);
+	}
+
+	auto it = this->ChannelLookup.find(aLogEntry->Channel);
+
+	if (it == this->ChannelLookup.end())
+	{
+		it = this->ChannelLookup.emplace(aLogEntry->Channel, (uint32_t)this->ChannelBits.size()).first;
+		this->ChannelBits.emplace_back();
+	}
+
+	SetBit(this->ChannelBits[it->second], bit);
+
+	GetTrigrams(aLogEntry->Message, this->Keys);
+
+	for (uint32_t key : this->Keys)
+	{
+		this->Trigrams[key].push_back(id);
+	}
+
+	return id;
+}
+
+void CLogIndex::Evict()
+{
+	if (this->Entries.empty()) { return; }
+
+	this->Entries.pop_front();
+	this->FirstID++;
+
+	this->Compact();
+}
+
+void CLogIndex::Clear()
+{
+	this->FirstID   = this->GetNextID();
+	this->BaseID    = this->FirstID - this->FirstID % 64;
+	this->Compacted = this->FirstID;
+
+	this->Entries.clear();
+
+	for (std::vector<uint64_t>& bits : this->LevelBits)
+	{
+		bits.clear();
+	}
+
+	this->ChannelLookup.clear();
+	this->ChannelBits.clear();
+	this->Trigrams.clear();
+}
+
+void CLogIndex::Query(const LogQuery_t& aQuery, std::vector<uint32_t>& aOut, size_t aMaxResults)
+{
+	aOut.clear();
+
+	uint32_t first = this->FirstID;
+	uint32_t last  = this->GetNextID();
+
+	/* Messages are stored in order, so the time filter is a range. */
+	if (aQuery.Since > 0)
+	{
+		auto it = std::partition_point(this->Entries.begin(), this->Entries.end(), [&aQuery](const LogMsg_t* aLogEntry)
+		{
+			return aLogEntry->Time < aQuery.Since;
+		});
+
+		first += (uint32_t)(it - this->Entries.begin());
+	}
+
+	if (first >= last || !this->BuildMask(aQuery, first, last)) { return; }
+
+	/* ID of bit 0 of the Mask. */
+	uint32_t maskBase = first - (first - this->BaseID) % 64;
+
+	std::vector<const std::vector<uint32_t>*> lists;
+
+	if (aQuery.Text.size() >= 3)
+	{
+		GetTrigrams(aQuery.Text, this->Keys);
+
+		for (uint32_t key : this->Keys)
+		{
+			auto it = this->Trigrams.find(key);
+
+			if (it == this->Trigrams.end()) { return; }
+
+			lists.push_back(&it->second);
+		}
+
+		std::sort(lists.begin(), lists.end(), [](const std::vector<uint32_t>* aLeft, const std::vector<uint32_t>* aRight)
+		{
+			return aLeft->size() < aRight->size();
+		});
+	}
+
+	std::vector<uint32_t>::const_iterator begin;
+	std::vector<uint32_t>::const_iterator it;
+
+	if (!lists.empty())
+	{
+		begin = std::lower_bound(lists[0]->begin(), lists[0]->end(), first);
+		it    = std::lower_bound(begin, lists[0]->end(), last);
+
+		/* The level and channel filter is more selective than the text, check the text directly. */
+		size_t amtMasked = 0;
+
+		for (uint64_t bits : this->Mask)
+		{
+			amtMasked += CountBits(bits);
+		}
+
+		if (amtMasked < (size_t)(it - begin))
+		{
+			lists.clear();
+		}
+	}
+
+	if (!lists.empty())
+	{
+		/* Walk the shortest posting list, newest first, and probe the others. */
+		while (it != begin)
+		{
+			uint32_t id  = *--it;
+			uint32_t bit = id - maskBase;
+
+			if (!(this->Mask[bit / 64] >> (bit % 64) & 1)) { continue; }
+
+			bool isCandidate = true;
+
+			for (size_t i = 1; i < lists.size() && isCandidate; i++)
+			{
+				isCandidate = std::binary_search(lists[i]->begin(), lists[i]->end(), id);
+			}
+
+			/* Trigrams can match out of order, the text has to be checked. */
+			if (!isCandidate || !ContainsNoCase(this->Entries[id - this->FirstID]->Message, aQuery.Text)) { continue; }
+
+			aOut.push_back(id);
+
+			if (aMaxResults > 0 && aOut.size() >= aMaxResults) { break; }
+		}
+	}
+	else
+	{
+		for (size_t w = this->Mask.size(); w-- > 0 && (aMaxResults == 0 || aOut.size() < aMaxResults);)
+		{
+			uint64_t bits = this->Mask[w];
+
+			while (bits)
+			{
+				uint32_t bit = HighestBit(bits);
+				bits &= ~(1ull << bit);
+
+				uint32_t id = maskBase + (uint32_t)w * 64 + bit;
+
+				if (!aQuery.Text.empty() && !ContainsNoCase(this->Entries[id - this->FirstID]->Message, aQuery.Text)) { continue; }
+
+				aOut.push_back(id);
+
+				if (aMaxResults > 0 && aOut.size() >= aMaxResults) { break; }
+			}
+		}
+	}
+
+	std::reverse(aOut.begin(), aOut.end());
+}
+
+bool CLogIndex::Matches(const LogQuery_t& aQuery, uint32_t aID) const
+{
+	const LogMsg_t* msg = this->Get(aID);
+
+	if (!msg) { return false; }
+
+	if (aQuery.Level != ELogLevel::ALL)
+	{
+		if (aQuery.IsExactLevel ? msg->Level != aQuery.Level : msg->Level > aQuery.Level)
+		{
+			return false;
+		}
+	}
+
+	if (!aQuery.Channels.empty() && std::find(aQuery.Channels.begin(), aQuery.Channels.end(), msg->Channel) == aQuery.Channels.end())
+	{
+		return false;
+	}
+
+	if (msg->Time < aQuery.Since)
+	{
+		return false;
+	}
+
+	return aQuery.Text.empty() || ContainsNoCase(msg->Message, aQuery.Text);
+}
+
+const LogMsg_t* CLogIndex::Get(uint32_t aID) const
+{
+	if (aID - this->FirstID >= this->Entries.size()) { return nullptr; }
+
+	return this->Entries[aID - this->FirstID];
+}
+
+uint32_t CLogIndex::GetFirstID() const
+{
+	return this->FirstID;
+}
+
+uint32_t CLogIndex::GetNextID() const
+{
+	return this->FirstID + (uint32_t)this->Entries.size();
+}
+
+void CLogIndex::Compact()
+{
+	if (this->FirstID - this->Compacted < (std::max)(this->Entries.size(), (size_t)4096)) { return; }
+
+	this->Compacted = this->FirstID;
+
+	size_t words = (this->FirstID - this->BaseID) / 64;
+
+	auto dropWords = [words](std::vector<uint64_t>& aBits)
+	{
+		aBits.erase(aBits.begin(), aBits.begin() + (std::min)(words, aBits.size()));
+	};
+
+	for (std::vector<uint64_t>& bits : this->LevelBits)
+	{
+		dropWords(bits);
+	}
+
+	for (std::vector<uint64_t>& bits : this->ChannelBits)
+	{
+		dropWords(bits);
+	}
+
+	this->BaseID += (uint32_t)words * 64;
+
+	for (auto it = this->Trigrams.begin(); it != this->Trigrams.end();)
+	{
+		std::vector<uint32_t>& ids = it->second;
+		ids.erase(ids.begin(), std::lower_bound(ids.begin(), ids.end(), this->FirstID));
+
+		if (ids.empty())
+		{
+			it = this->Trigrams.erase(it);
+			continue;
+		}
+
+		it++;
+	}
+}
+
+bool CLogIndex::BuildMask(const LogQuery_t& aQuery, uint32_t aFirst, uint32_t aLast)
+{
+	size_t wordFirst = (aFirst - this->BaseID) / 64;
+	size_t wordLast  = (aLast - 1 - this->BaseID) / 64;
+
+	this->Mask.assign(wordLast - wordFirst + 1, ~0ull);
+
+	if (aQuery.Level != ELogLevel::ALL)
+	{
+		uint32_t levelFirst = aQuery.IsExactLevel ? (uint32_t)aQuery.Level : (uint32_t)ELogLevel::CRITICAL;
+		uint32_t levelLast  = (uint32_t)aQuery.Level;
+
+		for (size_t w = wordFirst; w <= wordLast; w++)
+		{
+			uint64_t bits = 0;
+
+			for (uint32_t level = levelFirst; level <= levelLast && level < (uint32_t)ELogLevel::ALL; level++)
+			{
+				bits |= GetWord(this->LevelBits[level], w);
+			}
+
+			this->Mask[w - wordFirst] &= bits;
+		}
+	}
+
+	if (!aQuery.Channels.empty())
+	{
+		std::vector<const std::vector<uint64_t>*> channels;
+
+		for (const std::string& channel : aQuery.Channels)
+		{
+			auto it = this->ChannelLookup.find(channel);
+
+			if (it != this->ChannelLookup.end())
+			{
+				channels.push_back(&this->ChannelBits[it->second]);
+			}
+		}
+
+		if (channels.empty()) { return false; }
+
+		for (size_t w = wordFirst; w <= wordLast; w++)
+		{
+			uint64_t bits = 0;
+
+			for (const std::vector<uint64_t>* channel : channels)
+			{
+				bits |= GetWord(*channel, w);
+			}
+
+			this->Mask[w - wordFirst] &= bits;
+		}
+	}
+
+	/* Clear the bits before aFirst and from aLast on. */
+	this->Mask.front() &= ~0ull << ((aFirst - this->BaseID) % 64);
+
+	if ((aLast - this->BaseID) % 64 != 0)
+	{
+		this->Mask.back() &= (1ull << ((aLast - this->BaseID) % 64)) - 1;
+	}
+
+	return true;
+}
@@ -0,0 +1,108 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  LogIndex.h
+/// Description  :  Incremental search index over a store of log messages.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef LOGINDEX_H
+#define LOGINDEX_H
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "LogMsg.h"
+#include "LogQuery.h"
+
+///----------------------------------------------------------------------------------------------------
+/// CLogIndex Class
+/// 	Indexes messages in the order they are stored and evicted, oldest first.
+/// 	Levels and channels are kept as bitmaps, message text as trigram posting lists.
+/// 	Every message gets an ascending ID, the oldest indexed message is GetFirstID().
+///----------------------------------------------------------------------------------------------------
+class CLogIndex
+{
+	public:
+	///----------------------------------------------------------------------------------------------------
+	/// Add:
+	/// 	Indexes a message and returns its ID.
+	/// 	The message is referenced, not copied, and has to stay valid until it is evicted.
+	///----------------------------------------------------------------------------------------------------
+	uint32_t Add(const LogMsg_t* aLogEntry);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Evict:
+	/// 	Removes the oldest message from the index.
+	///----------------------------------------------------------------------------------------------------
+	void Evict();
+
+	///----------------------------------------------------------------------------------------------------
+	/// Clear:
+	/// 	Removes all messages from the index.
+	///----------------------------------------------------------------------------------------------------
+	void Clear();
+
+	///----------------------------------------------------------------------------------------------------
+	/// Query:
+	/// 	Writes the IDs of the newest aMaxResults matching messages to aOut, in ascending order.
+	/// 	aMaxResults 0 returns all matches.
+	///----------------------------------------------------------------------------------------------------
+	void Query(const LogQuery_t& aQuery, std::vector<uint32_t>& aOut, size_t aMaxResults = 0);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Matches:
+	/// 	Returns true, if the message with the given ID matches the query.
+	///----------------------------------------------------------------------------------------------------
+	bool Matches(const LogQuery_t& aQuery, uint32_t aID) const;
+
+	///----------------------------------------------------------------------------------------------------
+	/// Get:
+	/// 	Returns the message with the given ID or nullptr, if it is not indexed.
+	///----------------------------------------------------------------------------------------------------
+	const LogMsg_t* Get(uint32_t aID) const;
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetFirstID:
+	/// 	Returns the ID of the oldest indexed message.
+	///----------------------------------------------------------------------------------------------------
+	uint32_t GetFirstID() const;
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetNextID:
+	/// 	Returns the ID the next added message will get.
+	///----------------------------------------------------------------------------------------------------
+	uint32_t GetNextID() const;
+
+	private:
+	std::deque<const LogMsg_t*>                         Entries;       /* Indexed by ID - FirstID. */
+	uint32_t                                            FirstID   = 0;
+	uint32_t                                            BaseID    = 0; /* ID of bit 0 of the bitmaps, a multiple of 64. */
+	uint32_t                                            Compacted = 0; /* FirstID at the last compaction. */
+
+	std::vector<uint64_t>                               LevelBits[(uint32_t)ELogLevel::ALL];
+	std::unordered_map<std::string, uint32_t>           ChannelLookup;
+	std::vector<std::vector<uint64_t>>                  ChannelBits;   /* Indexed by channel ID. */
+	std::unordered_map<uint32_t, std::vector<uint32_t>> Trigrams;      /* Lowercase trigram to ascending IDs. */
+
+	std::vector<uint64_t>                               Mask;          /* Query scratch, bit 0 is the query's first ID. */
+	std::vector<uint32_t>                               Keys;          /* Trigram scratch. */
+
+	///----------------------------------------------------------------------------------------------------
+	/// Compact:
+	/// 	Drops evicted IDs from the bitmaps and posting lists, once as many were evicted as are indexed.
+	///----------------------------------------------------------------------------------------------------
+	void Compact();
+
+	///----------------------------------------------------------------------------------------------------
+	/// BuildMask:
+	/// 	Fills the Mask with the level and channel filter of the query for IDs aFirst to aLast.
+	/// 	Returns false, if nothing can match.
+	///----------------------------------------------------------------------------------------------------
+	bool BuildMask(const LogQuery_t& aQuery, uint32_t aFirst, uint32_t aLast);
+};
+
+#endif
@@ -0,0 +1,182 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  LogJsonWriter.cpp
+/// Description  :  Logger implementation to write JSON Lines to a file.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include "LogJsonWriter.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#include "LogBinary.h"
+#include "Util/Time.h"
+
+///----------------------------------------------------------------------------------------------------
+/// AppendEscaped:
+/// 	Appends a quoted JSON string. Bytes above 0x7F are passed through, the text is UTF-8.
+///----------------------------------------------------------------------------------------------------
+static void AppendEscaped(std::string& aOut, const char* aStr, size_t aLength)
+{
+	aOut.push_back('"');
+
+	for (size_t i = 0; i < aLength; i++)
+	{
+		char c = aStr[i];
+
+		switch (c)
+		{
+			case '"':  { aOut.append("\\\""); break; }
+			case '\\': { aOut.append("\\\\"); break; }
+			case '\n': { aOut.append("\\n"); break; }
+			case '\r': { aOut.append("\\r"); break; }
+			case '\t': { aOut.append("\\t"); break; }
+			default:
+			{
+				if ((unsigned char)c < 0x20)
+				{
+					char buffer[8];
+					snprintf(buffer, sizeof(buffer), "\\u%04x", (unsigned char)c);
+					aOut.append(buffer);
+				}
+				else
+				{
+					aOut.push_back(c);
+				}
+				break;
+			}
+		}
+	}
+
+	aOut.push_back('"');
+}
+
+static void AppendEscaped(std::string& aOut, const std::string& aStr)
+{
+	AppendEscaped(aOut, aStr.data(), aStr.size());
+}
+
+///----------------------------------------------------------------------------------------------------
+/// LevelName:
+/// 	Returns the lowercase name of a log level.
+///----------------------------------------------------------------------------------------------------
+static const char* LevelName(ELogLevel aLevel)
+{
+	switch (aLevel)
+	{
+		case ELogLevel::CRITICAL: { return "critical"; }
+		case ELogLevel::WARNING:  { return "warning";  }
+		case ELogLevel::INFO:     { return "info";     }
+		case ELogLevel::DEBUG:    { return "debug";    }
+		case ELogLevel::TRACE:    { return "trace";    }
+		default:                  { return "unknown";  }
+	}
+}
+
+CJsonLogger::CJsonLogger(ELogLevel aLogLevel, std::filesystem::path aPath)
+{
+	this->SetLogLevel(aLogLevel);
+	this->File.open(aPath, std::ios::out | std::ios::trunc | std::ios::binary);
+}
+
+CJsonLogger::~CJsonLogger()
+{
+	if (this->File.is_open())
+	{
+		this->File.flush();
+		this->File.close();
+	}
+}
+
+void CJsonLogger::MsgProc(const LogMsg_t* aLogEntry)
+{
+	if (!this->File.is_open()) { return; }
+
+	char buffer[64];
+
+	this->Line.clear();
+
+	/* Epoch milliseconds for consumers, local time as in the text log for reading. */
+	tm timeinfo = Time::ToLocalTime(aLogEntry->Time);
+	size_t length = strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", &timeinfo);
+	length += snprintf(buffer + length, sizeof(buffer) - length, ".%03d", aLogEntry->TimeMsPrecision);
+
+	this->Line.append("{\"ts\":");
+	this->Line.append(std::to_string(aLogEntry->Time * 1000 + aLogEntry->TimeMsPrecision));
+	this->Line.append(",\"time\":");
+	AppendEscaped(this->Line, buffer, length);
+	this->Line.append(",\"level\":\"");
+	this->Line.append(LevelName(aLogEntry->Level));
+	this->Line.append("\",\"channel\":");
+	AppendEscaped(this->Line, aLogEntry->Channel);
+	this->Line.append(",\"message\":");
+	AppendEscaped(this->Line, aLogEntry->Message);
+
+	if (aLogEntry->RepeatCount > 1)
+	{
+		this->Line.append(",\"repeat\":");
+		this->Line.append(std::to_string(aLogEntry->RepeatCount));
+	}
+
+	const char* evt = nullptr;
+
+	if (!aLogEntry->Fields.empty())
+	{
+		LogBinary::ReadFields(aLogEntry->Fields.data(), aLogEntry->Fields.size(), evt, this->Fields);
+	}
+
+	if (evt)
+	{
+		this->Line.append(",\"event\":");
+		AppendEscaped(this->Line, evt, strlen(evt));
+		this->Line.append(",\"fields\":{");
+
+		for (size_t i = 0; i < this->Fields.size(); i++)
+		{
+			const LogField_t& field = this->Fields[i];
+
+			if (i > 0) { this->Line.push_back(','); }
+
+			AppendEscaped(this->Line, field.Key, strlen(field.Key));
+			this->Line.push_back(':');
+
+			switch (field.Type)
+			{
+				case ELogFieldType::Int:    { this->Line.append(std::to_string(field.Int)); break; }
+				case ELogFieldType::UInt:   { this->Line.append(std::to_string(field.UInt)); break; }
+				case ELogFieldType::Double:
+				{
+					/* JSON has no representation for NaN and infinity. */
+					if (!std::isfinite(field.Double))
+					{
+						this->Line.append("null");
+						break;
+					}
+
+					snprintf(buffer, sizeof(buffer), "%.17g", field.Double);
+					this->Line.append(buffer);
+					break;
+				}
+				case ELogFieldType::Bool:   { this->Line.append(field.Bool ? "true" : "false"); break; }
+				case ELogFieldType::String: { AppendEscaped(this->Line, field.String, strlen(field.String)); break; }
+				default:                    { this->Line.append("null"); break; }
+			}
+		}
+
+		this->Line.push_back('}');
+	}
+
+	this->Line.append("}\n");
+
+	this->File.write(this->Line.data(), this->Line.size());
+
+	/* Don't lose the important ones to the stream buffer. */
+	if (aLogEntry->Level <= ELogLevel::WARNING)
+	{
+		this->File.flush();
+	}
+}
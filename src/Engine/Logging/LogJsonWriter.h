@@ -0,0 +1,50 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  LogJsonWriter.h
+/// Description  :  Logger implementation to write JSON Lines to a file.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef LOGJSONWRITER_H
+#define LOGJSONWRITER_H
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "LogBase.h"
+#include "LogField.h"
+
+///----------------------------------------------------------------------------------------------------
+/// CJsonLogger Class
+/// 	Writes one JSON object per message. Structured messages keep their event and typed fields,
+/// 	so the file can be consumed without parsing the text.
+///----------------------------------------------------------------------------------------------------
+class CJsonLogger : public virtual ILogger
+{
+	public:
+	///----------------------------------------------------------------------------------------------------
+	/// ctor
+	///----------------------------------------------------------------------------------------------------
+	CJsonLogger(ELogLevel aLogLevel, std::filesystem::path aPath);
+
+	///----------------------------------------------------------------------------------------------------
+	/// dtor
+	///----------------------------------------------------------------------------------------------------
+	~CJsonLogger();
+
+	///----------------------------------------------------------------------------------------------------
+	/// MsgProc:
+	/// 	Message processing function.
+	///----------------------------------------------------------------------------------------------------
+	void MsgProc(const LogMsg_t* aLogEntry) override;
+
+	private:
+	std::ofstream           File;
+	std::string             Line;   /* Reused, so writing does not allocate. */
+	std::vector<LogField_t> Fields;
+};
+
+#endif
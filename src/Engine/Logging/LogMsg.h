@@ -9,6 +9,7 @@
 #ifndef LOGMSG_H
 #define LOGMSG_H
 
+#include <cstdint>
 #include <string>
 
 #include "LogEnum.h"
@@ -24,6 +25,10 @@ struct LogMsg_t
 	std::string Channel;
 	std::string Message;
 	int         RepeatCount = 1;
+	uint32_t    FormatID    = 0;       /* Non-zero, if the message was formatted deferred. */
+	const char* Format      = nullptr; /* Format string of FormatID, owned by the CLogApi. */
+	std::string Args;                  /* Captured arguments of FormatID, see LogBinary::Capture. */
+	std::string Fields;                /* Captured event and fields, if the message is structured. See LogBinary::CaptureFields. */
 };
 
 #endif
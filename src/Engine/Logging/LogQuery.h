@@ -0,0 +1,30 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  LogQuery.h
+/// Description  :  Contains the LogQuery_t struct definition.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef LOGQUERY_H
+#define LOGQUERY_H
+
+#include <string>
+#include <vector>
+
+#include "LogEnum.h"
+
+///----------------------------------------------------------------------------------------------------
+/// LogQuery_t Struct
+/// 	Filter of a CLogIndex query. Unset fields match every message.
+///----------------------------------------------------------------------------------------------------
+struct LogQuery_t
+{
+	ELogLevel                Level        = ELogLevel::ALL; /* Messages of this level or more severe. */
+	bool                     IsExactLevel = false;          /* Only messages of exactly this level. */
+	std::vector<std::string> Channels;                      /* Messages of any of these channels. */
+	std::string              Text;                          /* Case-insensitive substring of the message. */
+	long long                Since        = 0;              /* Messages logged at or after this timestamp. */
+};
+
+#endif
@@ -0,0 +1,35 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  LogQueue.h
+/// Description  :  Contains the LogQueueSlot_t struct definition.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef LOGQUEUE_H
+#define LOGQUEUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "LogEnum.h"
+
+constexpr uint32_t LOG_FORMAT_STRUCTURED = UINT32_MAX; /* FormatID of structured messages. */
+
+///----------------------------------------------------------------------------------------------------
+/// LogQueueSlot_t Struct
+/// 	Slot of the log queue. The strings keep their capacity, so reusing a slot does not allocate.
+///----------------------------------------------------------------------------------------------------
+struct LogQueueSlot_t
+{
+	std::atomic<size_t> Sequence;        /* Position the slot can be written (== pos) or read (== pos + 1) at. */
+	ELogLevel           Level;
+	long long           Time;
+	int                 TimeMsPrecision;
+	std::string         Channel;
+	std::string         Message;         /* Text, or the captured arguments or fields if FormatID is set. */
+	uint32_t            FormatID;
+};
+
+#endif
@@ -0,0 +1,24 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  LogRateLimit.h
+/// Description  :  Contains the LogRateLimit_t struct definition.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef LOGRATELIMIT_H
+#define LOGRATELIMIT_H
+
+#include <cstdint>
+
+///----------------------------------------------------------------------------------------------------
+/// LogRateLimit_t Struct
+/// 	Token bucket parameters. A Rate of 0 disables the limit.
+///----------------------------------------------------------------------------------------------------
+struct LogRateLimit_t
+{
+	uint32_t Rate  = 0; /* Messages per second refilled into the bucket. */
+	uint32_t Burst = 0; /* Size of the bucket, messages allowed at once. */
+};
+
+#endif
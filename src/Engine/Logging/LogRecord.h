@@ -0,0 +1,35 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  LogRecord.h
+/// Description  :  Contains the LogRecord_t struct definition.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef LOGRECORD_H
+#define LOGRECORD_H
+
+#include <cstdint>
+
+#include "LogEnum.h"
+
+constexpr size_t LOG_ARENA_CHUNK_SIZE = 64 * 1024;
+
+///----------------------------------------------------------------------------------------------------
+/// LogRecord_t Struct
+/// 	Retained log message. The channel is interned and the text lives in the message arena.
+///----------------------------------------------------------------------------------------------------
+struct LogRecord_t
+{
+	ELogLevel Level;
+	long long Time;
+	int       TimeMsPrecision;
+	uint32_t  ChannelID;
+	uint32_t  RepeatCount;
+	uint32_t  Chunk;
+	uint32_t  Offset;
+	uint32_t  Length;
+	bool      IsStructured; /* The text is the captured event and fields, formatted on materialization. */
+};
+
+#endif
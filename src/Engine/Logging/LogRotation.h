@@ -0,0 +1,26 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  LogRotation.h
+/// Description  :  Contains the LogRotation_t struct definition.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef LOGROTATION_H
+#define LOGROTATION_H
+
+#include <cstdint>
+
+///----------------------------------------------------------------------------------------------------
+/// LogRotation_t Struct
+/// 	Rotation policy of a log file. A limit of 0 disables it.
+///----------------------------------------------------------------------------------------------------
+struct LogRotation_t
+{
+	uint64_t MaxFileSize  = 0; /* Bytes after which the file is rotated to <name>.1. */
+	uint32_t MaxFileAge   = 0; /* Seconds after which the file is rotated. */
+	uint32_t MaxFiles     = 0; /* Amount of rotated files kept, <name>.1 to <name>.N. */
+	uint64_t MaxTotalSize = 0; /* Bytes written in total, after which writing stops. */
+};
+
+#endif
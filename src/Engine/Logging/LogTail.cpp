@@ -0,0 +1,135 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  LogTail.cpp
+/// Description  :  Logger implementation to keep the latest lines in a memory-mapped file.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include "LogTail.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "LogConst.h"
+#include "Util/Platform.h"
+
+CLogTail::CLogTail(ELogLevel aLogLevel, std::filesystem::path aPath, std::filesystem::path aRecoveryPath, size_t aCapacity)
+{
+	this->SetLogLevel(aLogLevel);
+
+	this->Capacity = aCapacity;
+	this->Size     = sizeof(LogTailHeader_t) + aCapacity;
+
+	void* view = Platform::OpenMappedFile(aPath, this->Size, this->Handle);
+
+	if (!view) { return; }
+
+	this->Header = static_cast<LogTailHeader_t*>(view);
+	this->Data   = static_cast<char*>(view) + sizeof(LogTailHeader_t);
+
+	this->Recover(aRecoveryPath);
+
+	this->Header->Magic    = LOGTAIL_MAGIC;
+	this->Header->Version  = LOGTAIL_VERSION;
+	this->Header->Capacity = static_cast<uint32_t>(aCapacity);
+	this->Header->IsClean  = 0;
+	this->Header->Reserved.store(0, std::memory_order_relaxed);
+	this->Header->Head.store(0, std::memory_order_release);
+}
+
+CLogTail::~CLogTail()
+{
+	Platform::CloseSharedMemory(this->Header, this->Size, this->Handle);
+}
+
+void CLogTail::MsgProc(const LogMsg_t* aLogEntry)
+{
+	if (!this->Header) { return; }
+
+	this->Line.clear();
+	ToString(aLogEntry, this->Line);
+
+	/* A line may take at most half of the ring, so the previous lines stay recoverable. */
+	if (this->Line.size() > this->Capacity / 2)
+	{
+		this->Line.resize(this->Capacity / 2 - 1);
+		this->Line.push_back('\n');
+	}
+
+	/* Only called from the log processor thread, there is a single writer. */
+	uint64_t head   = this->Header->Head.load(std::memory_order_relaxed);
+	size_t   length = this->Line.size();
+
+	this->Header->Reserved.store(head + length, std::memory_order_release);
+
+	size_t offset = static_cast<size_t>(head % this->Capacity);
+	size_t first  = (std::min)(length, this->Capacity - offset);
+
+	memcpy(this->Data + offset, this->Line.data(), first);
+	memcpy(this->Data, this->Line.data() + first, length - first);
+
+	this->Header->Head.store(head + length, std::memory_order_release);
+}
+
+bool CLogTail::HasRecovered() const
+{
+	return this->Recovered;
+}
+
+void CLogTail::MarkClean()
+{
+	if (!this->Header) { return; }
+
+	this->Header->IsClean = 1;
+}
+
+void CLogTail::Recover(const std::filesystem::path& aPath)
+{
+	const LogTailHeader_t* header = this->Header;
+
+	if (header->Magic != LOGTAIL_MAGIC || header->Version != LOGTAIL_VERSION || header->IsClean)
+	{
+		return;
+	}
+
+	/* A bigger ring of an earlier session was not mapped completely. */
+	if (header->Capacity == 0 || header->Capacity > this->Capacity)
+	{
+		return;
+	}
+
+	uint64_t capacity = header->Capacity;
+	uint64_t head     = header->Head.load(std::memory_order_acquire);
+	uint64_t reserved = (std::max)(header->Reserved.load(std::memory_order_acquire), head);
+
+	if (head == 0) { return; }
+
+	/* The line being copied when the process died overwrote the oldest bytes up to reserved. */
+	uint64_t start = reserved > capacity ? reserved - capacity : 0;
+
+	if (start >= head) { return; }
+
+	std::string text;
+	text.reserve(static_cast<size_t>(head - start));
+
+	for (uint64_t i = start; i < head; i++)
+	{
+		text.push_back(this->Data[i % capacity]);
+	}
+
+	/* The oldest line was cut by the wrap, start at the next full one. */
+	if (start > 0)
+	{
+		size_t lineEnd = text.find('\n');
+		text.erase(0, lineEnd == std::string::npos ? text.size() : lineEnd + 1);
+	}
+
+	std::ofstream file(aPath, std::ios_base::out);
+
+	if (!file.is_open()) { return; }
+
+	file.write(text.data(), text.size());
+	this->Recovered = true;
+}
@@ -0,0 +1,72 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  LogTail.h
+/// Description  :  Logger implementation to keep the latest lines in a memory-mapped file.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef LOGTAIL_H
+#define LOGTAIL_H
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+
+#include "LogBase.h"
+#include "LogTailHeader.h"
+
+///----------------------------------------------------------------------------------------------------
+/// CLogTail Class
+/// 	Writes every line straight into a mapped ring. The OS keeps the pages if the process dies,
+/// 	so the lines the file logger had not written yet survive a crash.
+///----------------------------------------------------------------------------------------------------
+class CLogTail : public virtual ILogger
+{
+	public:
+	///----------------------------------------------------------------------------------------------------
+	/// ctor
+	/// 	If the tail at aPath was not marked clean, its lines are written to aRecoveryPath first.
+	///----------------------------------------------------------------------------------------------------
+	CLogTail(ELogLevel aLogLevel, std::filesystem::path aPath, std::filesystem::path aRecoveryPath, size_t aCapacity = 1024 * 1024);
+
+	///----------------------------------------------------------------------------------------------------
+	/// dtor
+	///----------------------------------------------------------------------------------------------------
+	~CLogTail();
+
+	///----------------------------------------------------------------------------------------------------
+	/// MsgProc:
+	/// 	Message processing function.
+	///----------------------------------------------------------------------------------------------------
+	void MsgProc(const LogMsg_t* aLogEntry) override;
+
+	///----------------------------------------------------------------------------------------------------
+	/// HasRecovered:
+	/// 	Returns true if the previous session did not shut down cleanly and its tail was recovered.
+	///----------------------------------------------------------------------------------------------------
+	bool HasRecovered() const;
+
+	///----------------------------------------------------------------------------------------------------
+	/// MarkClean:
+	/// 	Marks the tail as cleanly shut down, so the next session does not recover it.
+	///----------------------------------------------------------------------------------------------------
+	void MarkClean();
+
+	private:
+	LogTailHeader_t* Header    = nullptr;
+	char*            Data      = nullptr;
+	size_t           Capacity  = 0;
+	size_t           Size      = 0;       /* Mapped bytes, header and data. */
+	void*            Handle    = nullptr;
+	bool             Recovered = false;
+	std::string      Line;                /* Reused buffer of the formatted line. */
+
+	///----------------------------------------------------------------------------------------------------
+	/// Recover:
+	/// 	Writes the committed lines of a dirty tail to aPath.
+	///----------------------------------------------------------------------------------------------------
+	void Recover(const std::filesystem::path& aPath);
+};
+
+#endif
@@ -0,0 +1,33 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  LogTailHeader.h
+/// Description  :  Contains the LogTailHeader_t struct definition.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef LOGTAILHEADER_H
+#define LOGTAILHEADER_H
+
+#include <atomic>
+#include <cstdint>
+
+constexpr uint32_t LOGTAIL_MAGIC   = 0x4C544C4E; /* "NLTL" */
+constexpr uint32_t LOGTAIL_VERSION = 1;
+
+///----------------------------------------------------------------------------------------------------
+/// LogTailHeader_t Struct
+/// 	Start of the mapped log tail file, followed by Capacity bytes of ring data.
+/// 	Both counters are total bytes written, the ring position is Counter % Capacity.
+///----------------------------------------------------------------------------------------------------
+struct LogTailHeader_t
+{
+	uint32_t              Magic;
+	uint32_t              Version;
+	uint32_t              Capacity;
+	uint32_t              IsClean;  /* Set on a regular shutdown, a dirty tail is recovered. */
+	std::atomic<uint64_t> Reserved; /* Bumped before a line is copied, bytes up to here may be torn. */
+	std::atomic<uint64_t> Head;     /* Commit counter, bumped after a line is copied. */
+};
+
+#endif
@@ -8,17 +8,41 @@
 
 #include "LogWriter.h"
 
-#include <windows.h>
+#include <cstring>
 
+#include "LogBinary.h"
 #include "LogConst.h"
+#include "Util/Platform.h"
 
-CFileLogger::CFileLogger(ELogLevel aLogLevel, std::filesystem::path aPath, uint32_t aFlushIntervalMs)
+///----------------------------------------------------------------------------------------------------
+/// RotatedPath:
+/// 	Returns <aPath>.<aIndex>.
+///----------------------------------------------------------------------------------------------------
+static std::filesystem::path RotatedPath(const std::filesystem::path& aPath, uint32_t aIndex)
+{
+	std::filesystem::path path = aPath;
+	path += "." + std::to_string(aIndex);
+	return path;
+}
+
+CFileLogger::CFileLogger(ELogLevel aLogLevel, std::filesystem::path aPath, uint32_t aFlushIntervalMs, ELogFileFormat aFormat, LogRotation_t aRotation)
 {
 	this->SetLogLevel(aLogLevel);
-	this->File.open(aPath, std::ios_base::out, SH_DENYWR);
+	this->Path     = aPath;
+	this->Format   = aFormat;
+	this->Rotation = aRotation;
 
 	this->Interval = aFlushIntervalMs > 0 ? aFlushIntervalMs : 1000;
-	
+
+	/* Rotated files of the previous session. */
+	for (uint32_t i = 1; i <= this->Rotation.MaxFiles; i++)
+	{
+		std::error_code ec;
+		std::filesystem::remove(RotatedPath(this->Path, i), ec);
+	}
+
+	this->Open();
+
 	if (this->File.is_open())
 	{
 		this->IsRunning = true;
@@ -28,13 +52,21 @@ CFileLogger::CFileLogger(ELogLevel aLogLevel, std::filesystem::path aPath, uint3
 
 CFileLogger::~CFileLogger()
 {
-	this->IsRunning = false;
-
 	if (this->WriterThread.joinable())
 	{
+		{
+			std::lock_guard<std::mutex> lock(this->Mutex);
+			this->IsRunning = false;
+			this->ConVar.notify_one();
+		}
+
 		this->WriterThread.join();
 	}
 
+	/* Write what was queued since the last batch. */
+	this->Batch.swap(this->MsgQueue);
+	this->WriteBatch();
+
 	if (this->File.is_open())
 	{
 		this->File.flush();
@@ -47,24 +79,220 @@ void CFileLogger::MsgProc(const LogMsg_t* aLogEntry)
 	if (!this->IsRunning) { return; }
 
 	std::lock_guard<std::mutex> lock(this->Mutex);
-	this->MsgQueue.push(*aLogEntry);
-	this->ConVar.notify_one();
+	this->MsgQueue.push_back(*aLogEntry);
+
+	/* The writer takes everything queued at once, only wake it for the first message. */
+	if (this->MsgQueue.size() == 1)
+	{
+		this->ConVar.notify_one();
+	}
+}
+
+void CFileLogger::Open()
+{
+	if (this->Format == ELogFileFormat::Binary)
+	{
+		Platform::OpenWriteLocked(this->File, this->Path, std::ios_base::out | std::ios_base::binary);
+	}
+	else
+	{
+		Platform::OpenWriteLocked(this->File, this->Path, std::ios_base::out);
+	}
+
+	this->FileSize   = 0;
+	this->FileOpened = std::chrono::steady_clock::now();
+
+	/* Every binary file is self-contained. */
+	this->WrittenFormats.clear();
+	this->WrittenChannels.clear();
+	this->LastTimeMs = 0;
+	this->HasLast    = false;
+
+	if (this->Format == ELogFileFormat::Binary && this->File.is_open())
+	{
+		uint32_t header[2] = { NLOG_MAGIC, NLOG_VERSION };
+		this->WriteBuffer.append(reinterpret_cast<const char*>(header), sizeof(header));
+		this->Write();
+	}
+}
+
+void CFileLogger::Rotate()
+{
+	this->File.close();
+
+	if (this->Rotation.MaxFiles > 0)
+	{
+		std::error_code ec;
+		std::filesystem::remove(RotatedPath(this->Path, this->Rotation.MaxFiles), ec);
+
+		for (uint32_t i = this->Rotation.MaxFiles; i > 1; i--)
+		{
+			std::filesystem::rename(RotatedPath(this->Path, i - 1), RotatedPath(this->Path, i), ec);
+		}
+
+		std::filesystem::rename(this->Path, RotatedPath(this->Path, 1), ec);
+	}
+
+	this->Open();
+}
+
+void CFileLogger::Write()
+{
+	if (this->WriteBuffer.empty()) { return; }
+
+	this->File.write(this->WriteBuffer.data(), this->WriteBuffer.size());
+	this->FileSize  += this->WriteBuffer.size();
+	this->TotalSize += this->WriteBuffer.size();
+	this->WriteBuffer.clear();
+}
+
+void CFileLogger::WriteBatch()
+{
+	if (this->Batch.empty()) { return; }
+
+	bool isAgeExceeded = this->Rotation.MaxFileAge > 0 &&
+		std::chrono::steady_clock::now() - this->FileOpened >= std::chrono::seconds(this->Rotation.MaxFileAge);
+
+	for (const LogMsg_t& msg : this->Batch)
+	{
+		if (this->IsCapped) { break; }
+
+		uint64_t pending = this->WriteBuffer.size();
+
+		/* Stop writing once the total limit is reached. */
+		if (this->Rotation.MaxTotalSize > 0 && this->TotalSize + pending >= this->Rotation.MaxTotalSize)
+		{
+			LogMsg_t note = msg;
+			note.Level       = ELogLevel::WARNING;
+			note.Channel     = "Logger";
+			note.Message     = "Log size limit of " + std::to_string(this->Rotation.MaxTotalSize) + " bytes reached. Further messages are not written.";
+			note.RepeatCount = 1;
+			note.FormatID    = 0;
+			note.Format      = nullptr;
+			note.Args.clear();
+
+			if (this->Format == ELogFileFormat::Binary)
+			{
+				this->WriteBinary(note);
+			}
+			else
+			{
+				ToString(&note, this->WriteBuffer);
+			}
+
+			this->IsCapped = true;
+			break;
+		}
+
+		/* Rotate before the message, so each file starts with a complete record. */
+		if (isAgeExceeded || (this->Rotation.MaxFileSize > 0 && this->FileSize + pending >= this->Rotation.MaxFileSize))
+		{
+			this->Write();
+			this->Rotate();
+			isAgeExceeded = false;
+		}
+
+		if (this->Format == ELogFileFormat::Binary)
+		{
+			this->WriteBinary(msg);
+		}
+		else
+		{
+			ToString(&msg, this->WriteBuffer);
+		}
+	}
+
+	this->Write();
+	this->File.flush();
+	this->Batch.clear();
 }
 
 void CFileLogger::Flush()
 {
 	while (this->IsRunning)
 	{
-		std::unique_lock<std::mutex> lock(this->Mutex);
-		this->ConVar.wait_for(lock, std::chrono::milliseconds(this->Interval), [this] {
-			return !this->MsgQueue.empty() || !this->IsRunning;
-		});
-
-		while (!this->MsgQueue.empty())
 		{
-			this->File << ToString(&this->MsgQueue.front());
-			this->MsgQueue.pop();
+			std::unique_lock<std::mutex> lock(this->Mutex);
+			this->ConVar.wait_for(lock, std::chrono::milliseconds(this->Interval), [this] {
+				return !this->MsgQueue.empty() || !this->IsRunning;
+			});
+
+			this->Batch.swap(this->MsgQueue);
 		}
-		this->File.flush();
+
+		/* Formatting and writing happen without holding the lock. */
+		this->WriteBatch();
 	}
 }
+
+void CFileLogger::WriteBinary(const LogMsg_t& aLogEntry)
+{
+	bool isDeferred = aLogEntry.FormatID != 0 && aLogEntry.Format;
+	const std::string& payload = isDeferred ? aLogEntry.Args : aLogEntry.Message;
+	long long timeMs = aLogEntry.Time * 1000 + aLogEntry.TimeMsPrecision;
+
+	auto it = this->WrittenChannels.find(aLogEntry.Channel);
+
+	/* Repeats only store the count, if the last record is the repeated message.
+	 * Replayed records and messages not retained in between break the sequence. */
+	if (aLogEntry.RepeatCount > 1 &&
+		this->HasLast &&
+		it != this->WrittenChannels.end() &&
+		it->second == this->LastChannel &&
+		aLogEntry.Level == this->LastLevel &&
+		timeMs == this->LastTimeMs &&
+		(isDeferred ? aLogEntry.FormatID : 0) == this->LastFormatID &&
+		payload == this->LastPayload)
+	{
+		this->WriteBuffer.push_back((char)ENLogRecord::Repeat);
+		LogBinary::WriteVarint(this->WriteBuffer, (uint64_t)aLogEntry.RepeatCount);
+		return;
+	}
+
+	uint32_t channelId = 0;
+
+	if (it != this->WrittenChannels.end())
+	{
+		channelId = it->second;
+	}
+	else
+	{
+		channelId = (uint32_t)this->WrittenChannels.size();
+		this->WrittenChannels.emplace(aLogEntry.Channel, channelId);
+
+		this->WriteBuffer.push_back((char)ENLogRecord::Channel);
+		LogBinary::WriteVarint(this->WriteBuffer, channelId);
+		LogBinary::WriteString(this->WriteBuffer, aLogEntry.Channel.data(), aLogEntry.Channel.size());
+	}
+
+	if (isDeferred && this->WrittenFormats.insert(aLogEntry.FormatID).second)
+	{
+		this->WriteBuffer.push_back((char)ENLogRecord::Format);
+		LogBinary::WriteVarint(this->WriteBuffer, aLogEntry.FormatID);
+		LogBinary::WriteString(this->WriteBuffer, aLogEntry.Format, strlen(aLogEntry.Format));
+	}
+
+	/* Timestamps are stored in milliseconds relative to the previous message. */
+	this->WriteBuffer.push_back((char)ENLogRecord::Message);
+	this->WriteBuffer.push_back((char)aLogEntry.Level);
+	LogBinary::WriteVarint(this->WriteBuffer, LogBinary::ZigZag(timeMs - this->LastTimeMs));
+	LogBinary::WriteVarint(this->WriteBuffer, channelId);
+
+	if (isDeferred)
+	{
+		LogBinary::WriteVarint(this->WriteBuffer, aLogEntry.FormatID);
+		LogBinary::WriteString(this->WriteBuffer, aLogEntry.Args.data(), aLogEntry.Args.size());
+	}
+	else
+	{
+		LogBinary::WriteVarint(this->WriteBuffer, 0);
+		LogBinary::WriteString(this->WriteBuffer, aLogEntry.Message.data(), aLogEntry.Message.size());
+	}
+
+	this->LastTimeMs   = timeMs;
+	this->HasLast      = true;
+	this->LastLevel    = aLogEntry.Level;
+	this->LastChannel  = channelId;
+	this->LastFormatID = isDeferred ? aLogEntry.FormatID : 0;
+	this->LastPayload.assign(payload);
+}
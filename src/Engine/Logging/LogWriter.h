@@ -9,15 +9,21 @@
 #ifndef FILELOGGER_H
 #define FILELOGGER_H
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <mutex>
-#include <queue>
+#include <string>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "LogBase.h"
+#include "LogRotation.h"
 
 ///----------------------------------------------------------------------------------------------------
 /// CFileLogger Class
@@ -27,8 +33,10 @@ class CFileLogger : public virtual ILogger
 	public:
 	///----------------------------------------------------------------------------------------------------
 	/// ctor
+	/// 	aFormat Binary writes a .nlog file, see LogBinary::Decode.
+	/// 	aRotation controls when the file is rotated to <name>.1 to <name>.N.
 	///----------------------------------------------------------------------------------------------------
-	CFileLogger(ELogLevel aLogLevel, std::filesystem::path aPath, uint32_t aFlushIntervalMs = 1000);
+	CFileLogger(ELogLevel aLogLevel, std::filesystem::path aPath, uint32_t aFlushIntervalMs = 1000, ELogFileFormat aFormat = ELogFileFormat::Text, LogRotation_t aRotation = {});
 
 	///----------------------------------------------------------------------------------------------------
 	/// dtor
@@ -42,14 +50,63 @@ class CFileLogger : public virtual ILogger
 	void MsgProc(const LogMsg_t* aLogEntry) override;
 
 	private:
-	std::ofstream           File;
-	uint32_t                Interval;
-	std::thread             WriterThread;
-	bool                    IsRunning = false;
-
-	std::mutex              Mutex;
-	std::condition_variable ConVar;
-	std::queue<LogMsg_t>    MsgQueue;
+	std::filesystem::path                     Path;
+	std::ofstream                             File;
+	uint32_t                                  Interval;
+	std::thread                               WriterThread;
+	std::atomic<bool>                         IsRunning = false;
+
+	std::mutex                                Mutex;
+	std::condition_variable                   ConVar;
+	std::vector<LogMsg_t>                     MsgQueue;       /* Filled by MsgProc, swapped with the Batch by the writer. */
+	std::vector<LogMsg_t>                     Batch;          /* Only accessed by the writer. */
+	std::string                               WriteBuffer;    /* Formatted batch, written at once. */
+
+	ELogFileFormat                            Format;
+	std::unordered_set<uint32_t>              WrittenFormats; /* FormatIDs already defined in the binary file. */
+	std::unordered_map<std::string, uint32_t> WrittenChannels;
+	long long                                 LastTimeMs   = 0;
+	bool                                      HasLast      = false; /* A repeat is only stored as a count, if it repeats the last message record. */
+	ELogLevel                                 LastLevel    = ELogLevel::OFF;
+	uint32_t                                  LastChannel  = 0;
+	uint32_t                                  LastFormatID = 0;
+	std::string                               LastPayload;            /* Text, or the captured arguments if LastFormatID is set. */
+
+	LogRotation_t                             Rotation;
+	uint64_t                                  FileSize   = 0;
+	uint64_t                                  TotalSize  = 0;
+	bool                                      IsCapped   = false;
+	std::chrono::steady_clock::time_point     FileOpened;
+
+	///----------------------------------------------------------------------------------------------------
+	/// Open:
+	/// 	Opens the file, truncating it, and writes the binary header.
+	///----------------------------------------------------------------------------------------------------
+	void Open();
+
+	///----------------------------------------------------------------------------------------------------
+	/// Rotate:
+	/// 	Closes the file, shifts <name> to <name>.1, <name>.1 to <name>.2, ... and opens a new one.
+	///----------------------------------------------------------------------------------------------------
+	void Rotate();
+
+	///----------------------------------------------------------------------------------------------------
+	/// Write:
+	/// 	Writes the WriteBuffer to the file.
+	///----------------------------------------------------------------------------------------------------
+	void Write();
+
+	///----------------------------------------------------------------------------------------------------
+	/// WriteBatch:
+	/// 	Formats the Batch into the WriteBuffer and writes it, rotating where needed.
+	///----------------------------------------------------------------------------------------------------
+	void WriteBatch();
+
+	///----------------------------------------------------------------------------------------------------
+	/// WriteBinary:
+	/// 	Appends a message as binary records, defining its format and channel on first use.
+	///----------------------------------------------------------------------------------------------------
+	void WriteBinary(const LogMsg_t& aLogEntry);
 
 	///----------------------------------------------------------------------------------------------------
 	/// Flush:
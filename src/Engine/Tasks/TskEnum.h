@@ -0,0 +1,24 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  TskEnum.h
+/// Description  :  Enumerations for tasks.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef TSKENUM_H
+#define TSKENUM_H
+
+#include <cstdint>
+
+///----------------------------------------------------------------------------------------------------
+/// ETaskPriority Enumeration
+///----------------------------------------------------------------------------------------------------
+enum class ETaskPriority : uint32_t
+{
+	Visible,  /* Needed for the current frame. Runs before any prefetch task. */
+	Prefetch, /* Requested ahead of time, runs when no visible task is left.  */
+	COUNT
+};
+
+#endif
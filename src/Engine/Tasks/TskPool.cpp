@@ -0,0 +1,171 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  TskPool.cpp
+/// Description  :  Work-stealing thread pool with priority lanes.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include "TskPool.h"
+
+#include <assert.h>
+
+/* Index of the worker running on this thread, to keep tasks submitted from within a task local. */
+static thread_local uint32_t s_WorkerIndex = UINT32_MAX;
+static thread_local CTaskPool* s_WorkerPool = nullptr;
+
+CTaskPool::CTaskPool(CLogApi* aLogger, uint32_t aWorkerCount)
+{
+	assert(aLogger);
+
+	this->Logger = aLogger;
+
+	if (aWorkerCount == 0)
+	{
+		aWorkerCount = std::thread::hardware_concurrency();
+
+		/* Not computable. Still allow a download next to a decode. */
+		if (aWorkerCount < 2)
+		{
+			aWorkerCount = 2;
+		}
+	}
+
+	for (uint32_t i = 0; i < aWorkerCount; i++)
+	{
+		this->Queues.push_back(std::make_unique<TaskQueue_t>());
+	}
+
+	for (uint32_t i = 0; i < aWorkerCount; i++)
+	{
+		this->Workers.push_back(std::thread(&CTaskPool::ProcessTasks, this, i));
+	}
+
+	this->Logger->Info(CH_TASKS, "Started %u workers.", aWorkerCount);
+}
+
+CTaskPool::~CTaskPool()
+{
+	{
+		const std::lock_guard<std::mutex> lock(this->SleepMutex);
+		this->IsRunning = false;
+	}
+	this->ConVar.notify_all();
+
+	for (std::thread& worker : this->Workers)
+	{
+		if (worker.joinable())
+		{
+			worker.join();
+		}
+	}
+}
+
+void CTaskPool::Submit(ETaskPriority aPriority, std::function<void()> aTask)
+{
+	if (!aTask) { return; }
+
+	uint32_t index = (s_WorkerPool == this)
+		? s_WorkerIndex
+		: this->NextQueue.fetch_add(1, std::memory_order_relaxed) % (uint32_t)this->Queues.size();
+
+	TaskQueue_t* queue = this->Queues[index].get();
+
+	{
+		const std::lock_guard<std::mutex> lock(queue->Mutex);
+		queue->Lanes[(uint32_t)aPriority].push_back(std::move(aTask));
+
+		/* Counted with the queue locked, the same way Take uncounts it. */
+		this->Pending.fetch_add(1, std::memory_order_release);
+	}
+
+	/* Lock once, so a worker between its check and its wait does not miss the notification. */
+	{
+		const std::lock_guard<std::mutex> lock(this->SleepMutex);
+	}
+	this->ConVar.notify_one();
+}
+
+uint32_t CTaskPool::GetWorkerCount() const
+{
+	return (uint32_t)this->Workers.size();
+}
+
+uint32_t CTaskPool::GetPendingCount() const
+{
+	return this->Pending.load(std::memory_order_relaxed);
+}
+
+bool CTaskPool::Take(uint32_t aWorker, ETaskPriority aPriority, std::function<void()>& aOutTask)
+{
+	uint32_t count = (uint32_t)this->Queues.size();
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		uint32_t index = (aWorker + i) % count;
+		TaskQueue_t* queue = this->Queues[index].get();
+		std::deque<std::function<void()>>& lane = queue->Lanes[(uint32_t)aPriority];
+
+		const std::lock_guard<std::mutex> lock(queue->Mutex);
+
+		if (lane.empty()) { continue; }
+
+		/* Own tasks in order, stolen ones from the other end to keep out of the owner's way. */
+		if (index == aWorker)
+		{
+			aOutTask = std::move(lane.front());
+			lane.pop_front();
+		}
+		else
+		{
+			aOutTask = std::move(lane.back());
+			lane.pop_back();
+		}
+
+		this->Pending.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	return false;
+}
+
+void CTaskPool::ProcessTasks(uint32_t aWorker)
+{
+	s_WorkerIndex = aWorker;
+	s_WorkerPool = this;
+
+	std::function<void()> task;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(this->SleepMutex);
+			this->ConVar.wait(lock, [this] {
+				return this->Pending.load(std::memory_order_acquire) > 0 || !this->IsRunning;
+			});
+		}
+
+		if (!this->IsRunning)
+		{
+			break;
+		}
+
+		if (!this->Take(aWorker, ETaskPriority::Visible, task) &&
+			!this->Take(aWorker, ETaskPriority::Prefetch, task))
+		{
+			/* Another worker was faster. */
+			continue;
+		}
+
+		try
+		{
+			task();
+		}
+		catch (...)
+		{
+			this->Logger->Warning(CH_TASKS, "Task on worker %u threw an exception.", aWorker);
+		}
+
+		task = nullptr;
+	}
+}
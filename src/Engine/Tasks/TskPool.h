@@ -0,0 +1,88 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  TskPool.h
+/// Description  :  Work-stealing thread pool with priority lanes.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef TSKPOOL_H
+#define TSKPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Engine/Logging/LogApi.h"
+#include "TskEnum.h"
+#include "TskQueue.h"
+
+constexpr const char* CH_TASKS = "Tasks";
+
+///----------------------------------------------------------------------------------------------------
+/// CTaskPool Class
+///----------------------------------------------------------------------------------------------------
+class CTaskPool
+{
+	public:
+	///----------------------------------------------------------------------------------------------------
+	/// ctor
+	/// 	Starts one worker per core, if aWorkerCount is 0.
+	///----------------------------------------------------------------------------------------------------
+	CTaskPool(CLogApi* aLogger, uint32_t aWorkerCount = 0);
+
+	///----------------------------------------------------------------------------------------------------
+	/// dtor
+	/// 	Stops the workers. Tasks that did not start yet are dropped.
+	///----------------------------------------------------------------------------------------------------
+	~CTaskPool();
+
+	///----------------------------------------------------------------------------------------------------
+	/// Submit:
+	/// 	Queues a task. Visible tasks are taken before prefetch tasks by every worker.
+	///----------------------------------------------------------------------------------------------------
+	void Submit(ETaskPriority aPriority, std::function<void()> aTask);
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetWorkerCount:
+	/// 	Returns the amount of worker threads.
+	///----------------------------------------------------------------------------------------------------
+	uint32_t GetWorkerCount() const;
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetPendingCount:
+	/// 	Returns the amount of tasks waiting for a worker.
+	///----------------------------------------------------------------------------------------------------
+	uint32_t GetPendingCount() const;
+
+	private:
+	CLogApi*                                  Logger;
+
+	std::vector<std::unique_ptr<TaskQueue_t>> Queues;
+	std::vector<std::thread>                  Workers;
+	std::atomic<uint32_t>                     NextQueue = 0;
+
+	std::mutex                                SleepMutex;
+	std::condition_variable                   ConVar;
+	std::atomic<uint32_t>                     Pending   = 0;
+	std::atomic<bool>                         IsRunning = true;
+
+	///----------------------------------------------------------------------------------------------------
+	/// Take:
+	/// 	Takes the next task for the given worker, stealing from the others if its own lane is empty.
+	/// 	Returns false, if no task of the given priority is queued.
+	///----------------------------------------------------------------------------------------------------
+	bool Take(uint32_t aWorker, ETaskPriority aPriority, std::function<void()>& aOutTask);
+
+	///----------------------------------------------------------------------------------------------------
+	/// ProcessTasks:
+	/// 	Thread function of a worker. Sleeps until a task is submitted.
+	///----------------------------------------------------------------------------------------------------
+	void ProcessTasks(uint32_t aWorker);
+};
+
+#endif
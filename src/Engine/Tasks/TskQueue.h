@@ -0,0 +1,28 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  TskQueue.h
+/// Description  :  Contains the TaskQueue struct definition.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef TSKQUEUE_H
+#define TSKQUEUE_H
+
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#include "TskEnum.h"
+
+///----------------------------------------------------------------------------------------------------
+/// TaskQueue_t Struct
+/// 	Tasks of one worker. The owner takes from the front, others steal from the back.
+///----------------------------------------------------------------------------------------------------
+struct TaskQueue_t
+{
+	std::mutex                        Mutex;
+	std::deque<std::function<void()>> Lanes[(uint32_t)ETaskPriority::COUNT];
+};
+
+#endif
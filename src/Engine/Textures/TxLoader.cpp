@@ -13,38 +13,44 @@
 #include "httplib/httplib.h"
 
 #include <d3d11.h>
+#include <chrono>
 #include <filesystem>
+#include <memory>
+#include <unordered_map>
 
 #include "Util/Time.h"
 #include "Util/Url.h"
 
-CTextureLoader::CTextureLoader(CLogApi* aLogger, RenderContext_t* aRenderCtx, std::filesystem::path aOverridesDirectory)
+CTextureLoader::CTextureLoader(CLogApi* aLogger, RenderContext_t* aRenderCtx, CTaskPool* aTaskPool, std::filesystem::path aOverridesDirectory)
 {
 	assert(aLogger);
 	assert(aRenderCtx);
+	assert(aTaskPool);
 
 	this->Logger        = aLogger;
 	this->RenderContext = aRenderCtx;
+	this->TaskPool      = aTaskPool;
 
 	this->OverridesDirectory = aOverridesDirectory;
 
-	/* 8 Worker threads. This is disgusting. May I interest you in a threadpool? */
-	for (size_t i = 0; i < 8; i++)
-	{
-		this->DownloadThreads.push_back(std::thread(&CTextureLoader::ProcessDownloads, this));
-	}
+	this->Tasks->Logger = aLogger;
 }
 
 CTextureLoader::~CTextureLoader()
 {
-	this->IsRunning = false;
-	this->ConVar.notify_all();
-
-	for (size_t i = 0; i < 8; i++)
+	/* Tasks not started yet return without touching the loader, running ones get a bounded time to finish. */
 	{
-		if (this->DownloadThreads[i].joinable())
+		std::unique_lock<std::mutex> lock(this->Tasks->Mutex);
+
+		this->Tasks->IsAlive = false;
+
+		bool isDrained = this->Tasks->ConVar.wait_for(lock, std::chrono::milliseconds(TX_SHUTDOWN_TIMEOUT_MS), [this] {
+			return this->Tasks->Running == 0;
+		});
+
+		if (!isDrained)
 		{
-			this->DownloadThreads[i].join();
+			this->Logger->Warning(CH_TEXTURES, "%u texture task(s) still running on shutdown. Their results are discarded.", this->Tasks->Running);
 		}
 	}
 
@@ -141,7 +147,7 @@ Texture_t* CTextureLoader::GetOrCreate(const char* aIdentifier, const char* aFil
 
 	if (!result)
 	{
-		this->Load(aIdentifier, aFilename, nullptr);
+		this->Load(aIdentifier, aFilename, nullptr, false, ETaskPriority::Visible);
 	}
 
 	return result;
@@ -165,7 +171,7 @@ Texture_t* CTextureLoader::GetOrCreate(const char* aIdentifier, const char* aRem
 
 	if (!result)
 	{
-		this->Load(aIdentifier, aRemote, aEndpoint, nullptr);
+		this->Load(aIdentifier, aRemote, aEndpoint, nullptr, false, ETaskPriority::Visible);
 	}
 
 	return result;
@@ -183,10 +189,10 @@ Texture_t* CTextureLoader::GetOrCreate(const char* aIdentifier, void* aData, siz
 	return result;
 }
 
-void CTextureLoader::Load(const char* aIdentifier, const char* aFilename, TEXTURES_RECEIVECALLBACK aCallback, bool aIsShadowing)
+void CTextureLoader::Load(const char* aIdentifier, const char* aFilename, TEXTURES_RECEIVECALLBACK aCallback, bool aIsShadowing, ETaskPriority aPriority)
 {
 	/* Preprocess the request to determine, if we should load. */
-	if (this->ProcessRequest(aIdentifier, aCallback, aIsShadowing))
+	if (this->ProcessRequest(aIdentifier, aCallback, aIsShadowing, aPriority))
 	{
 		return;
 	}
@@ -205,12 +211,8 @@ void CTextureLoader::Load(const char* aIdentifier, const char* aFilename, TEXTUR
 		return;
 	}
 
-	// Load from disk into a raw RGBA buffer
-	int width = 0;
-	int height = 0;
-	unsigned char* data = stbi_load(aFilename, &width, &height, NULL, 4);
-
-	this->Enqueue(aIdentifier, data, width, height);
+	/* Queue the file, it is decoded on the task pool. */
+	this->EnqueueDecode(aIdentifier, aFilename, aPriority);
 }
 
 void CTextureLoader::Load(const char* aIdentifier, unsigned aResourceID, HMODULE aModule, TEXTURES_RECEIVECALLBACK aCallback, bool aIsShadowing)
@@ -282,16 +284,16 @@ void CTextureLoader::Load(const char* aIdentifier, unsigned aResourceID, HMODULE
 	this->Enqueue(aIdentifier, data, width, height);
 }
 
-void CTextureLoader::Load(const char* aIdentifier, const char* aRemote, const char* aEndpoint, TEXTURES_RECEIVECALLBACK aCallback, bool aIsShadowing)
+void CTextureLoader::Load(const char* aIdentifier, const char* aRemote, const char* aEndpoint, TEXTURES_RECEIVECALLBACK aCallback, bool aIsShadowing, ETaskPriority aPriority)
 {
 	/* Preprocess the request to determine, if we should load. */
-	if (this->ProcessRequest(aIdentifier, aCallback, aIsShadowing))
+	if (this->ProcessRequest(aIdentifier, aCallback, aIsShadowing, aPriority))
 	{
 		return;
 	}
 
 	/* Queue the callback and URL. */
-	this->Enqueue(aIdentifier, std::string(aRemote) + std::string(aEndpoint), aCallback);
+	this->Enqueue(aIdentifier, std::string(aRemote) + std::string(aEndpoint), aCallback, aPriority);
 }
 
 void CTextureLoader::Load(const char* aIdentifier, void* aData, size_t aSize, TEXTURES_RECEIVECALLBACK aCallback, bool aIsShadowing)
@@ -350,11 +352,28 @@ int CTextureLoader::Verify(void* aStartAddress, void* aEndAddress)
 	return refCounter;
 }
 
-bool CTextureLoader::ProcessRequest(const char* aIdentifier, TEXTURES_RECEIVECALLBACK aCallback, bool aIsShadowing)
+bool CTextureLoader::ProcessRequest(const char* aIdentifier, TEXTURES_RECEIVECALLBACK aCallback, bool aIsShadowing, ETaskPriority aPriority)
 {
 	/* If this is already queued, stop processing. */
 	if (this->IsQueued(aIdentifier))
 	{
+		if (aPriority == ETaskPriority::Visible)
+		{
+			const std::lock_guard<std::mutex> lock(this->Mutex);
+
+			auto it = this->QueuedTextures.find(aIdentifier);
+
+			/* Still waiting for a worker. The prefetch task finds it claimed, once the visible one ran. */
+			if (it != this->QueuedTextures.end() &&
+				it->second.Stage == ETextureStage::Prepare &&
+				it->second.Priority == ETaskPriority::Prefetch &&
+				(!it->second.DownloadURL.empty() || !it->second.Filename.empty()))
+			{
+				it->second.Priority = ETaskPriority::Visible;
+				this->SubmitTask(it->first, ETaskPriority::Visible);
+			}
+		}
+
 		return true;
 	}
 
@@ -475,7 +494,7 @@ void CTextureLoader::Enqueue(const char* aIdentifier, TEXTURES_RECEIVECALLBACK a
 	}
 }
 
-void CTextureLoader::Enqueue(const char* aIdentifier, std::string aDownloadURL, TEXTURES_RECEIVECALLBACK aCallback)
+void CTextureLoader::Enqueue(const char* aIdentifier, std::string aDownloadURL, TEXTURES_RECEIVECALLBACK aCallback, ETaskPriority aPriority)
 {
 	if (!aIdentifier) { return; }
 
@@ -488,6 +507,7 @@ void CTextureLoader::Enqueue(const char* aIdentifier, std::string aDownloadURL,
 		it->second.Stage = ETextureStage::Prepare;
 		it->second.DownloadURL = aDownloadURL;
 		it->second.Callback = aCallback;
+		it->second.Priority = aPriority;
 	}
 	else
 	{
@@ -495,10 +515,33 @@ void CTextureLoader::Enqueue(const char* aIdentifier, std::string aDownloadURL,
 		entry.Stage = ETextureStage::Prepare;
 		entry.DownloadURL = aDownloadURL;
 		entry.Callback = aCallback;
+		entry.Priority = aPriority;
 		entry.Time = Time::GetTimestampMs();
 
-		this->QueuedTextures.emplace(aIdentifier, entry);
+		it = this->QueuedTextures.emplace(aIdentifier, entry).first;
+	}
+
+	this->SubmitTask(it->first, aPriority);
+}
+
+void CTextureLoader::EnqueueDecode(const char* aIdentifier, std::string aFilename, ETaskPriority aPriority)
+{
+	if (!aIdentifier) { return; }
+
+	const std::lock_guard<std::mutex> lock(this->Mutex);
+
+	auto it = this->QueuedTextures.find(aIdentifier);
+
+	/* The entry was created with the callback. If it is gone, the request was dropped. */
+	if (it == this->QueuedTextures.end())
+	{
+		return;
 	}
+
+	it->second.Filename = aFilename;
+	it->second.Priority = aPriority;
+
+	this->SubmitTask(it->first, aPriority);
 }
 
 void CTextureLoader::Enqueue(const char* aIdentifier, unsigned char* aData, int aWidth, int aHeight)
@@ -623,102 +666,158 @@ void CTextureLoader::DispatchTexture(const std::string& aIdentifier, Texture_t*
 	}
 }
 
-void CTextureLoader::ProcessDownloads()
+void CTextureLoader::SubmitTask(const std::string& aIdentifier, ETaskPriority aPriority)
 {
-	while (this->IsRunning)
-	{
+	this->TaskPool->Submit(aPriority, [this, tasks = this->Tasks, aIdentifier] {
 		{
-			std::unique_lock<std::mutex> lock(this->Mutex);
-			this->ConVar.wait_for(lock, std::chrono::milliseconds(5000), [this] {
-				return this->QueuedTextures.size() > 0 || !this->IsRunning;
-			});
+			const std::lock_guard<std::mutex> lock(tasks->Mutex);
+
+			/* The loader is shutting down or gone. */
+			if (!tasks->IsAlive) { return; }
+
+			tasks->Running++;
 		}
 
+		this->ProcessTask(aIdentifier, *tasks);
+
+		const std::lock_guard<std::mutex> lock(tasks->Mutex);
+		tasks->Running--;
+		tasks->ConVar.notify_all();
+	});
+}
+
+void CTextureLoader::ProcessTask(const std::string& aIdentifier, TextureTasks_t& aTasks)
+{
+	std::string downloadUrl;
+	std::string filename;
+
+	/* Scope and lock, to claim the entry for this task. */
+	{
+		const std::lock_guard<std::mutex> lock(this->Mutex);
+
 		/* Early exit without processing the remaining textures. */
-		if (!this->IsRunning)
+		if (!aTasks.IsAlive)
 		{
-			break;
+			return;
 		}
 
-		std::map<std::string, QueuedTexture_t> queueCpy = GetQueuedTextures();
+		auto it = this->QueuedTextures.find(aIdentifier);
 
-		for (auto& [id, qtex] : queueCpy)
+		if (it == this->QueuedTextures.end() || it->second.Stage != ETextureStage::Prepare)
 		{
-			std::string downloadUrl = "";
+			/* Already gone again :( */
+			return;
+		}
 
-			/* Scope and lock, to verify we're processing this texture on this thread. */
-			{
-				const std::lock_guard<std::mutex> lock(this->Mutex);
-				auto it = this->QueuedTextures.find(id);
+		std::swap(downloadUrl, it->second.DownloadURL);
+		std::swap(filename, it->second.Filename);
+	}
 
-				if (it == this->QueuedTextures.end())
-				{
-					/* Already gone again :( */
-					continue;
-				}
-				else if (it->second.DownloadURL.empty())
-				{
-					continue;
-				}
-				else if (it->second.Stage == ETextureStage::Prepare && !it->second.DownloadURL.empty())
-				{
-					std::swap(downloadUrl, it->second.DownloadURL);
-				}
-				else
-				{
-					continue;
-				}
-			}
+	int width = 0;
+	int height = 0;
+	unsigned char* data = nullptr;
 
-			/* If we swapped a download URL, download it. */
-			if (!downloadUrl.empty())
-			{
-				std::string remote = URL::GetBase(qtex.DownloadURL);
-				std::string endpoint = URL::GetEndpoint(qtex.DownloadURL);
+	if (!downloadUrl.empty())
+	{
+		data = Download(aTasks, aIdentifier, downloadUrl, width, height);
+	}
+	else if (!filename.empty())
+	{
+		data = stbi_load(filename.c_str(), &width, &height, NULL, 4);
 
-				httplib::Client client(remote);
-				client.enable_server_certificate_verification(true);
-				client.set_follow_location(true);
-				client.set_url_encode(false);
+		if (!data)
+		{
+			aTasks.Logger->Debug(CH_TEXTURES, "Failed decoding %s (%s)", filename.c_str(), aIdentifier.c_str());
+		}
+	}
+	else
+	{
+		/* Claimed by a task submitted earlier. */
+		return;
+	}
 
-				auto result = client.Get(endpoint);
+	/* Held until the result is stored, so the loader is not destroyed meanwhile. */
+	const std::lock_guard<std::mutex> tasksLock(aTasks.Mutex);
 
-				if (!result)
-				{
-					this->Logger->Debug(CH_TEXTURES, "Error fetching %s%s (%s)\nError: %s", remote.c_str(), endpoint.c_str(), id.c_str(), httplib::to_string(result.error()).c_str());
+	/* Shutdown stopped waiting for this task, the loader might be gone. */
+	if (!aTasks.IsAlive)
+	{
+		stbi_image_free(data);
+		return;
+	}
 
-					/* nullptr response on fail */
-					this->Dequeue(id.c_str());
+	if (!data)
+	{
+		/* nullptr response on fail */
+		this->Dequeue(aIdentifier.c_str());
+		return;
+	}
 
-					return;
-				}
+	const std::lock_guard<std::mutex> lock(this->Mutex);
 
-				// Status is not HTTP_OK
-				if (result->status != 200)
-				{
-					this->Logger->Debug(CH_TEXTURES, "Status %d when fetching %s%s (%s) | %s", result->status, remote.c_str(), endpoint.c_str(), id.c_str(), httplib::to_string(result.error()).c_str());
+	auto it = this->QueuedTextures.find(aIdentifier);
 
-					/* nullptr response on fail */
-					this->Dequeue(id.c_str());
+	/* Dropped while loading. */
+	if (it == this->QueuedTextures.end() || it->second.Stage != ETextureStage::Prepare)
+	{
+		stbi_image_free(data);
+		return;
+	}
 
-					return;
-				}
+	it->second.Stage  = ETextureStage::Ready;
+	it->second.Data   = data;
+	it->second.Width  = width;
+	it->second.Height = height;
+}
 
-				size_t size = result->body.size();
-				unsigned char* remote_data = new unsigned char[size];
-				std::memcpy(remote_data, result->body.c_str(), size);
+unsigned char* CTextureLoader::Download(TextureTasks_t& aTasks, const std::string& aIdentifier, const std::string& aURL, int& aOutWidth, int& aOutHeight)
+{
+	/* Clients of this worker, kept to reuse their connection. */
+	static thread_local std::unordered_map<std::string, std::unique_ptr<httplib::Client>> s_Clients;
 
-				int width = 0;
-				int height = 0;
-				int components;
+	std::string remote = URL::GetBase(aURL);
+	std::string endpoint = URL::GetEndpoint(aURL);
 
-				stbi_uc* data = stbi_load_from_memory(remote_data, static_cast<int>(size), &width, &height, &components, 4);
+	std::unique_ptr<httplib::Client>& client = s_Clients[remote];
 
-				delete[] remote_data;
+	if (!client)
+	{
+		client = std::make_unique<httplib::Client>(remote);
+		client->enable_server_certificate_verification(true);
+		client->set_follow_location(true);
+		client->set_url_encode(false);
+		client->set_keep_alive(true);
+		client->set_connection_timeout(std::chrono::milliseconds(TX_NETWORK_TIMEOUT_MS));
+		client->set_read_timeout(std::chrono::milliseconds(TX_NETWORK_TIMEOUT_MS));
+		client->set_write_timeout(std::chrono::milliseconds(TX_NETWORK_TIMEOUT_MS));
+	}
 
-				/* Enqueue the data. */
-				this->Enqueue(id.c_str(), data, width, height);
-			}
-		}
+	auto result = client->Get(endpoint);
+
+	if (!result)
+	{
+		aTasks.Logger->Debug(CH_TEXTURES, "Error fetching %s%s (%s)\nError: %s", remote.c_str(), endpoint.c_str(), aIdentifier.c_str(), httplib::to_string(result.error()).c_str());
+
+		/* Reconnect on the next download from this remote. */
+		s_Clients.erase(remote);
+
+		return nullptr;
+	}
+
+	// Status is not HTTP_OK
+	if (result->status != 200)
+	{
+		aTasks.Logger->Debug(CH_TEXTURES, "Status %d when fetching %s%s (%s) | %s", result->status, remote.c_str(), endpoint.c_str(), aIdentifier.c_str(), httplib::to_string(result.error()).c_str());
+		return nullptr;
 	}
+
+	int components = 0;
+	unsigned char* data = stbi_load_from_memory((const stbi_uc*)result->body.data(), static_cast<int>(result->body.size()), &aOutWidth, &aOutHeight, &components, 4);
+
+	if (!data)
+	{
+		aTasks.Logger->Debug(CH_TEXTURES, "Failed decoding %s%s (%s)", remote.c_str(), endpoint.c_str(), aIdentifier.c_str());
+	}
+
+	return data;
 }
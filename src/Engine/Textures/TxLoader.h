@@ -9,22 +9,38 @@
 #ifndef TEXTURELOADER_H
 #define TEXTURELOADER_H
 
+#include <atomic>
 #include <condition_variable>
 #include <filesystem>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
-#include <thread>
-#include <vector>
 #include <windows.h>
 
 #include "Engine/Logging/LogApi.h"
 #include "Engine/Renderer/RdrContext.h"
+#include "Engine/Tasks/TskPool.h"
 #include "TxFuncDefs.h"
 #include "TxQueueEntry.h"
 #include "TxTexture.h"
 
-constexpr const char* CH_TEXTURES = "Textures";
+constexpr const char* CH_TEXTURES            = "Textures";
+constexpr uint32_t    TX_SHUTDOWN_TIMEOUT_MS = 2000; /* Longest wait for running downloads and decodes on shutdown. */
+constexpr uint32_t    TX_NETWORK_TIMEOUT_MS  = 1000; /* Connect, send and receive timeout, so a stalled download fits the shutdown wait. */
+
+///----------------------------------------------------------------------------------------------------
+/// TextureTasks_t Struct
+/// 	Shared with the submitted tasks, so tasks outliving the loader no longer touch it.
+///----------------------------------------------------------------------------------------------------
+struct TextureTasks_t
+{
+	CLogApi*                Logger  = nullptr; /* Used by running tasks instead of the loader's. */
+	std::mutex              Mutex;
+	std::condition_variable ConVar;            /* Notified when a running task returns. */
+	std::atomic<bool>       IsAlive = true;
+	uint32_t                Running = 0;
+};
 
 ///----------------------------------------------------------------------------------------------------
 /// CTextureLoader Class
@@ -34,11 +50,13 @@ class CTextureLoader
 	public:
 	///----------------------------------------------------------------------------------------------------
 	/// ctor
+	/// 	Downloads and decodes of files run on aTaskPool.
 	///----------------------------------------------------------------------------------------------------
-	CTextureLoader(CLogApi* aLogger, RenderContext_t* aRenderCtx, std::filesystem::path aOverridesDirectory);
+	CTextureLoader(CLogApi* aLogger, RenderContext_t* aRenderCtx, CTaskPool* aTaskPool, std::filesystem::path aOverridesDirectory);
 
 	///----------------------------------------------------------------------------------------------------
 	/// dtor
+	/// 	Waits for the submitted tasks to return.
 	///----------------------------------------------------------------------------------------------------
 	~CTextureLoader();
 
@@ -57,6 +75,7 @@ class CTextureLoader
 	///----------------------------------------------------------------------------------------------------
 	/// GetOrCreate:
 	/// 	Returns a Texture_t* with the given identifier or creates it from file path.
+	/// 	Textures requested this way are needed for the current frame and load before prefetched ones.
 	///----------------------------------------------------------------------------------------------------
 	Texture_t* GetOrCreate(const char* aIdentifier, const char* aFilename);
 
@@ -82,7 +101,7 @@ class CTextureLoader
 	/// Load:
 	/// 	Requests to load a texture from file and returns to the given callback.
 	///----------------------------------------------------------------------------------------------------
-	void Load(const char* aIdentifier, const char* aFilename, TEXTURES_RECEIVECALLBACK aCallback, bool aIsShadowing = false);
+	void Load(const char* aIdentifier, const char* aFilename, TEXTURES_RECEIVECALLBACK aCallback, bool aIsShadowing = false, ETaskPriority aPriority = ETaskPriority::Prefetch);
 
 	///----------------------------------------------------------------------------------------------------
 	/// Load:
@@ -94,7 +113,7 @@ class CTextureLoader
 	/// Load:
 	/// 	Requests to load a texture from remote URL and returns to the given callback.
 	///----------------------------------------------------------------------------------------------------
-	void Load(const char* aIdentifier, const char* aRemote, const char* aEndpoint, TEXTURES_RECEIVECALLBACK aCallback, bool aIsShadowing = false);
+	void Load(const char* aIdentifier, const char* aRemote, const char* aEndpoint, TEXTURES_RECEIVECALLBACK aCallback, bool aIsShadowing = false, ETaskPriority aPriority = ETaskPriority::Prefetch);
 
 	///----------------------------------------------------------------------------------------------------
 	/// Load:
@@ -110,7 +129,7 @@ class CTextureLoader
 
 	///----------------------------------------------------------------------------------------------------
 	/// GetQueuedTextures:
-	/// 	Returns a copy of all currently queued textures.
+	/// 	Returns a copy of all currently queued textures. Meant for inspection only.
 	///----------------------------------------------------------------------------------------------------
 	std::map<std::string, QueuedTexture_t> GetQueuedTextures() const;
 
@@ -123,6 +142,7 @@ class CTextureLoader
 	private:
 	CLogApi*                               Logger        = nullptr;
 	RenderContext_t*                       RenderContext = nullptr;
+	CTaskPool*                             TaskPool      = nullptr;
 
 	std::filesystem::path                  OverridesDirectory;
 
@@ -130,17 +150,16 @@ class CTextureLoader
 	std::map<std::string, Texture_t*>      Registry;
 	std::map<std::string, QueuedTexture_t> QueuedTextures;
 
-	std::condition_variable                ConVar;
-	bool                                   IsRunning = true;
-	std::vector<std::thread>               DownloadThreads;
+	std::shared_ptr<TextureTasks_t>        Tasks = std::make_shared<TextureTasks_t>();
 
 	///----------------------------------------------------------------------------------------------------
 	/// ProcessRequest:
 	/// 	Processes the load request.
 	/// 	Returns true if request is already ongoing or fulfilled.
 	/// 	Returns false if the load should be cancelled.
+	/// 	Visible requests for a texture queued as prefetch promote it.
 	///----------------------------------------------------------------------------------------------------
-	bool ProcessRequest(const char* aIdentifier, TEXTURES_RECEIVECALLBACK aCallback, bool aIsShadowing);
+	bool ProcessRequest(const char* aIdentifier, TEXTURES_RECEIVECALLBACK aCallback, bool aIsShadowing, ETaskPriority aPriority = ETaskPriority::Prefetch);
 
 	///----------------------------------------------------------------------------------------------------
 	/// ShadowTexture:
@@ -171,7 +190,13 @@ class CTextureLoader
 	/// Enqueue:
 	/// 	Adds an entry to be downloaded to the queue awaiting processing.
 	///----------------------------------------------------------------------------------------------------
-	void Enqueue(const char* aIdentifier, std::string aDownloadURL, TEXTURES_RECEIVECALLBACK aCallback);
+	void Enqueue(const char* aIdentifier, std::string aDownloadURL, TEXTURES_RECEIVECALLBACK aCallback, ETaskPriority aPriority);
+
+	///----------------------------------------------------------------------------------------------------
+	/// EnqueueDecode:
+	/// 	Adds a file to be decoded to a queue entry.
+	///----------------------------------------------------------------------------------------------------
+	void EnqueueDecode(const char* aIdentifier, std::string aFilename, ETaskPriority aPriority);
 
 	///----------------------------------------------------------------------------------------------------
 	/// Enqueue:
@@ -198,10 +223,26 @@ class CTextureLoader
 	void DispatchTexture(const std::string& aIdentifier, Texture_t* aTexture, TEXTURES_RECEIVECALLBACK aCallback);
 
 	///----------------------------------------------------------------------------------------------------
-	/// ProcessDownloads:
-	/// 	Thread function to process downloads.
+	/// SubmitTask:
+	/// 	Submits the download or decode of a queue entry to the task pool. Must be called with the Mutex held.
+	///----------------------------------------------------------------------------------------------------
+	void SubmitTask(const std::string& aIdentifier, ETaskPriority aPriority);
+
+	///----------------------------------------------------------------------------------------------------
+	/// ProcessTask:
+	/// 	Task function to download or decode a queue entry.
+	/// 	Does nothing, if another task already claimed it.
+	/// 	Discards the result, if the loader was destroyed while it ran.
+	///----------------------------------------------------------------------------------------------------
+	void ProcessTask(const std::string& aIdentifier, TextureTasks_t& aTasks);
+
+	///----------------------------------------------------------------------------------------------------
+	/// Download:
+	/// 	Downloads and decodes a remote texture. Reuses one client per remote and worker.
+	/// 	Static, as it may still run after the loader was destroyed.
+	/// 	Returns the pixel data or nullptr.
 	///----------------------------------------------------------------------------------------------------
-	void ProcessDownloads();
+	static unsigned char* Download(TextureTasks_t& aTasks, const std::string& aIdentifier, const std::string& aURL, int& aOutWidth, int& aOutHeight);
 };
 
 #endif
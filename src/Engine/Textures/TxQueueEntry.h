@@ -9,6 +9,9 @@
 #ifndef TXQUEUEENTRY_H
 #define TXQUEUEENTRY_H
 
+#include <string>
+
+#include "Engine/Tasks/TskEnum.h"
 #include "TxEnum.h"
 #include "TxFuncDefs.h"
 
@@ -24,6 +27,8 @@ struct QueuedTexture_t
 	unsigned                 Height;
 	unsigned char*           Data;
 	std::string              DownloadURL;
+	std::string              Filename;    /* File to decode on the task pool. */
+	ETaskPriority            Priority;
 	TEXTURES_RECEIVECALLBACK Callback;
 };
 
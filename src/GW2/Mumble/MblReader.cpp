@@ -39,6 +39,10 @@ CMumbleReader::CMumbleReader(CDataLinkApi* aDataLink, CEventApi* aEventApi, CLog
 	this->MumbleIdentity = (Mumble::Identity*)this->DataLinkApi->ShareResource(DL_MUMBLE_LINK_IDENTITY, sizeof(Mumble::Identity), "",                 false);
 	this->NexusLink      = (NexusLinkData_t*) this->DataLinkApi->ShareResource(DL_NEXUS_LINK,           sizeof(NexusLinkData_t),  "",                 true);
 
+	/* Tear-free copies for readers on other threads. */
+	this->MumbleIdentityVersioned = this->DataLinkApi->ShareVersionedResource(DL_MUMBLE_LINK_IDENTITY_VERSIONED, sizeof(Mumble::Identity), "", false);
+	this->DataLinkApi->ShareVersionedResource(DL_NEXUS_LINK_VERSIONED, sizeof(NexusLinkData_t), "", true);
+
 	if (this->Name != "0")
 	{
 		this->IsRunning = true;
@@ -96,20 +100,23 @@ void CMumbleReader::AdvanceIdentity()
 			/* cache identity */
 			this->PreviousIdentity = *this->MumbleIdentity;
 
+			/* Parsed into a copy, so the shared identity is only written once. */
+			Mumble::Identity identity = this->PreviousIdentity;
+
 			try
 			{
 				/* parse and assign current identity */
 				json j = json::parse(this->MumbleLink->Identity);
-				strcpy(this->MumbleIdentity->Name, j["name"].get<std::string>().c_str());
-				j["profession"].get_to(this->MumbleIdentity->Profession);
-				j["spec"].get_to(this->MumbleIdentity->Specialization);
-				j["race"].get_to(this->MumbleIdentity->Race);
-				j["map_id"].get_to(this->MumbleIdentity->MapID);
-				j["world_id"].get_to(this->MumbleIdentity->WorldID);
-				j["team_color_id"].get_to(this->MumbleIdentity->TeamColorID);
-				j["commander"].get_to(this->MumbleIdentity->IsCommander);
-				j["fov"].get_to(this->MumbleIdentity->FOV);
-				j["uisz"].get_to(this->MumbleIdentity->UISize);
+				strcpy(identity.Name, j["name"].get<std::string>().c_str());
+				j["profession"].get_to(identity.Profession);
+				j["spec"].get_to(identity.Specialization);
+				j["race"].get_to(identity.Race);
+				j["map_id"].get_to(identity.MapID);
+				j["world_id"].get_to(identity.WorldID);
+				j["team_color_id"].get_to(identity.TeamColorID);
+				j["commander"].get_to(identity.IsCommander);
+				j["fov"].get_to(identity.FOV);
+				j["uisz"].get_to(identity.UISize);
 			}
 			catch (json::parse_error& ex)
 			{
@@ -124,6 +131,12 @@ void CMumbleReader::AdvanceIdentity()
 				this->Logger->Trace(CH_MUMBLE_READER, "MumbleLink could not be parsed. Unknown Error.");
 			}
 
+			if (identity != this->PreviousIdentity)
+			{
+				*this->MumbleIdentity = identity;
+				CDataLinkApi::Write(this->MumbleIdentityVersioned, &identity, sizeof(Mumble::Identity));
+			}
+
 			/* notify (also notifies the GUI to update its scaling factor) */
 			if (*this->MumbleIdentity != this->PreviousIdentity)
 			{
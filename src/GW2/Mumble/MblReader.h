@@ -18,10 +18,11 @@
 #include "Engine/Logging/LogApi.h"
 #include "thirdparty/mumble/Mumble.h"
 
-constexpr const char* CH_MUMBLE_READER           = "MumbleReader";
-constexpr const char* DL_MUMBLE_LINK             = "DL_MUMBLE_LINK";
-constexpr const char* DL_MUMBLE_LINK_IDENTITY    = "DL_MUMBLE_LINK_IDENTITY";
-constexpr const char* EV_MUMBLE_IDENTITY_UPDATED = "EV_MUMBLE_IDENTITY_UPDATED";
+constexpr const char* CH_MUMBLE_READER                  = "MumbleReader";
+constexpr const char* DL_MUMBLE_LINK                    = "DL_MUMBLE_LINK";
+constexpr const char* DL_MUMBLE_LINK_IDENTITY           = "DL_MUMBLE_LINK_IDENTITY";
+constexpr const char* DL_MUMBLE_LINK_IDENTITY_VERSIONED = "DL_MUMBLE_LINK_IDENTITY_VERSIONED"; /* Read with CDataLinkApi::ReadSnapshot. */
+constexpr const char* EV_MUMBLE_IDENTITY_UPDATED        = "EV_MUMBLE_IDENTITY_UPDATED";
 
 ///----------------------------------------------------------------------------------------------------
 /// CMumbleReader Class
@@ -70,24 +71,25 @@ class CMumbleReader
 	NexusLinkData_t* GetNexusLink() const;
 
 	private:
-	CDataLinkApi*     DataLinkApi            = nullptr;
-	CEventApi*        EventApi               = nullptr;
-	CLogApi*          Logger                 = nullptr;
+	CDataLinkApi*     DataLinkApi             = nullptr;
+	CEventApi*        EventApi                = nullptr;
+	CLogApi*          Logger                  = nullptr;
 
 	std::thread       ThreadIdentity;
 	std::thread       ThreadDerived;
-	bool              IsRunning              = false;
+	bool              IsRunning               = false;
 
 	std::string       Name;
-	Mumble::Data*     MumbleLink             = nullptr;
-	Mumble::Identity* MumbleIdentity         = nullptr;
-	NexusLinkData_t*  NexusLink              = nullptr;
-
-	unsigned          PreviousTick           = 0;
-	Vector3           PreviousAvatarPosition = {};
-	Vector3           PreviousCameraFront    = {};
-	Mumble::Identity  PreviousIdentity       = Mumble::Identity{};
-	long long         PreviousFrameCounter   = 0;
+	Mumble::Data*     MumbleLink              = nullptr;
+	Mumble::Identity* MumbleIdentity          = nullptr;
+	void*             MumbleIdentityVersioned = nullptr;
+	NexusLinkData_t*  NexusLink               = nullptr;
+
+	unsigned          PreviousTick            = 0;
+	Vector3           PreviousAvatarPosition  = {};
+	Vector3           PreviousCameraFront     = {};
+	Mumble::Identity  PreviousIdentity        = Mumble::Identity{};
+	long long         PreviousFrameCounter    = 0;
 
 	///----------------------------------------------------------------------------------------------------
 	/// AdvanceIdentity:
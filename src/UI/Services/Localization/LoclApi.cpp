@@ -8,9 +8,10 @@
 
 #include "LoclApi.h"
 
-#include <windows.h>
 #include <fstream>
 
+#include "Util/Platform.h"
+
 #include "nlohmann/json.hpp"
 using json = nlohmann::json;
 
@@ -31,12 +32,12 @@ bool CLocalization::Advance()
 	bool didModify = false;
 
 	/* Set thread ID. We may only call Advance from the UI thread. */
-	if (this->ThreadID == 0)
+	if (this->ThreadID == std::thread::id())
 	{
-		this->ThreadID = GetCurrentThreadId();
+		this->ThreadID = std::this_thread::get_id();
 	}
 
-	assert(this->ThreadID == GetCurrentThreadId());
+	assert(this->ThreadID == std::this_thread::get_id());
 
 	if (!this->IsLocaleAtlasBuilt)
 	{
@@ -63,11 +64,11 @@ bool CLocalization::Advance()
 					free((void*)textIt->second);
 				}
 
-				textIt->second = _strdup(item.Text.c_str());
+				textIt->second = Platform::DuplicateString(item.Text.c_str());
 			}
 			else
 			{
-				atlasIt->second.Texts.emplace(item.Identifier, _strdup(item.Text.c_str()));
+				atlasIt->second.Texts.emplace(item.Identifier, Platform::DuplicateString(item.Text.c_str()));
 			}
 		}
 
@@ -233,7 +234,7 @@ void CLocalization::BuildLocaleAtlas()
 	this->ClearLocaleAtlas();
 
 	/* find files, merge files, alloc strings */
-	for (const std::filesystem::directory_entry entry : std::filesystem::directory_iterator(this->Directory))
+	for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(this->Directory))
 	{
 		std::filesystem::path path = entry.path();
 
@@ -302,11 +303,11 @@ void CLocalization::BuildLocaleAtlas()
 						free((void*)textIt->second);
 					}
 
-					textIt->second = _strdup(value.get<std::string>().c_str());
+					textIt->second = Platform::DuplicateString(value.get<std::string>().c_str());
 				}
 				else
 				{
-					loc.Texts.emplace(key, _strdup(value.get<std::string>().c_str()));
+					loc.Texts.emplace(key, Platform::DuplicateString(value.get<std::string>().c_str()));
 				}
 			}
 
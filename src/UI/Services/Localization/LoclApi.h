@@ -13,6 +13,7 @@
 #include <filesystem>
 #include <map>
 #include <string>
+#include <thread>
 
 #include "Engine/Logging/LogApi.h"
 #include "LoclLocale.h"
@@ -89,7 +90,7 @@ class CLocalization
 	private:
 	CLogApi*                         Logger   = nullptr;
 
-	uint32_t                         ThreadID = 0;
+	std::thread::id                  ThreadID;
 
 	std::filesystem::path            Directory;
 	bool                             IsLocaleAtlasBuilt = false;
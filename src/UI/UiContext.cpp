@@ -382,6 +382,9 @@ void CUiContext::Render()
 {
 	this->Initialize();
 
+	/* Dispatch deferred events before taking the lock, callbacks may call back into the UI. */
+	this->EventApi->Flush();
+
 	const std::lock_guard<std::mutex> lock(this->Mutex);
 
 	/* preload localization and font changes */
@@ -424,6 +427,15 @@ void CUiContext::Render()
 
 	this->AreModsDown = (this->Mods & actualMods) == this->Mods;
 
+	/* Publish a consistent copy of the NexusLink, its fields are written from several threads. */
+	static NexusLinkData_t* s_NexusLink          = (NexusLinkData_t*)this->DataLink->GetResource(DL_NEXUS_LINK);
+	static void*            s_NexusLinkVersioned = this->DataLink->GetResource(DL_NEXUS_LINK_VERSIONED);
+
+	if (s_NexusLink)
+	{
+		CDataLinkApi::Write(s_NexusLinkVersioned, s_NexusLink, sizeof(NexusLinkData_t));
+	}
+
 	/* pre-render callbacks */
 	for (GUI_RENDER callback : this->RegistryPreRender)
 	{
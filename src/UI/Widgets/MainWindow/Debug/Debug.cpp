@@ -8,6 +8,7 @@
 
 #include "Debug.h"
 
+#include <map>
 #include <unordered_map>
 
 #include "imgui/imgui.h"
@@ -15,9 +16,12 @@
 
 #include "Core/Context.h"
 #include "Engine/Events/EvtApi.h"
+#include "Engine/Functions/FnRegistry.h"
 #include "Engine/Inputs/InputBinds/IbApi.h"
+#include "Engine/Loader/Loader.h"
 #include "Resources/ResConst.h"
 #include "Util/MD5.h"
+#include "Util/Platform.h"
 #include "Util/Strings.h"
 
 static CDebugWindow* DebugWindow = nullptr;
@@ -67,6 +71,7 @@ void CDebugWindow::RenderContent()
 		this->TabEvents();
 		this->TabInputBinds();
 		this->TabDataLink();
+		this->TabFunctions();
 		this->TabTextures();
 		this->TabQuickAccess();
 		this->TabLoader();
@@ -102,12 +107,26 @@ void CDebugWindow::TabEvents()
 
 	if (ImGui::BeginChild("Content", ImVec2(ImGui::GetWindowContentRegionWidth(), 0.0f), false, ImGuiWindowFlags_NoBackground))
 	{
-		std::unordered_map<std::string, EventData_t> eventRegistry = CContext::GetContext()->GetEventApi()->GetRegistry();
+		std::unordered_map<std::string, EventInfo_t> eventRegistry = CContext::GetContext()->GetEventApi()->GetRegistry();
 
 		for (auto& [identifier, ev] : eventRegistry)
 		{
 			if (ImGui::TreeNode(String::Format("%s (%d)", identifier.c_str(), ev.AmountRaises).c_str()))
 			{
+				if (ev.Coalescing != EEventCoalescing::None)
+				{
+					const char* policy = ev.Coalescing == EEventCoalescing::LastValue ? "LastValue"
+						: ev.Coalescing == EEventCoalescing::RateLimit ? "RateLimit"
+						: "Batch";
+
+					ImGui::TextDisabled("Coalescing: %s | Merged: %llu | Suppressed: %llu", policy, ev.AmountMerged, ev.AmountSuppressed);
+				}
+
+				if (ev.IsStreamed)
+				{
+					ImGui::TextDisabled("Mirrored to event stream.");
+				}
+
 				if (ev.Subscribers.size() == 0)
 				{
 					ImGui::TextDisabled("This event has no subscribers.");
@@ -117,7 +136,14 @@ void CDebugWindow::TabEvents()
 					ImGui::TextDisabled("Subscribers:");
 					for (EventSubscriber_t sub : ev.Subscribers)
 					{
-						ImGui::Text(""); ImGui::SameLine(); ImGui::TextDisabled("Signature: %d | Callback: %p", sub.Signature, sub.Callback);
+						if (sub.Pattern)
+						{
+							ImGui::Text(""); ImGui::SameLine(); ImGui::TextDisabled("Signature: %d | Callback: %p | Pattern: %s*", sub.Signature, sub.Callback, sub.Pattern->Prefix.c_str());
+						}
+						else
+						{
+							ImGui::Text(""); ImGui::SameLine(); ImGui::TextDisabled("Signature: %d | Callback: %p", sub.Signature, sub.Callback);
+						}
 					}
 				}
 				ImGui::TreePop();
@@ -190,6 +216,33 @@ void CDebugWindow::TabDataLink()
 
 	if (ImGui::BeginChild("Content", ImVec2(ImGui::GetWindowContentRegionWidth(), 0.0f), false, ImGuiWindowFlags_NoBackground))
 	{
+		size_t liveBytes = 0;
+		size_t reclaimableBytes = 0;
+		CContext::GetContext()->GetDataLink()->GetUsage(liveBytes, reclaimableBytes);
+
+		ImGui::TextDisabled("Live: %zu bytes", liveBytes);
+		ImGui::TooltipGeneric("Resources referenced by Nexus or a loaded addon.");
+		ImGui::TextDisabled("Reclaimable: %zu bytes", reclaimableBytes);
+		ImGui::TooltipGeneric("Resources no longer referenced, freed once their last addon is unloaded from memory.");
+
+		if (reclaimableBytes > 0)
+		{
+			ImGui::SameLine();
+			if (ImGui::SmallButton("Reclaim"))
+			{
+				CContext::GetContext()->GetDataLink()->Reclaim();
+			}
+		}
+
+		size_t arenaUsed = 0;
+		size_t arenaSize = 0;
+
+		if (CContext::GetContext()->GetDataLink()->GetArenaUsage(arenaUsed, arenaSize))
+		{
+			ImGui::TextDisabled("Arena: %zu / %zu bytes", arenaUsed, arenaSize);
+			ImGui::TooltipGeneric("Small public resources share one mapping, listed in its directory.");
+		}
+
 		std::unordered_map<std::string, LinkedResource_t>	dataLinkRegistry = CContext::GetContext()->GetDataLink()->GetRegistry();
 
 		for (auto& [identifier, resource] : dataLinkRegistry)
@@ -201,6 +254,37 @@ void CDebugWindow::TabDataLink()
 				ImGui::TextDisabled("Size: %d", resource.Size);
 				ImGui::TextDisabled("Name: %s", resource.UnderlyingName.c_str());
 				ImGui::TooltipGeneric("The real underlying name of the file.");
+				if (resource.Owner)
+				{
+					ImGui::TextDisabled("Owner: 0x%08X", resource.Owner);
+				}
+				else
+				{
+					ImGui::TextDisabled("Owner: Nexus");
+				}
+				ImGui::TooltipGeneric("Signature of the addon that created the resource.");
+				ImGui::TextDisabled("References: %u", (uint32_t)resource.Users.size());
+				ImGui::TooltipGeneric("Amount of addons using the resource. Nexus counts as one and keeps it alive.");
+
+				if (resource.Type == ELinkedResourceType::Arena)
+				{
+					ImGui::TextDisabled("In Arena");
+					ImGui::TooltipGeneric("Sub-allocated in the shared arena, not a mapping of its own.");
+				}
+
+				if (resource.Layout == ELinkedResourceLayout::Versioned)
+				{
+					const VersionedHeader_t* header = static_cast<const VersionedHeader_t*>(resource.Pointer);
+					ImGui::TextDisabled("Version: %u", header->Sequence.load(std::memory_order_relaxed) / 2);
+					ImGui::TooltipGeneric("Amount of completed writes of the versioned resource.");
+				}
+				else if (resource.Layout == ELinkedResourceLayout::TripleBuffered)
+				{
+					const TripleBufferHeader_t* header = static_cast<const TripleBufferHeader_t*>(resource.Pointer);
+					uint32_t latest = header->Latest.load(std::memory_order_relaxed);
+					ImGui::TextDisabled("Frame: %u (Buffer %u)", latest >> 2, latest & 3);
+					ImGui::TooltipGeneric("Amount of published frames and the buffer holding the newest one.");
+				}
 
 				if (ImGui::SmallButton("Memory Viewer"))
 				{
@@ -218,6 +302,73 @@ void CDebugWindow::TabDataLink()
 	ImGui::EndTabItem();
 }
 
+void CDebugWindow::TabFunctions()
+{
+	if (!ImGui::BeginTabItem("Functions"))
+	{
+		return;
+	}
+
+	if (ImGui::BeginChild("Content", ImVec2(ImGui::GetWindowContentRegionWidth(), 0.0f), false, ImGuiWindowFlags_NoBackground))
+	{
+		CFuncRegistry* funcRegistry = CContext::GetContext()->GetFunctionRegistry();
+
+		bool isInstrumented = funcRegistry->IsInstrumented();
+		if (ImGui::Checkbox("Instrument calls", &isInstrumented))
+		{
+			funcRegistry->SetInstrumented(isInstrumented);
+		}
+		ImGui::TooltipGeneric("Functions queried from now on are called through a thunk counting and timing the calls.\nAdds a small overhead to every call.\nExceptions must not leave an instrumented function. Calls left without returning are dropped from the statistics.");
+
+		ImGui::SameLine();
+		if (ImGui::SmallButton("Reset"))
+		{
+			funcRegistry->ResetProfiles();
+		}
+
+		/* Milliseconds per performance counter tick. */
+		double msPerTick = 1000.0 / (double)Platform::GetPerformanceFrequency();
+
+		for (auto& [identifier, profile] : funcRegistry->GetProfiles())
+		{
+			uint64_t calls = profile->Calls.load(std::memory_order_relaxed);
+			double totalMs = profile->Ticks.load(std::memory_order_relaxed) * msPerTick;
+
+			if (ImGui::TreeNode(identifier.c_str()))
+			{
+				ImGui::TextDisabled("Calls: %llu", calls);
+				ImGui::TextDisabled("Total: %.3fms", totalMs);
+				ImGui::TextDisabled("Average: %.3fus", calls > 0 ? totalMs * 1000.0 / calls : 0.0);
+
+				/* Call sites are attributed to their addons here, so the thunks never touch the loader. */
+				std::map<std::string, std::pair<uint64_t, int64_t>> owners;
+
+				for (const FuncCallerProfile_t& caller : profile->Callers)
+				{
+					uint64_t callerCalls = caller.Calls.load(std::memory_order_relaxed);
+
+					if (callerCalls == 0) { continue; }
+
+					void* address = caller.Address.load(std::memory_order_relaxed);
+					std::pair<uint64_t, int64_t>& owner = owners[address ? Loader::GetOwner(address) : "(other)"];
+					owner.first += callerCalls;
+					owner.second += caller.Ticks.load(std::memory_order_relaxed);
+				}
+
+				for (auto& [owner, stats] : owners)
+				{
+					ImGui::TextDisabled("%s: %llu calls, %.3fms", owner.c_str(), stats.first, stats.second * msPerTick);
+				}
+
+				ImGui::TreePop();
+			}
+		}
+	}
+	ImGui::EndChild();
+
+	ImGui::EndTabItem();
+}
+
 void CDebugWindow::TabTextures()
 {
 	if (!ImGui::BeginTabItem("Textures"))
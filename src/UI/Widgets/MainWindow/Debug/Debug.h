@@ -34,6 +34,7 @@ class CDebugWindow : public ISubWindow
 	void TabEvents();
 	void TabInputBinds();
 	void TabDataLink();
+	void TabFunctions();
 	void TabTextures();
 	void TabQuickAccess();
 	void TabLoader();
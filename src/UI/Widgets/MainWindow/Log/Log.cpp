@@ -8,13 +8,17 @@
 
 #include "Log.h"
 
+#include <algorithm>
+#include <fstream>
 #include <regex>
 
 #include "imgui_extensions.h"
 
 #include "Core/Context.h"
+#include "Core/Index/Index.h"
 #include "Resources/ResConst.h"
 #include "Engine/Logging/LogConst.h"
+#include "Util/Time.h"
 
 CLogWindow::CLogWindow()
 {
@@ -106,11 +110,69 @@ void CLogWindow::RenderContent()
 	ImGui::Checkbox("Selected level only", &this->SelectedLevelOnly);
 	ImGui::TooltipGeneric("If selected only messages with the specific log level are shown.\nIf not selected, all messages with a log level higher or equal to the filter are shown.");
 
-	ImGuiStyle& style = ImGui::GetStyle();
+	ImGui::SameLine();
+	ImGui::SetNextItemWidth(ImGui::CalcTextSize("####################").x);
+	ImGui::InputTextWithHint("##Filter_Search", "Search", this->SearchText, sizeof(this->SearchText));
+
+	ImGui::AlignTextToFramePadding();
+	ImGui::SameLine();
+	ImGui::Text("Last");
+	ImGui::SameLine();
+	ImGui::SetNextItemWidth(ImGui::CalcTextSize("############").x);
+	static std::string sincePreview = "All";
+	if (ImGui::BeginCombo("##Filter_Since", sincePreview.c_str()))
+	{
+		if (ImGui::Selectable("1 minute"))
+		{
+			sincePreview = "1 minute";
+			this->SinceMinutes = 1;
+		}
+
+		if (ImGui::Selectable("10 minutes"))
+		{
+			sincePreview = "10 minutes";
+			this->SinceMinutes = 10;
+		}
+
+		if (ImGui::Selectable("1 hour"))
+		{
+			sincePreview = "1 hour";
+			this->SinceMinutes = 60;
+		}
+
+		if (ImGui::Selectable("All"))
+		{
+			sincePreview = "All";
+			this->SinceMinutes = 0;
+		}
 
-	std::vector<std::string> activeChannels;
+		ImGui::EndCombo();
+	}
+
+	ImGui::SameLine();
+	if (ImGui::Button("Export"))
+	{
+		this->Export();
+	}
+	ImGui::TooltipGeneric("Writes all messages matching the filter to LogExport.log.");
+
+	/* Re-run the query only when a filter changed, new messages are matched incrementally. */
+	if (this->Query.Level        != this->FilterLevel       ||
+		this->Query.IsExactLevel != this->SelectedLevelOnly ||
+		this->Query.Text         != this->SearchText        ||
+		this->QuerySinceMinutes  != this->SinceMinutes      ||
+		this->QueryMaxShownCount != this->MaxShownCount)
+	{
+		this->Query.Level        = this->FilterLevel;
+		this->Query.IsExactLevel = this->SelectedLevelOnly;
+		this->Query.Text         = this->SearchText;
+		this->QuerySinceMinutes  = this->SinceMinutes;
+		this->QueryMaxShownCount = this->MaxShownCount;
+		this->IsFilterDirty      = true;
+	}
+
+	this->Query.Since = this->SinceMinutes > 0 ? Time::GetTimestamp() - this->SinceMinutes * 60 : 0;
 
-	static int amtShown = 0;
 	static float widthChannels = 50.f;
 
 	float calcChWidth = .0f;
@@ -122,23 +184,36 @@ void CLogWindow::RenderContent()
 		ImGui::Text("Channels");
 
 		const std::lock_guard<std::mutex> lock(Mutex);
+		bool isChannelToggled = false;
 		for (LogChannel_t& ch : this->Channels)
 		{
 			calcChWidth = max(calcChWidth, ImGui::CalcTextSize(ch.Name.c_str()).x);
-			float opacity = 0.8f;
-			if (ch.IsSelected)
-			{
-				opacity = 1.0f;
-				activeChannels.push_back(ch.Name);
-			}
+			float opacity = ch.IsSelected ? 1.0f : 0.8f;
 			ImGui::PushStyleVar(ImGuiStyleVar_Alpha, opacity);
 			if (ImGui::Button(ch.Name.c_str(), ImVec2(widthChannels, 0.0f)))
 			{
 				ch.IsSelected = !ch.IsSelected;
+				isChannelToggled = true;
 			}
 			ImGui::PopStyleVar();
 		}
-		ImGui::TextDisabled("%d / %d", amtShown, LogEntries.size());
+
+		if (isChannelToggled)
+		{
+			this->Query.Channels.clear();
+
+			for (LogChannel_t& ch : this->Channels)
+			{
+				if (ch.IsSelected)
+				{
+					this->Query.Channels.push_back(ch.Name);
+				}
+			}
+
+			this->IsFilterDirty = true;
+		}
+
+		ImGui::TextDisabled("%d / %d", (int)this->FilteredIDs.size(), (int)LogEntries.size());
 
 		ImGui::EndChild();
 	}
@@ -148,71 +223,62 @@ void CLogWindow::RenderContent()
 
 	ImGui::SameLine();
 
-	amtShown = 0;
-
 	{
 		ImGui::BeginChild("Messages", ImVec2(.0f, .0f), false, ImGuiWindowFlags_NoBackground);
 
 		float maxHeight = ImGui::GetWindowHeight();
+		float cellPaddingY = ImGui::GetStyle().CellPadding.y;
+		float wrapWidth = this->RowWrapWidth;
 
 		const std::lock_guard<std::mutex> lock(Mutex);
 		{
-			std::vector<DisplayLogEntry_t*> displayedEntries;
-			for (size_t i = 0; i < LogEntries.size(); i++)
-			{
-				DisplayLogEntry_t* msg = LogEntries[i];
-
-				/* Filter level set. */
-				if (this->FilterLevel != ELogLevel::ALL)
-				{
-					if (this->SelectedLevelOnly)
-					{
-						if (msg->Entry->Level != this->FilterLevel)
-						{
-							continue;
-						}
-					}
-					else
-					{
-						if (msg->Entry->Level > this->FilterLevel)
-						{
-							continue;
-						}
-					}
-				}
+			this->UpdateFiltered();
 
-				/* additional channel filtering */
-				if (activeChannels.size() == 0)
-				{
-					/* no channels filtered for */
-					displayedEntries.push_back(msg);
-				}
-				else if (std::find(activeChannels.begin(), activeChannels.end(), msg->Entry->Channel) != activeChannels.end())
-				{
-					/* matching one of the active channels */
-					displayedEntries.push_back(msg);
-				}
+			/* Row offsets are measured with the wrap width of the previous frame. */
+			if (this->RowOffsets.empty())
+			{
+				this->RowOffsets.push_back(0);
 			}
 
-			size_t start = 0;
+			while (this->RowOffsets.size() <= this->FilteredIDs.size())
+			{
+				DisplayLogEntry_t* msg = this->LogEntries[this->FilteredIDs[this->RowOffsets.size() - 1] - this->SearchIndex.GetFirstID()];
+				this->RowOffsets.push_back(this->RowOffsets.back() + this->CalcMessageHeight(msg, this->RowWrapWidth) + cellPaddingY * 2);
+			}
 
-			/* Start Index */
-			if (this->MaxShownCount > 0 && displayedEntries.size() > this->MaxShownCount)
+			/* The newest row can grow, when its message repeats. */
+			if (!this->FilteredIDs.empty())
 			{
-				start = displayedEntries.size() - this->MaxShownCount;
+				DisplayLogEntry_t* msg = this->LogEntries[this->FilteredIDs.back() - this->SearchIndex.GetFirstID()];
+				this->RowOffsets.back() = this->RowOffsets[this->RowOffsets.size() - 2] + this->CalcMessageHeight(msg, this->RowWrapWidth) + cellPaddingY * 2;
 			}
 
+			/* Only the rows within the visible region are submitted, the others are spacers. */
+			double tableTop = ImGui::GetCursorPosY();
+			double base     = this->RowOffsets.front();
+			double viewTop  = ImGui::GetScrollY() - tableTop + base;
+
+			size_t first = std::upper_bound(this->RowOffsets.begin(), this->RowOffsets.end(), viewTop) - this->RowOffsets.begin();
+			first = first > 0 ? first - 1 : 0;
+			first = (std::min)(first, this->FilteredIDs.size());
+
+			size_t last = std::lower_bound(this->RowOffsets.begin() + first, this->RowOffsets.end(), viewTop + maxHeight) - this->RowOffsets.begin();
+			last = (std::min)(last, this->FilteredIDs.size());
+
 			if (ImGui::BeginTable("##LogMessages", 4, ImGuiTableFlags_BordersInnerH | ImGuiTableFlags_SizingFixedFit))
 			{
-				for (size_t i = start; i < displayedEntries.size(); i++)
+				if (first > 0)
 				{
-					DisplayLogEntry_t* msg = displayedEntries[i];
+					ImGui::TableNextRow(ImGuiTableRowFlags_None, (float)(this->RowOffsets[first] - base));
+				}
 
-					amtShown++;
+				for (size_t i = first; i < last; i++)
+				{
+					DisplayLogEntry_t* msg = this->LogEntries[this->FilteredIDs[i] - this->SearchIndex.GetFirstID()];
 
 					const char* level;
 					ImColor levelColor;
-					switch (msg->Entry->Level)
+					switch (msg->Entry.Level)
 					{
 						case ELogLevel::CRITICAL:   level = "[CRITICAL]";   levelColor = IM_COL32(255, 0, 0, 255);     break;
 						case ELogLevel::WARNING:    level = "[WARNING]";    levelColor = IM_COL32(255, 255, 0, 255);   break;
@@ -222,32 +288,22 @@ void CLogWindow::RenderContent()
 						default:                    level = "[TRACE]";      levelColor = IM_COL32(220, 220, 220, 255); break;
 					}
 
-					ImVec2 rowPos = ImGui::GetCursorPos();
-
-					ImGui::TableNextRow();
+					ImGui::TableNextRow(ImGuiTableRowFlags_None, (float)(this->RowOffsets[i + 1] - this->RowOffsets[i]));
 
 					/* time */
 					ImGui::TableSetColumnIndex(0);
-					ImGui::TextColored(levelColor, TimestampStr(msg->Entry, false, true).c_str());
+					ImGui::TextColored(levelColor, TimestampStr(&msg->Entry, false, true).c_str());
 
 					/* channel */
 					ImGui::TableSetColumnIndex(1);
-					ImGui::TextColored(levelColor, msg->Entry->Channel.c_str());
+					ImGui::TextColored(levelColor, msg->Entry.Channel.c_str());
 
 					/* level */
 					ImGui::TableSetColumnIndex(2);
 					ImGui::TextColored(levelColor, level);
 
 					ImGui::TableSetColumnIndex(3);
-					float wrapWidth = ImGui::GetWindowContentRegionWidth() - ImGui::GetCursorPosX() - ImGui::GetStyle().CellPadding.x;
-					float msgHeight = ImGui::CalcTextSize(msg->Entry->Message.c_str(), (const char*)0, false, wrapWidth).y;
-
-					/*  above visible space                        || under visible space */
-					if (rowPos.y < ImGui::GetScrollY() - msgHeight || rowPos.y > ImGui::GetScrollY() + maxHeight)
-					{
-						ImGui::Dummy(ImVec2(wrapWidth, msgHeight));
-						continue;
-					}
+					wrapWidth = ImGui::GetWindowContentRegionWidth() - ImGui::GetCursorPosX() - ImGui::GetStyle().CellPadding.x;
 
 					/* message */
 					float lineHeight = ImGui::GetTextLineHeight();
@@ -262,9 +318,7 @@ void CLogWindow::RenderContent()
 						{
 							case EMessagePartType::Text:
 							{
-								float currWidth = ImGui::CalcTextSize(msgPart.Text.c_str()).x;
-
-								if (pos.x - posInitial.x + currWidth > wrapWidth)
+								if (pos.x - posInitial.x + msgPart.Width > wrapWidth)
 								{
 									pos.x = posInitial.x;
 									pos.y += lineHeight;
@@ -272,7 +326,7 @@ void CLogWindow::RenderContent()
 
 								ImGui::SetCursorPos(pos);
 								ImGui::TextUnformatted(msgPart.Text.c_str());
-								pos.x += currWidth;
+								pos.x += msgPart.Width;
 								break;
 							}
 							case EMessagePartType::ColorPush:
@@ -307,8 +361,20 @@ void CLogWindow::RenderContent()
 					}
 				}
 
+				if (last < this->FilteredIDs.size())
+				{
+					ImGui::TableNextRow(ImGuiTableRowFlags_None, (float)(this->RowOffsets.back() - this->RowOffsets[last]));
+				}
+
 				ImGui::EndTable();
 			}
+
+			/* Column widths changed, measure all rows again next frame. */
+			if (wrapWidth != this->RowWrapWidth)
+			{
+				this->RowWrapWidth = wrapWidth;
+				this->RowOffsets.clear();
+			}
 		}
 
 		if (ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
@@ -331,22 +397,26 @@ void CLogWindow::MsgProc(const LogMsg_t* aLogEntry)
 
 	DisplayLogEntry_t* displayMsg = nullptr;
 
-	if (aLogEntry->RepeatCount > 1)
+	/* The entry is only valid during this call, so it is copied. */
+	bool isRepeat = aLogEntry->RepeatCount > 1 && this->LogEntries.size() > 0;
+
+	if (isRepeat)
 	{
 		displayMsg = this->LogEntries[this->LogEntries.size() - 1];
+		displayMsg->Entry.RepeatCount = aLogEntry->RepeatCount;
 		displayMsg->Parts.clear();
 	}
 	else
 	{
 		displayMsg = new DisplayLogEntry_t();
-		displayMsg->Entry = aLogEntry;
+		displayMsg->Entry = *aLogEntry;
 	}
 
-	if (displayMsg->Entry->RepeatCount > 1)
+	if (displayMsg->Entry.RepeatCount > 1)
 	{
 		MessagePart_t msgPart{};
 		msgPart.Type = EMessagePartType::Text;
-		msgPart.Text = "(" + std::to_string(displayMsg->Entry->RepeatCount) + ")";
+		msgPart.Text = "(" + std::to_string(displayMsg->Entry.RepeatCount) + ")";
 		displayMsg->Parts.push_back(msgPart);
 		MessagePart_t msgSpace{};
 		msgSpace.Type = EMessagePartType::Text;
@@ -442,8 +512,138 @@ void CLogWindow::MsgProc(const LogMsg_t* aLogEntry)
 		}
 	}
 
-	if (aLogEntry->RepeatCount == 1)
+	if (!isRepeat)
 	{
 		this->LogEntries.push_back(displayMsg);
+		this->SearchIndex.Add(&displayMsg->Entry);
+
+		/* Keep the window within the same budget as the log itself. */
+		while (this->LogEntries.size() > this->MaxEntryCount)
+		{
+			this->SearchIndex.Evict();
+			delete this->LogEntries.front();
+			this->LogEntries.pop_front();
+		}
+	}
+}
+
+void CLogWindow::Export()
+{
+	std::filesystem::path path = Index(EPath::DIR_NEXUS) / "LogExport.log";
+	size_t amtExported = 0;
+
+	{
+		const std::lock_guard<std::mutex> lock(Mutex);
+
+		std::vector<uint32_t> ids;
+		this->SearchIndex.Query(this->Query, ids);
+
+		std::ofstream file(path);
+
+		if (!file.is_open()) { return; }
+
+		std::string line;
+
+		for (uint32_t id : ids)
+		{
+			line.clear();
+			ToString(this->SearchIndex.Get(id), line);
+			file.write(line.data(), line.size());
+		}
+
+		amtExported = ids.size();
+	}
+
+	/* Logged after the lock is released, the message is dispatched to this window too. */
+	CContext::GetContext()->GetLogger()->Info(CH_UICONTEXT, "Exported %zu log message(s) to %s.", amtExported, path.string().c_str());
+}
+
+void CLogWindow::UpdateFiltered()
+{
+	if (this->IsFilterDirty)
+	{
+		std::vector<uint32_t> ids;
+		this->SearchIndex.Query(this->Query, ids, (size_t)this->MaxShownCount);
+
+		this->FilteredIDs.assign(ids.begin(), ids.end());
+		this->RowOffsets.clear();
+		this->FilteredNextID = this->SearchIndex.GetNextID();
+		this->IsFilterDirty  = false;
+	}
+	else
+	{
+		/* Only the messages added since the last frame are matched. */
+		uint32_t id = (std::max)(this->FilteredNextID, this->SearchIndex.GetFirstID());
+
+		for (; id < this->SearchIndex.GetNextID(); id++)
+		{
+			if (this->SearchIndex.Matches(this->Query, id))
+			{
+				this->FilteredIDs.push_back(id);
+			}
+		}
+
+		this->FilteredNextID = id;
+	}
+
+	/* Drop rows that were evicted, left the time range or exceed the shown count. */
+	while (!this->FilteredIDs.empty())
+	{
+		const LogMsg_t* msg = this->SearchIndex.Get(this->FilteredIDs.front());
+
+		if (msg && msg->Time >= this->Query.Since && (this->MaxShownCount == 0 || this->FilteredIDs.size() <= (size_t)this->MaxShownCount))
+		{
+			break;
+		}
+
+		this->FilteredIDs.pop_front();
+
+		if (!this->RowOffsets.empty())
+		{
+			this->RowOffsets.pop_front();
+		}
 	}
 }
+
+float CLogWindow::CalcMessageHeight(DisplayLogEntry_t* aEntry, float aWrapWidth)
+{
+	float lineHeight = ImGui::GetTextLineHeight();
+	float x = 0;
+	float height = lineHeight;
+
+	/* Same layout as in RenderContent. */
+	for (MessagePart_t& msgPart : aEntry->Parts)
+	{
+		switch (msgPart.Type)
+		{
+			case EMessagePartType::Text:
+			{
+				if (msgPart.Width < 0)
+				{
+					msgPart.Width = ImGui::CalcTextSize(msgPart.Text.c_str()).x;
+				}
+
+				if (x + msgPart.Width > aWrapWidth)
+				{
+					x = 0;
+					height += lineHeight;
+				}
+
+				x += msgPart.Width;
+				break;
+			}
+			case EMessagePartType::LineBreak:
+			{
+				x = 0;
+				height += lineHeight;
+				break;
+			}
+			default:
+			{
+				break;
+			}
+		}
+	}
+
+	return height;
+}
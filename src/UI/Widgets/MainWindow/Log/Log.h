@@ -9,6 +9,7 @@
 #ifndef MAINWINDOW_LOG_H
 #define MAINWINDOW_LOG_H
 
+#include <deque>
 #include <vector>
 #include <string>
 #include <mutex>
@@ -16,7 +17,9 @@
 #include "imgui/imgui.h"
 
 #include "Engine/Logging/LogBase.h"
+#include "Engine/Logging/LogIndex.h"
 #include "Engine/Logging/LogMsg.h"
+#include "Engine/Logging/LogQuery.h"
 #include "UI/Controls/CtlSubWindow.h"
 
 class CLogWindow : public virtual ISubWindow, public virtual ILogger
@@ -45,11 +48,12 @@ class CLogWindow : public virtual ISubWindow, public virtual ILogger
 		EMessagePartType Type;
 		std::string      Text;
 		ImVec4           Color;
+		float            Width = -1.0f; /* Text width, measured on first layout. */
 	};
 
 	struct DisplayLogEntry_t
 	{
-		const LogMsg_t*            Entry = nullptr;
+		LogMsg_t                   Entry;
 		std::vector<MessagePart_t> Parts;
 	};
 
@@ -60,12 +64,44 @@ class CLogWindow : public virtual ISubWindow, public virtual ILogger
 	};
 
 	int                             MaxShownCount     = 400;
+	size_t                          MaxEntryCount     = 65536;
 	ELogLevel                       FilterLevel       = ELogLevel::ALL;
 	bool                            SelectedLevelOnly = false;
+	char                            SearchText[256]   = {};
+	int                             SinceMinutes      = 0;
 
 	std::mutex                      Mutex;
-	std::vector<DisplayLogEntry_t*> LogEntries;
+	std::deque<DisplayLogEntry_t*>  LogEntries;
 	std::vector<LogChannel_t>       Channels;
+	CLogIndex                       SearchIndex;      /* Over the LogEntries, the entry of an ID is LogEntries[ID - SearchIndex.GetFirstID()]. */
+	LogQuery_t                      Query;
+	int                             QuerySinceMinutes  = 0;
+	int                             QueryMaxShownCount = 0;
+	bool                            IsFilterDirty      = true;
+
+	std::deque<uint32_t>            FilteredIDs;       /* Cached matches of the Query, oldest first. */
+	std::deque<double>              RowOffsets;        /* Top of each filtered row and the bottom of the last, measured lazily. Only grows, hence double. */
+	uint32_t                        FilteredNextID     = 0; /* First ID not matched against the Query yet. */
+	float                           RowWrapWidth       = 0;
+
+	///----------------------------------------------------------------------------------------------------
+	/// Export:
+	/// 	Writes all messages matching the current filter to LogExport.log.
+	///----------------------------------------------------------------------------------------------------
+	void Export();
+
+	///----------------------------------------------------------------------------------------------------
+	/// UpdateFiltered:
+	/// 	Re-runs the Query if a filter changed, otherwise only matches the new messages.
+	/// 	Must be called with the Mutex held.
+	///----------------------------------------------------------------------------------------------------
+	void UpdateFiltered();
+
+	///----------------------------------------------------------------------------------------------------
+	/// CalcMessageHeight:
+	/// 	Returns the height of the message parts, wrapped at aWrapWidth.
+	///----------------------------------------------------------------------------------------------------
+	float CalcMessageHeight(DisplayLogEntry_t* aEntry, float aWrapWidth);
 };
 
 #endif
@@ -0,0 +1,332 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  Platform.cpp
+/// Description  :  Contains the operating system functions used by the Engine core.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include "Platform.h"
+
+#ifdef _WIN32
+#include <share.h>
+#include <string.h>
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Platform
+{
+#ifdef _WIN32
+	uint32_t GetProcessId()
+	{
+		return GetCurrentProcessId();
+	}
+
+	uint32_t GetLastError()
+	{
+		return ::GetLastError();
+	}
+
+	char* DuplicateString(const char* aString)
+	{
+		return _strdup(aString);
+	}
+
+	int64_t GetPerformanceCounter()
+	{
+		LARGE_INTEGER counter{};
+		QueryPerformanceCounter(&counter);
+		return counter.QuadPart;
+	}
+
+	int64_t GetPerformanceFrequency()
+	{
+		LARGE_INTEGER frequency{};
+		QueryPerformanceFrequency(&frequency);
+		return frequency.QuadPart;
+	}
+
+	void* OpenSharedMemory(const char* aName, size_t aSize, void*& aHandle)
+	{
+		aHandle = nullptr;
+
+		HANDLE handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, aName);
+
+		if (!handle)
+		{
+			handle = CreateFileMappingA(
+				INVALID_HANDLE_VALUE,
+				0,
+				PAGE_READWRITE,
+				0,
+				static_cast<DWORD>(aSize),
+				aName
+			);
+		}
+
+		if (!handle)
+		{
+			return nullptr;
+		}
+
+		void* pointer = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, static_cast<DWORD>(aSize));
+
+		if (!pointer)
+		{
+			CloseHandle(handle);
+			return nullptr;
+		}
+
+		aHandle = handle;
+
+		return pointer;
+	}
+
+	void CloseSharedMemory(void* aPointer, size_t aSize, void* aHandle)
+	{
+		if (aPointer)
+		{
+			UnmapViewOfFile(aPointer);
+		}
+
+		if (aHandle)
+		{
+			CloseHandle(aHandle);
+		}
+	}
+
+	void* OpenMappedFile(const std::filesystem::path& aPath, size_t aSize, void*& aHandle)
+	{
+		aHandle = nullptr;
+
+		HANDLE file = CreateFileW(
+			aPath.c_str(),
+			GENERIC_READ | GENERIC_WRITE,
+			FILE_SHARE_READ,
+			0,
+			OPEN_ALWAYS,
+			FILE_ATTRIBUTE_NORMAL,
+			0
+		);
+
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return nullptr;
+		}
+
+		/* Grows the file to aSize if it is smaller. */
+		HANDLE handle = CreateFileMappingW(
+			file,
+			0,
+			PAGE_READWRITE,
+			0,
+			static_cast<DWORD>(aSize),
+			0
+		);
+
+		/* The mapping keeps the file open, the file handle is not needed anymore. */
+		CloseHandle(file);
+
+		if (!handle)
+		{
+			return nullptr;
+		}
+
+		void* pointer = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, aSize);
+
+		if (!pointer)
+		{
+			CloseHandle(handle);
+			return nullptr;
+		}
+
+		aHandle = handle;
+
+		return pointer;
+	}
+
+	void OpenWriteLocked(std::ofstream& aStream, const std::filesystem::path& aPath, std::ios_base::openmode aMode)
+	{
+		aStream.open(aPath, aMode, _SH_DENYWR);
+	}
+
+	void* AllocateCode(size_t aSize)
+	{
+		return VirtualAlloc(nullptr, aSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+	}
+
+	bool ProtectCode(void* aPointer, size_t aSize)
+	{
+		DWORD oldProtect = 0;
+
+		if (!VirtualProtect(aPointer, aSize, PAGE_EXECUTE_READ, &oldProtect))
+		{
+			return false;
+		}
+
+		return FlushInstructionCache(GetCurrentProcess(), aPointer, aSize) != 0;
+	}
+
+	void FreeCode(void* aPointer, size_t aSize)
+	{
+		if (aPointer)
+		{
+			VirtualFree(aPointer, 0, MEM_RELEASE);
+		}
+	}
+
+	bool AddUnwindTable(const uint32_t* aTable, uint32_t aCount, void* aBase)
+	{
+#ifdef _M_X64
+		static_assert(sizeof(RUNTIME_FUNCTION) == 3 * sizeof(uint32_t), "RUNTIME_FUNCTION is begin, end and unwind info.");
+
+		return RtlAddFunctionTable((PRUNTIME_FUNCTION)aTable, aCount, (DWORD64)aBase) != FALSE;
+#else
+		return false;
+#endif
+	}
+#else
+	uint32_t GetProcessId()
+	{
+		return static_cast<uint32_t>(getpid());
+	}
+
+	uint32_t GetLastError()
+	{
+		return static_cast<uint32_t>(errno);
+	}
+
+	char* DuplicateString(const char* aString)
+	{
+		return strdup(aString);
+	}
+
+	int64_t GetPerformanceCounter()
+	{
+		timespec ts{};
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+	}
+
+	int64_t GetPerformanceFrequency()
+	{
+		return 1000000000;
+	}
+
+	void* OpenSharedMemory(const char* aName, size_t aSize, void*& aHandle)
+	{
+		aHandle = nullptr;
+
+		/* POSIX shared memory names have to start with a slash. */
+		std::string name = "/";
+		name.append(aName);
+
+		int fd = shm_open(name.c_str(), O_RDWR | O_CREAT, 0600);
+
+		if (fd == -1)
+		{
+			return nullptr;
+		}
+
+		if (ftruncate(fd, static_cast<off_t>(aSize)) == -1)
+		{
+			close(fd);
+			return nullptr;
+		}
+
+		void* pointer = mmap(nullptr, aSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+		/* The mapping keeps the memory alive, the descriptor is not needed anymore. */
+		close(fd);
+
+		if (pointer == MAP_FAILED)
+		{
+			return nullptr;
+		}
+
+		return pointer;
+	}
+
+	void CloseSharedMemory(void* aPointer, size_t aSize, void* /*aHandle*/)
+	{
+		/* The descriptor was closed right after mapping. */
+		if (aPointer)
+		{
+			munmap(aPointer, aSize);
+		}
+	}
+
+	void* OpenMappedFile(const std::filesystem::path& aPath, size_t aSize, void*& aHandle)
+	{
+		aHandle = nullptr;
+
+		int fd = open(aPath.c_str(), O_RDWR | O_CREAT, 0644);
+
+		if (fd == -1)
+		{
+			return nullptr;
+		}
+
+		struct stat st{};
+
+		if (fstat(fd, &st) == -1 || (static_cast<size_t>(st.st_size) < aSize && ftruncate(fd, static_cast<off_t>(aSize)) == -1))
+		{
+			close(fd);
+			return nullptr;
+		}
+
+		void* pointer = mmap(nullptr, aSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+		/* The mapping keeps the file alive, the descriptor is not needed anymore. */
+		close(fd);
+
+		if (pointer == MAP_FAILED)
+		{
+			return nullptr;
+		}
+
+		return pointer;
+	}
+
+	void OpenWriteLocked(std::ofstream& aStream, const std::filesystem::path& aPath, std::ios_base::openmode aMode)
+	{
+		/* No mandatory locks, a plain open. */
+		aStream.open(aPath, aMode);
+	}
+
+	void* AllocateCode(size_t aSize)
+	{
+		void* pointer = mmap(nullptr, aSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+		return pointer == MAP_FAILED ? nullptr : pointer;
+	}
+
+	bool ProtectCode(void* aPointer, size_t aSize)
+	{
+		return mprotect(aPointer, aSize, PROT_READ | PROT_EXEC) == 0;
+	}
+
+	void FreeCode(void* aPointer, size_t aSize)
+	{
+		if (aPointer)
+		{
+			munmap(aPointer, aSize);
+		}
+	}
+
+	bool AddUnwindTable(const uint32_t* /*aTable*/, uint32_t /*aCount*/, void* /*aBase*/)
+	{
+		/* Generated code only runs with the Windows calling convention, there is no table to add to. */
+		return false;
+	}
+#endif
+}
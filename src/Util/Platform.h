@@ -0,0 +1,106 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  Platform.h
+/// Description  :  Contains the operating system functions used by the Engine core.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+
+///----------------------------------------------------------------------------------------------------
+/// Platform Namespace
+/// 	Keeps the Engine core free of <windows.h>, so it can be built and measured outside the game.
+///----------------------------------------------------------------------------------------------------
+namespace Platform
+{
+	///----------------------------------------------------------------------------------------------------
+	/// GetProcessId:
+	/// 	Returns the ID of the current process.
+	///----------------------------------------------------------------------------------------------------
+	uint32_t GetProcessId();
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetLastError:
+	/// 	Returns the last error code of the calling thread.
+	///----------------------------------------------------------------------------------------------------
+	uint32_t GetLastError();
+
+	///----------------------------------------------------------------------------------------------------
+	/// DuplicateString:
+	/// 	Returns a malloc'd copy of the string, to be released with free.
+	///----------------------------------------------------------------------------------------------------
+	char* DuplicateString(const char* aString);
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetPerformanceCounter:
+	/// 	Returns the current value of the high resolution counter.
+	///----------------------------------------------------------------------------------------------------
+	int64_t GetPerformanceCounter();
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetPerformanceFrequency:
+	/// 	Returns the ticks per second of the high resolution counter.
+	///----------------------------------------------------------------------------------------------------
+	int64_t GetPerformanceFrequency();
+
+	///----------------------------------------------------------------------------------------------------
+	/// OpenSharedMemory:
+	/// 	Opens the named shared memory or creates it, if it does not exist yet, and maps it.
+	/// 	Returns the mapped view or nullptr. aHandle receives the handle to pass to CloseSharedMemory.
+	///----------------------------------------------------------------------------------------------------
+	void* OpenSharedMemory(const char* aName, size_t aSize, void*& aHandle);
+
+	///----------------------------------------------------------------------------------------------------
+	/// CloseSharedMemory:
+	/// 	Unmaps the view and closes the handle of shared memory opened by OpenSharedMemory.
+	///----------------------------------------------------------------------------------------------------
+	void CloseSharedMemory(void* aPointer, size_t aSize, void* aHandle);
+
+	///----------------------------------------------------------------------------------------------------
+	/// OpenMappedFile:
+	/// 	Opens or creates the file, grows it to at least aSize and maps it.
+	/// 	Writes to the view reach the file even if the process dies. Close with CloseSharedMemory.
+	///----------------------------------------------------------------------------------------------------
+	void* OpenMappedFile(const std::filesystem::path& aPath, size_t aSize, void*& aHandle);
+
+	///----------------------------------------------------------------------------------------------------
+	/// OpenWriteLocked:
+	/// 	Opens the file for writing. Other processes may read it, but not write to it while it is open.
+	///----------------------------------------------------------------------------------------------------
+	void OpenWriteLocked(std::ofstream& aStream, const std::filesystem::path& aPath, std::ios_base::openmode aMode);
+
+	///----------------------------------------------------------------------------------------------------
+	/// AllocateCode:
+	/// 	Allocates writable memory for generated code. Make it executable with ProtectCode before running it.
+	///----------------------------------------------------------------------------------------------------
+	void* AllocateCode(size_t aSize);
+
+	///----------------------------------------------------------------------------------------------------
+	/// ProtectCode:
+	/// 	Makes memory from AllocateCode executable and read-only. Returns false on failure.
+	///----------------------------------------------------------------------------------------------------
+	bool ProtectCode(void* aPointer, size_t aSize);
+
+	///----------------------------------------------------------------------------------------------------
+	/// FreeCode:
+	/// 	Frees memory from AllocateCode.
+	///----------------------------------------------------------------------------------------------------
+	void FreeCode(void* aPointer, size_t aSize);
+
+	///----------------------------------------------------------------------------------------------------
+	/// AddUnwindTable:
+	/// 	Registers the x64 unwind data of generated code, so exceptions and stack walks can pass it.
+	/// 	aTable holds aCount entries of three offsets from aBase: begin, end and unwind info.
+	/// 	Returns false, if the platform has no such table or it was not registered.
+	///----------------------------------------------------------------------------------------------------
+	bool AddUnwindTable(const uint32_t* aTable, uint32_t aCount, void* aBase);
+}
+
+#endif
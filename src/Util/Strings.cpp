@@ -8,11 +8,14 @@
 
 #include "Strings.h"
 
-#include <Windows.h>
-
 #include <algorithm>
 #include <cstdarg>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <Windows.h>
 #include <stringapiset.h>
+#endif
 
 namespace String
 {
@@ -99,7 +102,7 @@ namespace String
 		va_list args;
 		va_start(args, aFmt);
 		char buffer[MAX_STRING_FORMAT_LENGTH];
-		vsprintf_s(buffer, MAX_STRING_FORMAT_LENGTH - 1, aFmt.c_str(), args);
+		vsnprintf(buffer, MAX_STRING_FORMAT_LENGTH - 1, aFmt.c_str(), args);
 		va_end(args);
 
 		return buffer;
@@ -154,6 +157,7 @@ namespace String
 		return aString;
 	}
 
+#ifdef _WIN32
 	std::string ToString(const std::wstring& aWstring)
 	{
 		if (aWstring.empty())
@@ -202,4 +206,21 @@ namespace String
 
 		return std::string(utf8Str ? utf8Str : "");
 	}
+#else
+	/* Outside of Windows the narrow encoding is UTF-8, only plain ASCII is converted. */
+	std::string ToString(const std::wstring& aWstring)
+	{
+		return std::string(aWstring.begin(), aWstring.end());
+	}
+
+	std::wstring ToWString(const std::string& aString)
+	{
+		return std::wstring(aString.begin(), aString.end());
+	}
+
+	std::string ConvertMBToUTF8(std::string aString)
+	{
+		return aString;
+	}
+#endif
 }
@@ -24,6 +24,20 @@ namespace Time
 		return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 	}
 
+	std::tm ToLocalTime(long long aTimestamp)
+	{
+		std::time_t t = (std::time_t)aTimestamp;
+		std::tm result{};
+
+#ifdef _WIN32
+		localtime_s(&result, &t);
+#else
+		localtime_r(&t, &result);
+#endif
+
+		return result;
+	}
+
 	int GetMilliseconds()
 	{
 		return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() % 1000;
@@ -9,6 +9,7 @@
 #ifndef TIME_H
 #define TIME_H
 
+#include <ctime>
 #include <string>	
 
 ///----------------------------------------------------------------------------------------------------
@@ -28,6 +29,12 @@ namespace Time
 	///----------------------------------------------------------------------------------------------------
 	long long GetTimestampMs();
 
+	///----------------------------------------------------------------------------------------------------
+	/// ToLocalTime:
+	/// 	Converts a timestamp in seconds to the local calendar time.
+	///----------------------------------------------------------------------------------------------------
+	std::tm ToLocalTime(long long aTimestamp);
+
 	///----------------------------------------------------------------------------------------------------
 	/// GetMilliseconds:
 	/// 	Returns the current milliseconds.
@@ -0,0 +1,60 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  NLogDecoder.cpp
+/// Description  :  Command line decoder for binary Nexus logs (.nlog).
+/// Authors      :  K. Bieniek
+///
+/// Usage        :  NLogDecoder <Nexus.nlog> [Nexus.log]
+/// 	Writes the decoded text to the second path or to stdout.
+/// Build        :  cmake -S . -B build && cmake --build build --target NLogDecoder
+///----------------------------------------------------------------------------------------------------
+
+#include <fstream>
+#include <iostream>
+
+#include "Engine/Logging/LogBinary.h"
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: NLogDecoder <Nexus.nlog> [Nexus.log]\n";
+		return 1;
+	}
+
+	std::ifstream in(argv[1], std::ios_base::in | std::ios_base::binary);
+
+	if (!in.is_open())
+	{
+		std::cerr << "Could not open " << argv[1] << ".\n";
+		return 1;
+	}
+
+	bool success = false;
+
+	if (argc > 2)
+	{
+		std::ofstream out(argv[2], std::ios_base::out);
+
+		if (!out.is_open())
+		{
+			std::cerr << "Could not open " << argv[2] << ".\n";
+			return 1;
+		}
+
+		success = LogBinary::Decode(in, out);
+	}
+	else
+	{
+		success = LogBinary::Decode(in, std::cout);
+	}
+
+	if (!success)
+	{
+		std::cerr << "Not a binary log or the file is truncated.\n";
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,68 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  Bench.h
+/// Description  :  Shared definitions of the Engine core benchmarks.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+///----------------------------------------------------------------------------------------------------
+/// Benchmark_t Struct
+///----------------------------------------------------------------------------------------------------
+struct Benchmark_t
+{
+	std::string             Name;
+	std::string             Unit;
+	std::function<double()> Run;
+};
+
+///----------------------------------------------------------------------------------------------------
+/// Bench Namespace
+///----------------------------------------------------------------------------------------------------
+namespace Bench
+{
+	///----------------------------------------------------------------------------------------------------
+	/// SetDuration:
+	/// 	Sets how long MeasureRate measures, in milliseconds.
+	///----------------------------------------------------------------------------------------------------
+	void SetDuration(uint32_t aMilliseconds);
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetDuration:
+	/// 	Returns how long a benchmark should measure, in milliseconds.
+	///----------------------------------------------------------------------------------------------------
+	uint32_t GetDuration();
+
+	///----------------------------------------------------------------------------------------------------
+	/// MeasureRate:
+	/// 	Calls aBody on aThreads threads until the duration passed and returns the operations per second.
+	/// 	aBody receives the thread index and returns the amount of operations it performed.
+	///----------------------------------------------------------------------------------------------------
+	double MeasureRate(uint32_t aThreads, const std::function<uint64_t(uint32_t)>& aBody);
+
+	///----------------------------------------------------------------------------------------------------
+	/// GetTempDirectory:
+	/// 	Returns an emptied directory for the files of a benchmark.
+	///----------------------------------------------------------------------------------------------------
+	std::filesystem::path GetTempDirectory(const char* aName);
+}
+
+///----------------------------------------------------------------------------------------------------
+/// Register*Benchmarks:
+/// 	Add the benchmarks of one subsystem.
+///----------------------------------------------------------------------------------------------------
+void RegisterEventBenchmarks(std::vector<Benchmark_t>& aBenchmarks);
+void RegisterLogBenchmarks(std::vector<Benchmark_t>& aBenchmarks);
+void RegisterLocalizationBenchmarks(std::vector<Benchmark_t>& aBenchmarks);
+void RegisterCacheBenchmarks(std::vector<Benchmark_t>& aBenchmarks);
+
+#endif
@@ -0,0 +1,45 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  BenchCache.cpp
+/// Description  :  Benchmarks of CHttpCache.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include "Bench.h"
+
+#include "Engine/Networking/WebRequests/WreCache.h"
+#include "Util/Time.h"
+
+constexpr int BENCH_CACHE_ENTRIES = 256;
+
+void RegisterCacheBenchmarks(std::vector<Benchmark_t>& aBenchmarks)
+{
+	aBenchmarks.push_back({ "cache.hit", "hits/s", [] {
+		CHttpCache cache(Bench::GetTempDirectory("Cache"), 300);
+
+		std::vector<std::string> queries;
+
+		for (int i = 0; i < BENCH_CACHE_ENTRIES; i++)
+		{
+			HttpResponse_t response{};
+			response.Time = Time::GetTimestamp();
+			response.StatusCode = 200;
+			response.Content = "{ \"id\": " + std::to_string(i) + " }";
+
+			queries.push_back("/addons/" + std::to_string(i) + "/manifest.json");
+			cache.Store(queries.back(), response);
+		}
+
+		size_t next = 0;
+
+		return Bench::MeasureRate(1, [&](uint32_t) {
+			for (int i = 0; i < 100; i++)
+			{
+				cache.Retrieve(queries[next]);
+				next = (next + 1) % queries.size();
+			}
+			return 100;
+		});
+	} });
+}
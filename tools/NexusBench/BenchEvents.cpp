@@ -0,0 +1,122 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  BenchEvents.cpp
+/// Description  :  Benchmarks of CEventApi.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include "Bench.h"
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "Engine/Events/EvtApi.h"
+
+constexpr size_t BENCH_EVENT_SUBSCRIBERS = 16;
+
+static thread_local uint64_t s_Consumed = 0;
+
+static void OnEvent(void* aEventArgs)
+{
+	(void)aEventArgs;
+	s_Consumed++;
+}
+
+/* Subscribers are told apart by their callback, every one needs its own function. */
+template<size_t N>
+static void OnEventN(void* aEventArgs)
+{
+	(void)aEventArgs;
+	s_Consumed += N + 1;
+}
+
+template<size_t... N>
+static constexpr std::array<EVENT_CONSUME, sizeof...(N)> MakeCallbacks(std::index_sequence<N...>)
+{
+	return { &OnEventN<N>... };
+}
+
+static constexpr std::array<EVENT_CONSUME, BENCH_EVENT_SUBSCRIBERS> s_Callbacks = MakeCallbacks(std::make_index_sequence<BENCH_EVENT_SUBSCRIBERS>());
+
+///----------------------------------------------------------------------------------------------------
+/// MeasureRaise:
+/// 	Returns the raises per second of aThreads threads, raising one event with aSubscribers subscribers.
+/// 	If aIsChurning, another thread subscribes and unsubscribes in a loop, publishing new snapshots.
+///----------------------------------------------------------------------------------------------------
+static double MeasureRaise(uint32_t aThreads, size_t aSubscribers, bool aIsChurning = false)
+{
+	CEventApi events;
+
+	for (size_t i = 0; i < aSubscribers; i++)
+	{
+		events.Subscribe("EV_BENCH", s_Callbacks[i]);
+	}
+
+	std::atomic<bool> stopped = false;
+	std::thread churn;
+
+	if (aIsChurning)
+	{
+		churn = std::thread([&] {
+			while (!stopped)
+			{
+				events.Subscribe("EV_BENCH", OnEvent);
+				events.Unsubscribe("EV_BENCH", OnEvent);
+			}
+		});
+	}
+
+	double result = Bench::MeasureRate(aThreads, [&](uint32_t) {
+		for (int i = 0; i < 1000; i++)
+		{
+			events.Raise("EV_BENCH");
+		}
+		return 1000;
+	});
+
+	stopped = true;
+
+	if (churn.joinable())
+	{
+		churn.join();
+	}
+
+	return result;
+}
+
+void RegisterEventBenchmarks(std::vector<Benchmark_t>& aBenchmarks)
+{
+	for (uint32_t threads : { 1, 4 })
+	{
+		for (size_t subscribers : { (size_t)1, BENCH_EVENT_SUBSCRIBERS })
+		{
+			std::string name = "events.raise.t" + std::to_string(threads) + ".s" + std::to_string(subscribers);
+
+			aBenchmarks.push_back({ name, "raises/s", [threads, subscribers] {
+				return MeasureRaise(threads, subscribers);
+			} });
+		}
+	}
+
+	aBenchmarks.push_back({ "events.raise.t4.s16.churn", "raises/s", [] {
+		return MeasureRaise(4, BENCH_EVENT_SUBSCRIBERS, true);
+	} });
+
+	aBenchmarks.push_back({ "events.raise_handle", "raises/s", [] {
+		CEventApi events;
+		EventHandle handle = events.GetHandle("EV_BENCH");
+		events.SubscribeByHandle(handle, OnEvent);
+
+		return Bench::MeasureRate(1, [&](uint32_t) {
+			for (int i = 0; i < 1000; i++)
+			{
+				events.RaiseByHandle(handle);
+			}
+			return 1000;
+		});
+	} });
+}
@@ -0,0 +1,60 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  BenchLocalization.cpp
+/// Description  :  Benchmarks of CLocalization.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include "Bench.h"
+
+#include <fstream>
+
+#include "Engine/Logging/LogApi.h"
+#include "UI/Services/Localization/LoclApi.h"
+
+constexpr int BENCH_LOCL_TEXTS = 2000;
+
+void RegisterLocalizationBenchmarks(std::vector<Benchmark_t>& aBenchmarks)
+{
+	aBenchmarks.push_back({ "locl.translate", "lookups/s", [] {
+		std::filesystem::path dir = Bench::GetTempDirectory("Locales");
+
+		std::vector<std::string> identifiers;
+
+		for (const char* language : { "en", "de" })
+		{
+			std::ofstream file(dir / (std::string(language) + ".json"));
+			file << "{ \"Identifier\": \"" << language << "\", \"DisplayName\": \"" << language << "\", \"Texts\": {";
+
+			for (int i = 0; i < BENCH_LOCL_TEXTS; i++)
+			{
+				file << (i ? "," : "") << "\"((BENCH_TEXT_" << i << "))\": \"" << language << " text " << i << "\"";
+			}
+
+			file << "} }";
+		}
+
+		for (int i = 0; i < BENCH_LOCL_TEXTS; i++)
+		{
+			identifiers.push_back("((BENCH_TEXT_" + std::to_string(i) + "))");
+		}
+
+		CLogApi logger;
+		CLocalization localization(&logger);
+		localization.SetLocaleDirectory(dir);
+		localization.SetLanguage("en");
+		localization.Advance();
+
+		size_t next = 0;
+
+		return Bench::MeasureRate(1, [&](uint32_t) {
+			for (int i = 0; i < 1000; i++)
+			{
+				localization.Translate(identifiers[next].c_str());
+				next = (next + 1) % identifiers.size();
+			}
+			return 1000;
+		});
+	} });
+}
@@ -0,0 +1,290 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  BenchLogging.cpp
+/// Description  :  Benchmarks of CLogApi.
+/// Authors      :  K. Bieniek
+///----------------------------------------------------------------------------------------------------
+
+#include "Bench.h"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+#include "Engine/Logging/LogApi.h"
+#include "Engine/Logging/LogBase.h"
+#include "Engine/Logging/LogIndex.h"
+#include "Engine/Logging/LogWriter.h"
+#include "Util/Time.h"
+
+constexpr const char* CH_BENCH          = "Bench";
+constexpr size_t      BENCH_LOG_QUEUE   = 65536;
+constexpr int         BENCH_LOG_BURST   = 4096;  /* Below the queue capacity, so a burst is never dropped. */
+constexpr int         BENCH_LOG_INDEXED = 262144;
+constexpr size_t      BENCH_LOG_ROWS    = 400;   /* Rows the Log window shows. */
+
+///----------------------------------------------------------------------------------------------------
+/// CCountingLogger Class
+///----------------------------------------------------------------------------------------------------
+class CCountingLogger : public virtual ILogger
+{
+	public:
+	std::atomic<uint64_t> Count = 0;
+
+	void MsgProc(const LogMsg_t* aLogEntry) override
+	{
+		(void)aLogEntry;
+		this->Count++;
+	}
+};
+
+///----------------------------------------------------------------------------------------------------
+/// LogTypical:
+/// 	Logs a message shaped like most of the messages Nexus and addons log.
+///----------------------------------------------------------------------------------------------------
+static void LogTypical(CLogApi& aLogger, int aIndex)
+{
+	aLogger.Info(CH_BENCH, "Loaded %s (%d) in %d ms, %.2f%% of the budget.", "GW2-Example.dll", aIndex, aIndex % 100, 12.5);
+}
+
+///----------------------------------------------------------------------------------------------------
+/// MeasureCaller:
+/// 	Returns the log calls per second, counting only the time spent in the calls.
+/// 	Every burst is drained before the next one, so none is dropped.
+///----------------------------------------------------------------------------------------------------
+static double MeasureCaller(CLogApi& aLogger)
+{
+	double   seconds = 0;
+	uint64_t calls   = 0;
+
+	auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(Bench::GetDuration());
+
+	while (std::chrono::steady_clock::now() < end)
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		for (int i = 0; i < BENCH_LOG_BURST; i++)
+		{
+			LogTypical(aLogger, i);
+		}
+
+		seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		calls += BENCH_LOG_BURST;
+
+		aLogger.Flush();
+	}
+
+	return calls / seconds;
+}
+
+///----------------------------------------------------------------------------------------------------
+/// MeasureThroughput:
+/// 	Returns the messages per second that reach the loggers, while aThreads threads log without pause.
+///----------------------------------------------------------------------------------------------------
+static double MeasureThroughput(CLogApi& aLogger, CCountingLogger& aCounter, uint32_t aThreads)
+{
+	std::atomic<bool> stopped = false;
+	std::vector<std::thread> threads;
+
+	uint64_t before = aCounter.Count;
+	auto start = std::chrono::steady_clock::now();
+
+	for (uint32_t i = 0; i < aThreads; i++)
+	{
+		threads.push_back(std::thread([&] {
+			for (int n = 0; !stopped; n++)
+			{
+				LogTypical(aLogger, n);
+			}
+		}));
+	}
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(Bench::GetDuration()));
+	stopped = true;
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	aLogger.Flush();
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	return (aCounter.Count - before) / seconds;
+}
+
+///----------------------------------------------------------------------------------------------------
+/// MeasureFileSize:
+/// 	Returns the bytes per message a CFileLogger writes in aFormat.
+///----------------------------------------------------------------------------------------------------
+static double MeasureFileSize(ELogFileFormat aFormat)
+{
+	constexpr int count = 16384;
+
+	std::filesystem::path path = Bench::GetTempDirectory("Logging") / (aFormat == ELogFileFormat::Binary ? "Bench.nlog" : "Bench.log");
+
+	{
+		CLogApi logger(BENCH_LOG_QUEUE);
+		logger.SetDeferredFormatting(aFormat == ELogFileFormat::Binary);
+
+		CFileLogger writer(ELogLevel::ALL, path, 1000, aFormat);
+		logger.Register(&writer);
+
+		for (int i = 0; i < count; i++)
+		{
+			LogTypical(logger, i);
+
+			/* Drain before the queue fills up. */
+			if ((i + 1) % BENCH_LOG_BURST == 0)
+			{
+				logger.Flush();
+			}
+		}
+
+		logger.Flush();
+		logger.Deregister(&writer);
+	}
+
+	return (double)std::filesystem::file_size(path) / count;
+}
+
+///----------------------------------------------------------------------------------------------------
+/// MakeIndexedMessages:
+/// 	Returns aCount messages of the last hour, over a few channels and all levels.
+/// 	About one in a hundred contains "timeout".
+///----------------------------------------------------------------------------------------------------
+static std::vector<LogMsg_t> MakeIndexedMessages(int aCount)
+{
+	static const char* channels[] = { "Core", "Loader", "Events", "Textures", "API", "GW2-Example" };
+
+	std::vector<LogMsg_t> messages(aCount);
+
+	long long now = Time::GetTimestamp();
+
+	for (int i = 0; i < aCount; i++)
+	{
+		LogMsg_t& msg = messages[i];
+		msg.Level           = (ELogLevel)(1 + i % 5);
+		msg.Time            = now - 3600 + (3600LL * i) / aCount;
+		msg.TimeMsPrecision = i % 1000;
+		msg.Channel         = channels[i % 6];
+		msg.Message         = i % 97 == 0
+			? "Request " + std::to_string(i) + " failed after timeout of 5000 ms."
+			: "Loaded GW2-Example.dll (" + std::to_string(i) + ") in " + std::to_string(i % 100) + " ms, 12.50% of the budget.";
+	}
+
+	return messages;
+}
+
+void RegisterLogBenchmarks(std::vector<Benchmark_t>& aBenchmarks)
+{
+	aBenchmarks.push_back({ "log.caller", "calls/s", [] {
+		CLogApi logger(BENCH_LOG_QUEUE);
+		CCountingLogger counter;
+		logger.Register(&counter);
+
+		double result = MeasureCaller(logger);
+
+		logger.Deregister(&counter);
+		return result;
+	} });
+
+	aBenchmarks.push_back({ "log.caller.deferred", "calls/s", [] {
+		CLogApi logger(BENCH_LOG_QUEUE);
+		logger.SetDeferredFormatting(true);
+		CCountingLogger counter;
+		logger.Register(&counter);
+
+		double result = MeasureCaller(logger);
+
+		logger.Deregister(&counter);
+		return result;
+	} });
+
+	aBenchmarks.push_back({ "log.throughput.t1", "msgs/s", [] {
+		CLogApi logger(BENCH_LOG_QUEUE);
+		CCountingLogger counter;
+		logger.Register(&counter);
+
+		double result = MeasureThroughput(logger, counter, 1);
+
+		logger.Deregister(&counter);
+		return result;
+	} });
+
+	aBenchmarks.push_back({ "log.throughput.t4", "msgs/s", [] {
+		CLogApi logger(BENCH_LOG_QUEUE);
+		CCountingLogger counter;
+		logger.Register(&counter);
+
+		double result = MeasureThroughput(logger, counter, 4);
+
+		logger.Deregister(&counter);
+		return result;
+	} });
+
+	aBenchmarks.push_back({ "log.file.text", "bytes/msg", [] {
+		return MeasureFileSize(ELogFileFormat::Text);
+	} });
+
+	aBenchmarks.push_back({ "log.file.binary", "bytes/msg", [] {
+		return MeasureFileSize(ELogFileFormat::Binary);
+	} });
+
+	aBenchmarks.push_back({ "log.index.add", "msgs/s", [] {
+		std::vector<LogMsg_t> messages = MakeIndexedMessages(BENCH_LOG_INDEXED);
+
+		CLogIndex index;
+		size_t next = 0;
+
+		/* Keep a constant number of messages, like the capped retention store. */
+		return Bench::MeasureRate(1, [&](uint32_t) {
+			for (int i = 0; i < 1000; i++)
+			{
+				if (next >= messages.size()) { index.Evict(); }
+
+				index.Add(&messages[next % messages.size()]);
+				next++;
+			}
+			return 1000;
+		});
+	} });
+
+	aBenchmarks.push_back({ "log.index.query", "queries/s", [] {
+		std::vector<LogMsg_t> messages = MakeIndexedMessages(BENCH_LOG_INDEXED);
+
+		CLogIndex index;
+
+		for (const LogMsg_t& msg : messages)
+		{
+			index.Add(&msg);
+		}
+
+		/* The filters the Log window offers, capped at its rows. */
+		std::vector<LogQuery_t> queries(4);
+		queries[0].Text = "timeout";
+		queries[1].Level = ELogLevel::WARNING;
+		queries[1].Channels = { "Loader" };
+		queries[1].Text = "timeout";
+		queries[1].Since = Time::GetTimestamp() - 600;
+		queries[2].Channels = { "Events" };
+		queries[3].Level = ELogLevel::CRITICAL;
+		queries[3].IsExactLevel = true;
+		queries[3].Text = "budget";
+
+		std::vector<uint32_t> results;
+		size_t next = 0;
+
+		return Bench::MeasureRate(1, [&](uint32_t) {
+			for (int i = 0; i < 10; i++)
+			{
+				index.Query(queries[next], results, BENCH_LOG_ROWS);
+				next = (next + 1) % queries.size();
+			}
+			return 10;
+		});
+	} });
+}
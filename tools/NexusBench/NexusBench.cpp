@@ -0,0 +1,218 @@
+///----------------------------------------------------------------------------------------------------
+/// Copyright (c) Raidcore.GG - All rights reserved.
+///
+/// Name         :  NexusBench.cpp
+/// Description  :  Benchmarks of the Engine core, run without the game.
+/// Authors      :  K. Bieniek
+///
+/// Usage        :  NexusBench [--filter <prefix>] [--duration <ms>] [--thresholds <file>]
+/// 	Prints one line per benchmark. With --thresholds, returns 1 if any result misses its threshold.
+/// Build        :  cmake -S . -B build && cmake --build build --target NexusBench
+///----------------------------------------------------------------------------------------------------
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+
+#include "Bench.h"
+
+///----------------------------------------------------------------------------------------------------
+/// Threshold_t Struct
+///----------------------------------------------------------------------------------------------------
+struct Threshold_t
+{
+	bool   IsMaximum = false;
+	double Value     = 0;
+};
+
+static uint32_t s_DurationMs = 250;
+
+namespace Bench
+{
+	void SetDuration(uint32_t aMilliseconds)
+	{
+		s_DurationMs = aMilliseconds;
+	}
+
+	uint32_t GetDuration()
+	{
+		return s_DurationMs;
+	}
+
+	double MeasureRate(uint32_t aThreads, const std::function<uint64_t(uint32_t)>& aBody)
+	{
+		std::atomic<uint32_t> ready   = 0;
+		std::atomic<bool>     started = false;
+		std::atomic<bool>     stopped = false;
+		std::atomic<uint64_t> total   = 0;
+
+		std::vector<std::thread> threads;
+
+		for (uint32_t i = 0; i < aThreads; i++)
+		{
+			threads.push_back(std::thread([&, i] {
+				/* Warm up once, outside of the measurement. */
+				aBody(i);
+
+				ready++;
+				while (!started) { std::this_thread::yield(); }
+
+				uint64_t ops = 0;
+				while (!stopped)
+				{
+					ops += aBody(i);
+				}
+
+				total += ops;
+			}));
+		}
+
+		while (ready < aThreads) { std::this_thread::yield(); }
+
+		auto start = std::chrono::steady_clock::now();
+		started = true;
+		std::this_thread::sleep_for(std::chrono::milliseconds(s_DurationMs));
+		stopped = true;
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		return total / seconds;
+	}
+
+	std::filesystem::path GetTempDirectory(const char* aName)
+	{
+		std::filesystem::path path = std::filesystem::temp_directory_path() / "NexusBench" / aName;
+
+		std::error_code ec;
+		std::filesystem::remove_all(path, ec);
+		std::filesystem::create_directories(path);
+
+		return path;
+	}
+}
+
+///----------------------------------------------------------------------------------------------------
+/// LoadThresholds:
+/// 	Reads "<name> >= <value>" and "<name> <= <value>" lines. Lines starting with # are comments.
+///----------------------------------------------------------------------------------------------------
+static bool LoadThresholds(const char* aPath, std::map<std::string, Threshold_t>& aOut)
+{
+	std::ifstream file(aPath);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	std::string line;
+
+	while (std::getline(file, line))
+	{
+		if (line.empty() || line[0] == '#') { continue; }
+
+		std::istringstream fields(line);
+		std::string name;
+		std::string op;
+		Threshold_t threshold{};
+
+		if (!(fields >> name >> op >> threshold.Value) || (op != ">=" && op != "<="))
+		{
+			fprintf(stderr, "Invalid threshold: %s\n", line.c_str());
+			return false;
+		}
+
+		threshold.IsMaximum = op == "<=";
+		aOut[name] = threshold;
+	}
+
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	const char* filter = "";
+	const char* thresholdsPath = nullptr;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+		{
+			filter = argv[++i];
+		}
+		else if (strcmp(argv[i], "--duration") == 0 && i + 1 < argc)
+		{
+			Bench::SetDuration((uint32_t)atoi(argv[++i]));
+		}
+		else if (strcmp(argv[i], "--thresholds") == 0 && i + 1 < argc)
+		{
+			thresholdsPath = argv[++i];
+		}
+		else
+		{
+			fprintf(stderr, "Usage: NexusBench [--filter <prefix>] [--duration <ms>] [--thresholds <file>]\n");
+			return 1;
+		}
+	}
+
+	std::map<std::string, Threshold_t> thresholds;
+
+	if (thresholdsPath && !LoadThresholds(thresholdsPath, thresholds))
+	{
+		fprintf(stderr, "Could not read thresholds from %s.\n", thresholdsPath);
+		return 1;
+	}
+
+	std::vector<Benchmark_t> benchmarks;
+	RegisterEventBenchmarks(benchmarks);
+	RegisterLogBenchmarks(benchmarks);
+	RegisterLocalizationBenchmarks(benchmarks);
+	RegisterCacheBenchmarks(benchmarks);
+
+	int failed = 0;
+
+	for (Benchmark_t& benchmark : benchmarks)
+	{
+		if (benchmark.Name.rfind(filter, 0) != 0) { continue; }
+
+		double result = benchmark.Run();
+
+		printf("%-36s %16.1f %-12s", benchmark.Name.c_str(), result, benchmark.Unit.c_str());
+
+		auto it = thresholds.find(benchmark.Name);
+
+		if (it != thresholds.end())
+		{
+			const Threshold_t& threshold = it->second;
+			bool passed = threshold.IsMaximum ? result <= threshold.Value : result >= threshold.Value;
+
+			printf(" %s %-14.1f %s", threshold.IsMaximum ? "<=" : ">=", threshold.Value, passed ? "ok" : "REGRESSED");
+
+			if (!passed)
+			{
+				failed++;
+			}
+		}
+
+		printf("\n");
+		fflush(stdout);
+	}
+
+	if (failed > 0)
+	{
+		printf("%d benchmark(s) regressed.\n", failed);
+		return 1;
+	}
+
+	return 0;
+}